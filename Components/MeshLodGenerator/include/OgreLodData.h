@@ -60,11 +60,11 @@ struct _OgreLodExport LodData {
     struct Triangle;
     struct VertexHash;
     struct VertexEqual;
+    class CollapseCostHeap;
 
     typedef std::vector<Vertex> VertexList;
     typedef std::vector<Triangle> TriangleList;
     typedef std::unordered_set<Vertex*, VertexHash, VertexEqual> UniqueVertexSet;
-    typedef std::multimap<Real, Vertex*> CollapseCostHeap;
 
     typedef VectorSet<Edge, 8> VEdges;
     typedef VectorSet<Triangle*, 7> VTriangles;
@@ -104,7 +104,7 @@ struct _OgreLodExport LodData {
         
         Vertex* collapseTo;
         bool seam;
-        CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+        size_t costHeapPosition; /// Index of the vertex in mCollapseCostHeap, which allows fast update and remove.
 
         void addEdge(const Edge& edge);
         void removeEdge(const Edge& edge);
@@ -131,6 +131,60 @@ struct _OgreLodExport LodData {
         bool isMalformed();
     };
 
+    /**
+     * @brief Binary min-heap of the vertices, ordered by their collapse cost.
+     *
+     * Every vertex knows its position in the heap, so its cost can be changed or
+     * it can be removed without any allocation. Vertices with equal cost are
+     * returned in the order they were last inserted or updated.
+     */
+    class _OgreLodExport CollapseCostHeap {
+    public:
+        /// Value of Vertex::costHeapPosition, when the vertex is not in the heap.
+        static const size_t NOT_IN_HEAP = ~size_t(0);
+
+        CollapseCostHeap() : mSequence(0) {}
+
+        size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+        void clear() { mEntries.clear(); mSequence = 0; }
+        void reserve(size_t count) { mEntries.reserve(count); }
+
+        /// The vertex with the smallest collapse cost.
+        Vertex* top() const { return mEntries.front().vertex; }
+        Real topCost() const { return mEntries.front().cost; }
+        /// The vertex at the given position. The order is unspecified.
+        Vertex* operator[](size_t pos) const { return mEntries[pos].vertex; }
+        Real getCost(const Vertex* v) const { return mEntries[v->costHeapPosition].cost; }
+
+        void push(Vertex* v, Real cost);
+        /// Changes the cost of a vertex, which is already in the heap.
+        void update(Vertex* v, Real cost);
+        void erase(Vertex* v);
+    private:
+        struct Entry {
+            Real cost;
+            uint64 sequence; // insertion order of equal costs
+            Vertex* vertex;
+
+            bool operator< (const Entry& other) const
+            {
+                return cost < other.cost || (cost == other.cost && sequence < other.sequence);
+            }
+        };
+
+        void siftUp(size_t pos);
+        void siftDown(size_t pos);
+        void place(const Entry& entry, size_t pos)
+        {
+            mEntries[pos] = entry;
+            entry.vertex->costHeapPosition = pos;
+        }
+
+        std::vector<Entry> mEntries;
+        uint64 mSequence;
+    };
+
     union IndexBufferPointer {
         unsigned short* pshort;
         unsigned int* pint;
@@ -49,6 +49,24 @@ namespace Ogre
 *  @{
 */
 
+/**
+ * @brief Receives the progress of MeshLodGenerator::generateLodLevelsBatch.
+ */
+class _OgreLodExport LodBatchListener
+{
+public:
+    virtual ~LodBatchListener() {}
+
+    /**
+     * @brief Called on the calling thread, after the Lod levels of a mesh were injected.
+     *
+     * @param lodConfig The config of the mesh, with the output values filled.
+     * @param finishedCount The number of meshes finished so far, including this one.
+     * @param totalCount The number of meshes in the batch.
+     */
+    virtual void lodLevelsGenerated(LodConfig& lodConfig, size_t finishedCount, size_t totalCount) = 0;
+};
+
 class _OgreLodExport MeshLodGenerator :
 public Singleton<MeshLodGenerator>
 {
@@ -68,6 +86,20 @@ public:
      */
     virtual void generateLodLevels(LodConfig& lodConfig, LodCollapseCostPtr cost = LodCollapseCostPtr(), LodDataPtr data = LodDataPtr(), LodInputProviderPtr input = LodInputProviderPtr(), LodOutputProviderPtr output = LodOutputProviderPtr(), LodCollapserPtr collapser = LodCollapserPtr());
 
+    /**
+     * @brief Generates the Lod levels for many meshes at once.
+     *
+     * The meshes are processed concurrently on the WorkQueue of Root, if there is one. Every mesh
+     * gets its own LodData, LodCollapseCost and providers. The meshes are read and the results are
+     * injected on the calling thread, so the worker threads never touch a Mesh or a hardware buffer.
+     * The useBackgroundQueue setting of the configs is ignored and the call returns once all meshes
+     * are done.
+     *
+     * @param lodConfigs The configs of the meshes.
+     * @param listener Optional listener, which is notified after each mesh.
+     */
+    void generateLodLevelsBatch(std::vector<LodConfig>& lodConfigs, LodBatchListener* listener = NULL);
+
     /**
      * @brief Generates the Lod levels for a mesh without configuring it.
      *
@@ -93,6 +125,8 @@ public:
 
     void _initWorkQueue();
 protected:
+    /// Generates the Lod levels into the output provider, without injecting them.
+    void generate(LodConfig& lodConfig, LodCollapseCost* cost, LodData* data, LodInputProvider* input, LodOutputProvider* output, LodCollapser* collapser);
     void computeLods(LodConfig& lodConfig, LodData* data, LodCollapseCost* cost, LodOutputProvider* output, LodCollapser* collapser);
     void calcLodVertexCount(const LodLevel& lodLevel, size_t uniqueVertexCount, size_t& outVertexCountLimit, Real& outCollapseCostLimit);
 
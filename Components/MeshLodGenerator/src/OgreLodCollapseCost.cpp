@@ -33,6 +33,7 @@ namespace Ogre
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
         data->mCollapseCostHeap.clear();
+        data->mCollapseCostHeap.reserve(data->mVertexList.size());
         LodData::VertexList::iterator it = data->mVertexList.begin();
         LodData::VertexList::iterator itEnd = data->mVertexList.end();
         for (; it != itEnd; it++) {
@@ -71,7 +72,7 @@ namespace Ogre
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -80,16 +81,15 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
+        OgreAssert(vertex->costHeapPosition != LodData::CollapseCostHeap::NOT_IN_HEAP, "");
+        if (vertex->collapseTo != collapseTo || collapseCost != data->mCollapseCostHeap.getCost(vertex)) {
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST) {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+                data->mCollapseCostHeap.update(vertex, collapseCost);
             } else {
+                data->mCollapseCostHeap.erase(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
@@ -34,10 +34,9 @@ namespace Ogre
     {
         while (data->mCollapseCostHeap.size() > static_cast<size_t>(vertexCountLimit))
         {
-            LodData::CollapseCostHeap::iterator nextVertex = data->mCollapseCostHeap.begin();
-            if (nextVertex->first < collapseCostLimit)
+            if (data->mCollapseCostHeap.topCost() < collapseCostLimit)
             {
-                mLastReducedVertex = nextVertex->second;
+                mLastReducedVertex = data->mCollapseCostHeap.top();
                 collapseVertex(data, cost, output, mLastReducedVertex);
             } else {
                 break;
@@ -51,11 +50,8 @@ namespace Ogre
         // Allows to find bugs in collapsing.
         //  size_t s1 = mUniqueVertexSet.size();
         //  size_t s2 = mCollapseCostHeap.size();
-        LodData::CollapseCostHeap::iterator it = data->mCollapseCostHeap.begin();
-        LodData::CollapseCostHeap::iterator itEnd = data->mCollapseCostHeap.end();
-        while (it != itEnd) {
-            assertValidVertex(data, it->second);
-            it++;
+        for (size_t i = 0; i < data->mCollapseCostHeap.size(); i++) {
+            assertValidVertex(data, data->mCollapseCostHeap[i]);
         }
     }
 
@@ -67,7 +63,7 @@ namespace Ogre
         for (; it != itEnd; it++) {
             LodData::Triangle* t = *it;
             for (int i = 0; i < 3; i++) {
-                OgreAssert(t->vertex[i]->costHeapPosition != data->mCollapseCostHeap.end(), "");
+                OgreAssert(t->vertex[i]->costHeapPosition != LodData::CollapseCostHeap::NOT_IN_HEAP, "");
                 t->vertex[i]->edges.findExists(LodData::Edge(t->vertex[i]->collapseTo));
                 for (int n = 0; n < 3; n++) {
                     if (i != n) {
@@ -178,8 +174,10 @@ namespace Ogre
         assertValidVertex(data, dst);
         assertValidVertex(data, src);
 #endif
-        OgreAssert(src->costHeapPosition->first != LodData::NEVER_COLLAPSE_COST, "");
-        OgreAssert(src->costHeapPosition->first != LodData::UNINITIALIZED_COLLAPSE_COST, "");
+        OgreAssert(src->costHeapPosition != LodData::CollapseCostHeap::NOT_IN_HEAP, "");
+        Real srcCost = data->mCollapseCostHeap.getCost(src);
+        OgreAssert(srcCost != LodData::NEVER_COLLAPSE_COST, "");
+        OgreAssert(srcCost != LodData::UNINITIALIZED_COLLAPSE_COST, "");
         OgreAssert(!src->edges.empty(), "");
         OgreAssert(!src->triangles.empty(), "");
         OgreAssert(src->edges.find(LodData::Edge(dst)) != src->edges.end(), "");
@@ -299,11 +297,10 @@ namespace Ogre
         assertOutdatedCollapseCost(data, cost, dst);
 #endif // ifndef OGRE_DEBUG_MODE
 #endif // ifndef MESHLOD_QUALITY
-        data->mCollapseCostHeap.erase(src->costHeapPosition); // Remove src from collapse costs.
+        data->mCollapseCostHeap.erase(src); // Remove src from collapse costs.
         src->edges.clear(); // Free memory
         src->triangles.clear(); // Free memory
 #if OGRE_DEBUG_MODE
-        src->costHeapPosition = data->mCollapseCostHeap.end();
         assertValidVertex(data, dst);
 #endif
     }
@@ -118,4 +118,82 @@ bool LodData::Edge::operator== (const LodData::Edge& other) const
     return dst == other.dst;
 }
 
+const size_t LodData::CollapseCostHeap::NOT_IN_HEAP;
+
+void LodData::CollapseCostHeap::push(LodData::Vertex* v, Real cost)
+{
+    Entry entry = {cost, mSequence++, v};
+    mEntries.push_back(entry);
+    v->costHeapPosition = mEntries.size() - 1;
+    siftUp(v->costHeapPosition);
+}
+
+void LodData::CollapseCostHeap::update(LodData::Vertex* v, Real cost)
+{
+    size_t pos = v->costHeapPosition;
+    OgreAssert(pos < mEntries.size() && mEntries[pos].vertex == v, "Vertex is not in the heap");
+    Entry& entry = mEntries[pos];
+    bool decreased = cost < entry.cost;
+    entry.cost = cost;
+    entry.sequence = mSequence++; // same order as removing and inserting it again
+    if (decreased) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::erase(LodData::Vertex* v)
+{
+    size_t pos = v->costHeapPosition;
+    OgreAssert(pos < mEntries.size() && mEntries[pos].vertex == v, "Vertex is not in the heap");
+    v->costHeapPosition = NOT_IN_HEAP;
+    Entry last = mEntries.back();
+    mEntries.pop_back();
+    if (pos == mEntries.size()) {
+        return;
+    }
+    place(last, pos);
+    if (pos > 0 && last < mEntries[(pos - 1) / 2]) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::siftUp(size_t pos)
+{
+    Entry entry = mEntries[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!(entry < mEntries[parent])) {
+            break;
+        }
+        place(mEntries[parent], pos);
+        pos = parent;
+    }
+    place(entry, pos);
+}
+
+void LodData::CollapseCostHeap::siftDown(size_t pos)
+{
+    Entry entry = mEntries[pos];
+    size_t count = mEntries.size();
+    for (;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && mEntries[child + 1] < mEntries[child]) {
+            child++;
+        }
+        if (!(mEntries[child] < entry)) {
+            break;
+        }
+        place(mEntries[child], pos);
+        pos = child;
+    }
+    place(entry, pos);
+}
+
 }
@@ -162,7 +162,7 @@ namespace Ogre
             } else {
 #if OGRE_DEBUG_MODE
                 // Needed for an assert, don't remove it.
-                v->costHeapPosition = data->mCollapseCostHeap.end();
+                v->costHeapPosition = LodData::CollapseCostHeap::NOT_IN_HEAP;
 #endif
                 v->seam = false;
             }
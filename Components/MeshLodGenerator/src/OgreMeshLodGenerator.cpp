@@ -31,6 +31,19 @@
 namespace Ogre
 {
 
+namespace
+{
+bool hasGeneratedLevels(const LodConfig& lodConfig)
+{
+    for(size_t i = 0; i < lodConfig.levels.size(); i++) {
+        if(lodConfig.levels[i].manualMeshName.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
 template<> MeshLodGenerator* Singleton<MeshLodGenerator>::msSingleton = 0;
 MeshLodGenerator* MeshLodGenerator::getSingletonPtr()
 {
@@ -176,12 +189,7 @@ void MeshLodGenerator::_process(LodConfig& lodConfig,
                                 LodOutputProvider* output,
                                 LodCollapser* collapser)
 {
-    input->initData(data);
-    data->mUseVertexNormals = data->mUseVertexNormals && lodConfig.advanced.useVertexNormals;
-    cost->initCollapseCosts(data);
-    output->prepare(data);
-    computeLods(lodConfig, data, cost, output, collapser);
-    output->finalize(data);
+    generate(lodConfig, cost, data, input, output, collapser);
     if(!lodConfig.advanced.useBackgroundQueue) {
         // This will be processed in LodWorkQueueInjector if we use background queue.
         output->inject();
@@ -189,6 +197,20 @@ void MeshLodGenerator::_process(LodConfig& lodConfig,
         //lodConfig.mesh->buildEdgeList();
     }
 }
+void MeshLodGenerator::generate(LodConfig& lodConfig,
+                                LodCollapseCost* cost,
+                                LodData* data,
+                                LodInputProvider* input,
+                                LodOutputProvider* output,
+                                LodCollapser* collapser)
+{
+    input->initData(data);
+    data->mUseVertexNormals = data->mUseVertexNormals && lodConfig.advanced.useVertexNormals;
+    cost->initCollapseCosts(data);
+    output->prepare(data);
+    computeLods(lodConfig, data, cost, output, collapser);
+    output->finalize(data);
+}
 void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
                                          LodCollapseCostPtr cost,
                                          LodDataPtr data,
@@ -197,14 +219,7 @@ void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
                                          LodCollapserPtr collapser)
 {
     // If we don't have generated Lod levels, we can use _generateManualLodLevels.
-    bool hasGeneratedLevels = false;
-    for(size_t i = 0; i < lodConfig.levels.size(); i++) {
-        if(lodConfig.levels[i].manualMeshName.empty()) {
-            hasGeneratedLevels = true;
-            break;
-        }
-    }
-    if(hasGeneratedLevels || (LodWorkQueueInjector::getSingletonPtr() && LodWorkQueueInjector::getSingletonPtr()->getInjectorListener())) {
+    if(hasGeneratedLevels(lodConfig) || (LodWorkQueueInjector::getSingletonPtr() && LodWorkQueueInjector::getSingletonPtr()->getInjectorListener())) {
         _resolveComponents(lodConfig, cost, data, input, output, collapser);
         if(lodConfig.advanced.useBackgroundQueue) {
             _initWorkQueue();
@@ -217,6 +232,72 @@ void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
     }
 }
 
+void MeshLodGenerator::generateLodLevelsBatch(std::vector<LodConfig>& lodConfigs, LodBatchListener* listener)
+{
+    struct Job {
+        LodCollapseCostPtr cost;
+        LodDataPtr data;
+        LodInputProviderPtr input;
+        LodOutputProviderPtr output;
+        LodCollapserPtr collapser;
+    };
+
+    Root* root = Root::getSingletonPtr();
+    WorkQueue* wq = root ? root->getWorkQueue() : NULL;
+
+    // Limit the number of meshes copied into buffers at the same time.
+    size_t batchSize = 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+    std::vector<Job> jobs;
+    size_t finishedCount = 0;
+    for(size_t begin = 0; begin < lodConfigs.size(); begin += batchSize) {
+        size_t end = std::min(lodConfigs.size(), begin + batchSize);
+        jobs.clear();
+        jobs.resize(end - begin);
+        for(size_t i = begin; i < end; i++) {
+            LodConfig& lodConfig = lodConfigs[i];
+            if(hasGeneratedLevels(lodConfig)) {
+                // The buffer providers copy the mesh in their constructor and only touch it again in inject().
+                Job& job = jobs[i - begin];
+                bool useBackgroundQueue = lodConfig.advanced.useBackgroundQueue;
+                lodConfig.advanced.useBackgroundQueue = true;
+                _resolveComponents(lodConfig, job.cost, job.data, job.input, job.output, job.collapser);
+                lodConfig.advanced.useBackgroundQueue = useBackgroundQueue;
+            }
+        }
+
+        auto generateJob = [this, &lodConfigs, &jobs, begin](size_t i) {
+            Job& job = jobs[i];
+            if(job.data) {
+                generate(lodConfigs[begin + i], job.cost.get(), job.data.get(), job.input.get(), job.output.get(),
+                         job.collapser.get());
+                job.data.reset(); // Free memory
+            }
+        };
+        if(wq) {
+            wq->parallelFor(end - begin, generateJob);
+        } else {
+            for(size_t i = 0; i < end - begin; i++) {
+                generateJob(i);
+            }
+        }
+
+        for(size_t i = begin; i < end; i++) {
+            LodConfig& lodConfig = lodConfigs[i];
+            Job& job = jobs[i - begin];
+            if(job.output) {
+                job.output->inject();
+                _configureMeshLodUsage(lodConfig);
+            } else {
+                _generateManualLodLevels(lodConfig);
+            }
+            job = Job(); // Free memory
+            if(listener) {
+                listener->lodLevelsGenerated(lodConfig, ++finishedCount, lodConfigs.size());
+            }
+        }
+    }
+}
+
 void MeshLodGenerator::computeLods(LodConfig& lodConfig,
                                    LodData* data,
                                    LodCollapseCost* cost,
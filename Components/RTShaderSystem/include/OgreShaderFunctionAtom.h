@@ -208,6 +208,9 @@ public:
     /** Get a list of parameters this function invocation will use in the function call as arguments. */
     OperandVector& getOperandList() { return mOperands; }
 
+    /** Return the function name, or the name of the operation the atom writes */
+    const String& getFunctionName() const { return mFunctionName; }
+
     /** Push a new operand (on the end) to the function.
     @param parameter A function parameter.
     @param opSemantic The in/out semantic of the parameter.
@@ -255,9 +258,6 @@ public:
     */
     virtual void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
 
-    /** Return the function name */
-    const String& getFunctionName() const { return mFunctionName; }
-
     /** Return the return type */
     const String& getReturnType() const { return mReturnType; }
 
@@ -296,7 +296,11 @@ protected:
 class _OgreRTSSExport AssignmentAtom : public FunctionAtom
 {
 public:
-    explicit AssignmentAtom(int groupOrder) { mGroupExecutionOrder = groupOrder; }
+    explicit AssignmentAtom(int groupOrder)
+    {
+        mGroupExecutionOrder = groupOrder;
+        mFunctionName = "assign";
+    }
     /// @note the argument order is reversed comered to all other function invocations
     AssignmentAtom(const Out& lhs, const In& rhs, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
@@ -306,7 +310,11 @@ public:
 class _OgreRTSSExport SampleTextureAtom : public FunctionAtom
 {
 public:
-    explicit SampleTextureAtom(int groupOrder) { mGroupExecutionOrder = groupOrder; }
+    explicit SampleTextureAtom(int groupOrder)
+    {
+        mGroupExecutionOrder = groupOrder;
+        mFunctionName = "sampleTexture";
+    }
     SampleTextureAtom(const In& sampler, const In& texcoord, const Out& dst, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
 };
@@ -316,7 +324,11 @@ class _OgreRTSSExport BinaryOpAtom : public FunctionAtom
 {
     char mOp;
 public:
-    explicit BinaryOpAtom(char op, int groupOrder) : mOp(op) { mGroupExecutionOrder = groupOrder; }
+    explicit BinaryOpAtom(char op, int groupOrder) : mOp(op)
+    {
+        mGroupExecutionOrder = groupOrder;
+        mFunctionName = op;
+    }
     BinaryOpAtom(char op, const In& a, const In& b, const Out& dst, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
 };
@@ -154,6 +154,8 @@ public:
     /** 
     Set the output shader cache path. Generated shader code will be written to this path.
     In case of empty cache path shaders will be generated directly from system memory.
+    The files are named by the structure of the generated programs, so later runs read them
+    instead of writing the source again. The compiled microcode is cached by the GpuProgramManager.
     @param cachePath The cache path of the shader.  
     The default is empty cache path.
     */
@@ -419,6 +421,24 @@ public:
     */
     bool getCreateShaderOverProgrammablePass() const { return mCreateShaderOverProgrammablePass; }
 
+    /** Sets whether validateScheme creates the CPU programs of the passes in parallel,
+    using the WorkQueue worker threads.
+    @remarks
+    The sub render states are still instanced and the GPU programs are still created
+    on the calling thread. Only the function graphs of the CPU programs are built and
+    prepared for the program writer concurrently, which is the bulk of the work when
+    many materials are validated at once.
+    @note
+    The createCpuSubPrograms implementations of all sub render states in use must be
+    thread safe. Those of the RTSS are.
+    */
+    void setParallelSynthesis(bool enabled) { mParallelSynthesis = enabled; }
+
+    /** Returns whether validateScheme creates the CPU programs in parallel.
+    @see setParallelSynthesis().
+    */
+    bool getParallelSynthesis() const { return mParallelSynthesis; }
+
 
     /** Returns the amount of schemes used in the for RT shader generation
     */
@@ -484,6 +504,9 @@ protected:
         /** Build the render state. */
         void buildTargetRenderState();
 
+        /** Create the CPU programs for this pass, ahead of acquirePrograms. */
+        void createCpuPrograms();
+
         /** Acquire the CPU/GPU programs for this pass. */
         void acquirePrograms();
 
@@ -884,6 +907,8 @@ protected:
     VSOutputCompactPolicy mVSOutputCompactPolicy;
     // Tells whether shaders are created for passes with shaders
     bool mCreateShaderOverProgrammablePass;
+    // Tells whether validateScheme creates the CPU programs in parallel
+    bool mParallelSynthesis;
     // A flag to indicate finalizing
     bool mIsFinalizing;
 
@@ -134,7 +134,16 @@ protected:
     */
     void destroyCpuProgram(Program* shaderProgram);
 
+    /** Prepare the CPU programs of the given program set for createGpuPrograms.
+    Runs the program processor of the target language and names the GPU programs.
+    @remarks
+    Only the program set is modified, so different program sets may be prepared concurrently.
+    @param programSet The program set container.
+    */
+    void prepareGpuPrograms(ProgramSet* programSet);
+
     /** Create GPU programs for the given program set based on the CPU programs it contains.
+    The program set is prepared first, unless this was done already.
     @param programSet The program set container.
     */
     void createGpuPrograms(ProgramSet* programSet);
@@ -149,13 +158,16 @@ protected:
 
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
+    @param programName The name of the GPU program, as set by prepareGpuPrograms.
     @param programWriter The program writer instance.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
     @param profilesList The profiles string for program compilation as string list.
-    @param cachePath The output path to write the program into.
+    @param cachePath The output path to write the program into. An existing program file of
+    the same name is used instead of writing the program.
     */
     GpuProgramPtr createGpuProgram(Program* shaderProgram, 
+        const String& programName,
         ProgramWriter* programWriter,
         const String& language,
         const String& profiles,
@@ -60,10 +60,14 @@ public:
     /** Get the shader GPU program. */
     const GpuProgramPtr& getGpuProgram(GpuProgramType type) const;
 
+    /** Get the name of the GPU program, empty until the CPU programs are prepared. */
+    const String& getGpuProgramName(GpuProgramType type) const;
+
     // Protected methods.
 protected:
     void setCpuProgram(std::unique_ptr<Program>&& program);
     void setGpuProgram(const GpuProgramPtr& program);
+    void setGpuProgramName(GpuProgramType type, const String& name);
 
     // Attributes.
 protected:
@@ -75,6 +79,10 @@ protected:
     GpuProgramPtr mVSGpuProgram;
     // Fragment shader CPU program.
     GpuProgramPtr mPSGpuProgram;
+    // Vertex shader GPU program name.
+    String mVSGpuProgramName;
+    // Fragment shader GPU program name.
+    String mPSGpuProgramName;
 
 private:
     friend class ProgramManager;
@@ -164,6 +164,13 @@ public:
     */
     void removeSubRenderStateInstance(SubRenderState* subRenderState);
     
+    /** Create CPU programs that represent this render state and prepare them for acquirePrograms.
+    @remarks
+    Only this render state is modified, so the render states of different passes may create
+    their CPU programs concurrently. acquirePrograms calls this unless it was done already.
+    */
+    void createCpuPrograms();
+
     /** Acquire CPU/GPU programs set associated with the given render state and bind them to the pass.
     @param pass The pass to bind the programs to.
     */
@@ -184,10 +191,6 @@ protected:
     /** Sort the sub render states composing this render state. */
     void sortSubRenderStates();
     
-    /** Create CPU programs that represent this render state.   
-    */
-    void createCpuPrograms();
-
     /** Create the program set of this render state.
     */
     ProgramSet* createProgramSet();
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -128,7 +129,7 @@ ShaderGenerator& ShaderGenerator::getSingleton()
 ShaderGenerator::ShaderGenerator() :
     mActiveSceneMgr(NULL), mShaderLanguage(""),
     mFSLayer(0), mActiveViewportValid(false), mVSOutputCompactPolicy(VSOCP_LOW),
-    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false)
+    mCreateShaderOverProgrammablePass(false), mParallelSynthesis(false), mIsFinalizing(false)
 {
     mLightCount[0]              = 0;
     mLightCount[1]              = 0;
@@ -1548,6 +1549,13 @@ void ShaderGenerator::SGPass::buildTargetRenderState()
     }               
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGPass::createCpuPrograms()
+{
+    if(!mTargetRenderState) return;
+    mTargetRenderState->createCpuPrograms();
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGPass::acquirePrograms()
 {
@@ -1916,6 +1924,22 @@ void ShaderGenerator::SGScheme::validate()
             curTechEntry->buildTargetRenderState();     
     }
 
+    // Create the CPU programs of all passes in parallel, each pass only touches its own render state.
+    if (ShaderGenerator::getSingleton().getParallelSynthesis())
+    {
+        SGPassList passes;
+        for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
+        {
+            if ((*itTech)->getBuildDestinationTechnique())
+                passes.insert(passes.end(), (*itTech)->getPassList().begin(), (*itTech)->getPassList().end());
+        }
+
+        Root::getSingleton().getWorkQueue()->parallelFor(passes.size(), [&passes](size_t i)
+        {
+            passes[i]->createCpuPrograms();
+        });
+    }
+
     // Acquire GPU programs for each technique.
     for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
     {
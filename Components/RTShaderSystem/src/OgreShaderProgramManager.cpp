@@ -198,16 +198,9 @@ void ProgramManager::destroyProgramWriters()
 //-----------------------------------------------------------------------------
 void ProgramManager::createGpuPrograms(ProgramSet* programSet)
 {
-    // Before we start we need to make sure that the pixel shader input
-    //  parameters are the same as the vertex output, this required by 
-    //  shader models 4 and 5.
-    // This change may incrase the number of register used in older shader
-    //  models - this is why the check is present here.
-    bool isVs4 = GpuProgramManager::getSingleton().isSyntaxSupported("vs_4_0_level_9_1");
-    if (isVs4)
-    {
-        synchronizePixelnToBeVertexOut(programSet);
-    }
+    // The program set may have been prepared by the caller, possibly on another thread.
+    if (programSet->getGpuProgramName(GPT_VERTEX_PROGRAM).empty())
+        prepareGpuPrograms(programSet);
 
     // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
@@ -225,26 +218,11 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         programWriter = itWriter->second;
     }
 
-    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
-    ProgramProcessor* programProcessor = NULL;
-
-    if (itProcessor == mProgramProcessorsMap.end())
-    {
-        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
-            "Could not find processor for language '" + language,
-            "ProgramManager::createGpuPrograms");       
-    }
-
-    programProcessor = itProcessor->second;
-    
-    // Call the pre creation of GPU programs method.
-    if (!programProcessor->preCreateGpuPrograms(programSet))
-        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programSet->getGpuProgramName(type),
+                                           programWriter, language,
                                            ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderProfilesList(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
@@ -258,36 +236,172 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getSkeletalAnimationIncluded());
 
     // Call the post creation of GPU programs method.
-    if(!programProcessor->postCreateGpuPrograms(programSet))
+    if(!mProgramProcessorsMap[language]->postCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "postCreateGpuPrograms failed");
 }
 
 //-----------------------------------------------------------------------------
-GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
-                                               ProgramWriter* programWriter,
-                                               const String& language,
-                                               const String& profiles,
-                                               const StringVector& profilesList,
-                                               const String& cachePath)
+static void writeCount(String& signature, size_t count)
+{
+    uint32 value = uint32(count);
+    signature.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//-----------------------------------------------------------------------------
+template <typename T> static bool writeConstValue(String& signature, const Parameter& param)
+{
+    const ConstParameter<T>* constParam = dynamic_cast<const ConstParameter<T>*>(&param);
+    if (constParam)
+        signature.append(reinterpret_cast<const char*>(&constParam->getValue()), sizeof(T));
+    return constParam != NULL;
+}
+
+//-----------------------------------------------------------------------------
+static void writeSignature(String& signature, const Parameter& param)
+{
+    int values[] = {param.getType(), param.getSemantic(), param.getIndex(), param.getContent(),
+                    int(param.getSize())};
+    signature.append(reinterpret_cast<const char*>(values), sizeof(values));
+
+    if (!param.isConstParameter())
+        signature.append(param.getName());
+    // the value of the common constants, as printing them is much slower
+    else if (!writeConstValue<Vector4>(signature, param) && !writeConstValue<Vector3>(signature, param) &&
+             !writeConstValue<Vector2>(signature, param) && !writeConstValue<float>(signature, param))
+        signature.append(param.toString());
+    signature.push_back('\0');
+}
+
+//-----------------------------------------------------------------------------
+static void writeSignature(String& signature, const ShaderParameterList& params)
+{
+    writeCount(signature, params.size());
+    for (const auto& param : params)
+        writeSignature(signature, *param);
+}
+
+//-----------------------------------------------------------------------------
+/// append everything the program writers read from the program
+static void writeSignature(String& signature, Program* program)
+{
+    signature.push_back(char(program->getType()));
+
+    writeCount(signature, program->getDependencyCount());
+    for (unsigned int i = 0; i < program->getDependencyCount(); ++i)
+    {
+        signature.append(program->getDependency(i));
+        signature.push_back('\0');
+    }
+
+    writeCount(signature, program->getParameters().size());
+    for (const auto& param : program->getParameters())
+        writeSignature(signature, *param);
+
+    writeCount(signature, program->getFunctions().size());
+    for (Function* function : program->getFunctions())
+    {
+        signature.append(function->getName());
+        signature.push_back('\0');
+        signature.append(function->getDescription());
+        signature.push_back('\0');
+        writeSignature(signature, function->getInputParameters());
+        writeSignature(signature, function->getOutputParameters());
+        writeSignature(signature, function->getLocalParameters());
+
+        writeCount(signature, function->getAtomInstances().size());
+        for (FunctionAtom* atom : function->getAtomInstances())
+        {
+            signature.append(atom->getFunctionName());
+            signature.push_back('\0');
+
+            writeCount(signature, atom->getOperandList().size());
+            for (const Operand& operand : atom->getOperandList())
+            {
+                char values[] = {char(operand.getSemantic()), char(operand.getMask()),
+                                 char(operand.getIndirectionLevel())};
+                signature.append(values, sizeof(values));
+                writeSignature(signature, *operand.getParameter());
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+/** Version of the source the program writers produce for a program. Increase it whenever
+    a writer changes its output, so cached programs of earlier versions are not reused.
+*/
+static const int PROGRAM_WRITER_VERSION = 1;
+
+//-----------------------------------------------------------------------------
+static String generateSignature(Program* shaderProgram, const String& language)
 {
-    stringstream sourceCodeStringStream;
+    // the writers adapt the source to the shading language version and these capabilities
+    RenderSystem* rs = Root::getSingleton().getRenderSystem();
+    int capabilities[] = {
+        rs && rs->getCapabilities() && rs->getCapabilities()->hasCapability(RSC_GLSL_SSO_REDECLARE),
+        GpuProgramManager::getSingleton().isSyntaxSupported("ps_4_0")};
+    int versions[] = {OGRE_VERSION, PROGRAM_WRITER_VERSION,
+                      rs ? int(rs->getNativeShadingLanguageVersion()) : 0};
+    String signature(reinterpret_cast<const char*>(versions), sizeof(versions));
+    signature.append(reinterpret_cast<const char*>(capabilities), sizeof(capabilities));
+    signature.append(language);
+    signature.push_back('\0');
+    if (rs)
+        signature.append(rs->getName());
+    signature.push_back('\0');
+    writeSignature(signature, shaderProgram);
+    return signature;
+}
 
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
+//-----------------------------------------------------------------------------
+void ProgramManager::prepareGpuPrograms(ProgramSet* programSet)
+{
+    // Before we start we need to make sure that the pixel shader input
+    //  parameters are the same as the vertex output, this required by 
+    //  shader models 4 and 5.
+    // This change may incrase the number of register used in older shader
+    //  models - this is why the check is present here.
+    bool isVs4 = GpuProgramManager::getSingleton().isSyntaxSupported("vs_4_0_level_9_1");
+    if (isVs4)
+    {
+        synchronizePixelnToBeVertexOut(programSet);
+    }
 
-    // Generate program name.
-    String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
 
-    if (shaderProgram->getType() == GPT_VERTEX_PROGRAM)
+    if (itProcessor == mProgramProcessorsMap.end())
     {
-        programName += "_VS";
+        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
+            "Could not find processor for language '" + language,
+            "ProgramManager::prepareGpuPrograms");       
     }
-    else if (shaderProgram->getType() == GPT_FRAGMENT_PROGRAM)
+
+    // Call the pre creation of GPU programs method.
+    if (!itProcessor->second->preCreateGpuPrograms(programSet))
+        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
+
+    // The writers produce the same source for the same input, so the programs are named by the
+    // input and the source is only written for programs which are neither loaded nor cached.
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        programName += "_FS";
+        Program* shaderProgram = programSet->getCpuProgram(type);
+        String programName = generateHash(generateSignature(shaderProgram, language),
+                                          shaderProgram->getPreprocessorDefines());
+        programName += type == GPT_VERTEX_PROGRAM ? "_VS" : "_FS";
+        programSet->setGpuProgramName(type, programName);
     }
+}
 
+//-----------------------------------------------------------------------------
+GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
+                                               const String& programName,
+                                               ProgramWriter* programWriter,
+                                               const String& language,
+                                               const String& profiles,
+                                               const StringVector& profilesList,
+                                               const String& cachePath)
+{
     // Try to get program by name.
     HighLevelGpuProgramPtr pGpuProgram =
         HighLevelGpuProgramManager::getSingleton().getByName(
@@ -302,18 +416,32 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
     pGpuProgram = HighLevelGpuProgramManager::getSingleton().createProgram(programName,
         ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, language, shaderProgram->getType());
 
-    // Case cache directory specified -> create program from file.
+    String source;
+    const String programFileName = cachePath + programName + "." + language;
+
+    // Case cache directory specified -> use the program file of an earlier run.
     if (!cachePath.empty())
     {
-        const String  programFullName = programName + "." + language;
-        const String  programFileName = cachePath + programFullName;
-        std::ifstream programFile;
+        std::ifstream programFile(programFileName.c_str());
 
-        // Check if program file already exist.
-        programFile.open(programFileName.c_str());
+        if (programFile)
+        {
+            StringStream buffer;
+            programFile >> buffer.rdbuf();
+            source = buffer.str();
+        }
+    }
+
+    if (source.empty())
+    {
+        stringstream sourceCodeStringStream;
+
+        // Generate source code.
+        programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
+        source = sourceCodeStringStream.str();
 
         // Case we have to write the program to a file.
-        if (!programFile)
+        if (!cachePath.empty())
         {
             std::ofstream outFile(programFileName.c_str());
 
@@ -323,13 +451,6 @@ GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram,
             outFile << source;
             outFile.close();
         }
-        else
-        {
-            // use program file version
-            StringStream buffer;
-            programFile >> buffer.rdbuf();
-            source = buffer.str();
-        }
     }
 
     pGpuProgram->setSource(source);
@@ -102,5 +102,36 @@ const GpuProgramPtr& ProgramSet::getGpuProgram(GpuProgramType type) const
     return nullPtr;
 }
 
+//-----------------------------------------------------------------------------
+void ProgramSet::setGpuProgramName(GpuProgramType type, const String& name)
+{
+    switch(type)
+    {
+    case GPT_VERTEX_PROGRAM:
+        mVSGpuProgramName = name;
+        break;
+    case GPT_FRAGMENT_PROGRAM:
+        mPSGpuProgramName = name;
+        break;
+    default:
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "", "");
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+const String& ProgramSet::getGpuProgramName(GpuProgramType type) const
+{
+    switch(type)
+    {
+    case GPT_VERTEX_PROGRAM:
+        return mVSGpuProgramName;
+    case GPT_FRAGMENT_PROGRAM:
+        return mPSGpuProgramName;
+    default:
+        return BLANKSTRING;
+    }
+}
+
 }
 }
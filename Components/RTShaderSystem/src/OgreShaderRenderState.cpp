@@ -159,7 +159,9 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
 
 void TargetRenderState::acquirePrograms(Pass* pass)
 {
-    createCpuPrograms();
+    // The CPU programs may have been created ahead, see ShaderGenerator::setParallelSynthesis.
+    if (!mProgramSet)
+        createCpuPrograms();
 
     try
     {
@@ -209,15 +211,26 @@ void TargetRenderState::createCpuPrograms()
     programSet->setCpuProgram(std::unique_ptr<Program>(new Program(GPT_VERTEX_PROGRAM)));
     programSet->setCpuProgram(std::unique_ptr<Program>(new Program(GPT_FRAGMENT_PROGRAM)));
 
-    for (SubRenderStateListIterator it=mSubRenderStateList.begin(); it != mSubRenderStateList.end(); ++it)
+    try
     {
-        SubRenderState* srcSubRenderState = *it;
-
-        if (!srcSubRenderState->createCpuSubPrograms(programSet))
+        for (SubRenderStateListIterator it=mSubRenderStateList.begin(); it != mSubRenderStateList.end(); ++it)
         {
-            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
-                        "Could not generate sub render program of type: " + srcSubRenderState->getType());
+            SubRenderState* srcSubRenderState = *it;
+
+            if (!srcSubRenderState->createCpuSubPrograms(programSet))
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                            "Could not generate sub render program of type: " + srcSubRenderState->getType());
+            }
         }
+
+        ProgramManager::getSingleton().prepareGpuPrograms(programSet);
+    }
+    catch (...)
+    {
+        // acquirePrograms must not take the partially built programs for created ahead ones
+        mProgramSet.reset();
+        throw;
     }
 }
 
@@ -83,6 +83,27 @@ namespace Ogre
     // This MUST match the bitwise OR of all the types above with no extra bits!
     const uint8 Terrain::DERIVED_DATA_ALL = 7;
     //-----------------------------------------------------------------------
+    namespace
+    {
+        /// Calls func(rowBegin, rowEnd) for ranges covering [begin, end), split between the WorkQueue threads
+        void parallelForRows(long begin, long end, const std::function<void(long, long)>& func)
+        {
+            if (end - begin < 2)
+            {
+                if (end > begin)
+                    func(begin, end);
+                return;
+            }
+
+            // a few ranges per thread, as the rows differ in cost
+            size_t rows = end - begin;
+            size_t numItems = std::min(rows, 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY));
+            Root::getSingleton().getWorkQueue()->parallelFor(numItems, [&](size_t item) {
+                func(begin + long(rows * item / numItems), begin + long(rows * (item + 1) / numItems));
+            });
+        }
+    }
+    //-----------------------------------------------------------------------
     template<> TerrainGlobalOptions* Singleton<TerrainGlobalOptions>::msSingleton = 0;
     TerrainGlobalOptions* TerrainGlobalOptions::getSingletonPtr(void)
     {
@@ -2085,9 +2106,22 @@ namespace Ogre
 
         mQuadTree->preDeltaCalculation(clampedRect);
 
-        /// Iterate over target levels, 
+        // the widest rect is the one of the lowest LOD
         for (int targetLevel = 1; targetLevel < mNumLodLevels; ++targetLevel)
         {
+            int step = 1 << targetLevel;
+            finalRect.merge(Rect(std::max(0L, rect.left - step), std::max(0L, rect.top - step),
+                                 std::min((long)mSize, rect.right + step),
+                                 std::min((long)mSize, rect.bottom + step)));
+        }
+
+        /// Iterate over target levels, in parallel. Each level only notifies its source
+        /// LOD in the quadtree and saves the deltas of the vertices it removes, which no
+        /// other level touches.
+        int numTargetLevels = std::max(0, mNumLodLevels - 1);
+        Root::getSingleton().getWorkQueue()->parallelFor(numTargetLevels, [&](size_t item)
+        {
+            int targetLevel = int(item) + 1;
             int sourceLevel = targetLevel - 1;
             int step = 1 << targetLevel;
             // The step of the next higher LOD
@@ -2101,9 +2135,6 @@ namespace Ogre
             widenedRect.right = std::min((long)mSize, widenedRect.right + step);
             widenedRect.bottom = std::min((long)mSize, widenedRect.bottom + step);
 
-            // keep a merge of the widest
-            finalRect.merge(widenedRect);
-            
 
             // now round the rectangle at this level so that it starts & ends on 
             // the step boundaries
@@ -2223,7 +2254,7 @@ namespace Ogre
                 } // i
             } // j
 
-        } // targetLevel
+        }); // targetLevel
 
         mQuadTree->postDeltaCalculation(clampedRect);
 
@@ -3331,46 +3362,47 @@ namespace Ogre
         //  | / | \ |
         //  5---6---7
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        // Each normal only reads the heights around it, so the rows are
+        // calculated in parallel
+        parallelForRows(widenedRect.top, widenedRect.bottom, [&](long rowBegin, long rowEnd)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            for (long y = rowBegin; y < rowEnd; ++y)
             {
-                Vector3 cumulativeNormal = Vector3::ZERO;
-
-                // Build points to sample
-                Vector3 centrePoint;
-                Vector3 adjacentPoints[8];
-                getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
-                getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
-                getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
-                getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
-                getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
-                getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
-                getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
-                getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
-                getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
-
-                for (int i = 0; i < 8; ++i)
-                {
-                    cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
-                }
-
-                // normalise & store normal
-                cumulativeNormal.normalise();
-
-                // encode as RGB, object space
                 // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                uint8* pStore = pData + (widenedRect.bottom - y - 1) * widenedRect.width() * 3;
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
-                *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
+                {
+                    Vector3 cumulativeNormal = Vector3::ZERO;
+
+                    // Build points to sample
+                    Vector3 centrePoint;
+                    Vector3 adjacentPoints[8];
+                    getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
+                    getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
+                    getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
+                    getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
+                    getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
+                    getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
+                    getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
+                    getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
+                    getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
+
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
+                    }
 
+                    // normalise & store normal
+                    cumulativeNormal.normalise();
 
+                    // encode as RGB, object space
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                }
             }
-        }
+        });
 
         finalRect = widenedRect;
 
@@ -3504,42 +3536,45 @@ namespace Ogre
                                              static_cast<uint32>(widenedRect.height()), 1, PF_L8, pData);
 
         Real heightPad = (getMaxHeight() - getMinHeight()) * 1.0e-3f;
+        Vector3 terrainPos = getPosition();
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
+        // Every texel casts its own ray, so the rows are baked in parallel. The
+        // terrain and its neighbours are only read while doing so.
+        parallelForRows(widenedRect.top, widenedRect.bottom, [&](long rowBegin, long rowEnd)
         {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+            for (long y = rowBegin; y < rowEnd; ++y)
             {
-                float litVal = 1.0f;
-
-                // convert to terrain space (not points, allow this to go between points)
-                float Tx = (float)x / (float)(mLightmapSizeActual-1);
+                // invert the Y to deal with image space
+                uint8* pStore = pData + (widenedRect.bottom - y - 1) * widenedRect.width();
                 float Ty = (float)y / (float)(mLightmapSizeActual-1);
 
-                // get world space point
-                // add a little height padding to stop shadowing self
-                Vector3 wpos = Vector3::ZERO;
-                getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
-                wpos += getPosition();
-                // build ray, cast backwards along light direction
-                Ray ray(wpos, -lightVec);
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
+                {
+                    float litVal = 1.0f;
 
-                // Cascade into neighbours when casting, but don't travel further
-                // than world size
-                std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
+                    // convert to terrain space (not points, allow this to go between points)
+                    float Tx = (float)x / (float)(mLightmapSizeActual-1);
 
-                if (rayHit.first)
-                    litVal = 0.0f;
+                    // get world space point
+                    // add a little height padding to stop shadowing self
+                    Vector3 wpos = Vector3::ZERO;
+                    getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
+                    wpos += terrainPos;
+                    // build ray, cast backwards along light direction
+                    Ray ray(wpos, -lightVec);
 
-                // encode as L8
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
+                    // Cascade into neighbours when casting, but don't travel further
+                    // than world size
+                    std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
-                *pStore = (unsigned char)(litVal * 255.0);
+                    if (rayHit.first)
+                        litVal = 0.0f;
 
+                    // encode as L8
+                    *pStore++ = (unsigned char)(litVal * 255.0);
+                }
             }
-        }
+        });
 
         return pixbox;
 
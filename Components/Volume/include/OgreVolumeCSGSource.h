@@ -244,6 +244,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
     };
 
     /** Builds the union between two sources.
@@ -271,6 +279,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
     };
 
     /** Builds the difference between two sources.
@@ -299,6 +315,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -359,6 +383,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
     };
 
     /** Scales the given volume source.
@@ -386,6 +418,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
@@ -420,13 +460,24 @@ namespace Volume {
             The value.
         */
         inline Real getInternalValue(const Vector3 &position) const
+        {
+            return mSrc->getValue(position) + getNoise(position);
+        }
+
+        /* Gets the noise added to the density value.
+        @param position
+            The position of the value.
+        @return
+            The sum of the octaves.
+        */
+        inline Real getNoise(const Vector3 &position) const
         {
             Real toAdd = (Real)0.0;
             for (size_t i = 0; i < mNumOctaves; ++i)
             {
                 toAdd += mNoise.noise(position.x * mFrequencies[i], position.y * mFrequencies[i], position.z * mFrequencies[i]) * mAmplitudes[i];
             }
-            return mSrc->getValue(position) + toAdd;
+            return toAdd;
         }
 
     public:
@@ -464,6 +515,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
         
         /** Gets the initial seed.
         @return
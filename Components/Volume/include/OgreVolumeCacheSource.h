@@ -28,8 +28,13 @@ THE SOFTWARE.
 #ifndef __Ogre_Volume_CacheSource_H__
 #define __Ogre_Volume_CacheSource_H__
 
+#include "OgreCommon.h"
 #include "OgreVector.h"
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
 
@@ -52,14 +57,60 @@ namespace Volume {
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
     /** A caching Source.
+    @remarks
+        The samples are kept in a hash map, which is split into independently locked
+        shards, so the cache can be queried from several threads at once. Positions
+        are compared by their exact bits, just like the values are returned by the
+        cached source. If a memory budget is set, the least recently used samples of
+        a shard are evicted once it is exceeded.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
     protected:
-        
+
+        /// Hashes the bits of a position.
+        struct PositionHash
+        {
+            size_t operator()(const Vector3 &position) const
+            {
+                return FastHash((const char*)&position, sizeof(Vector3));
+            }
+        };
+
+        /// Compares the bits of two positions.
+        struct PositionEqual
+        {
+            bool operator()(const Vector3 &a, const Vector3 &b) const
+            {
+                return memcmp(&a, &b, sizeof(Vector3)) == 0;
+            }
+        };
+
+        /// The cached samples, most recently used first.
+        typedef std::list<std::pair<Vector3, Vector4> > SampleList;
+
         /// Map for the cache
-        typedef std::map<Vector3, Vector4> UMapPositionValue;
-        mutable UMapPositionValue mCache;
+        typedef std::unordered_map<Vector3, SampleList::iterator, PositionHash, PositionEqual> UMapPositionValue;
+
+        /// A part of the cache with its own lock.
+        struct Shard
+        {
+            std::mutex mutex;
+            UMapPositionValue index;
+            SampleList samples;
+        };
+
+        /// The amount of shards, a power of two.
+        static const size_t NUM_SHARDS = 16;
+
+        /// The shards of the cache, chosen by the upper half of the hash.
+        mutable Shard mShards[NUM_SHARDS];
+
+        /// The memory budget in bytes, 0 for unlimited.
+        size_t mMemoryBudget;
+
+        /// The amount of samples a shard may hold, 0 for unlimited.
+        size_t mMaxSamplesPerShard;
 
         /// The source to cache.
         const Source *mSrc;
@@ -70,29 +121,26 @@ namespace Volume {
         @return
             The density value (w-component) and the gradient (x, y and z component).
         */
-        inline Vector4 getFromCache(const Vector3 &position) const
-        {
-            Vector4 result;
-            std::map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
-            {
-                result = it->second;
-            }
-            return result;
-        }
+        Vector4 getFromCache(const Vector3 &position) const;
+
+        /** Evicts the least recently used samples of a shard until it fits the budget.
+        @param shard
+            The shard, which must be locked by the caller.
+        */
+        void evict(Shard &shard) const;
 
     public:
         
+        /// The approximate memory used per cached sample, including the container overhead.
+        static const size_t BYTES_PER_SAMPLE;
+
         /** Constructor.
         @param src
             The source to cache.
+        @param memoryBudget
+            The maximum memory in bytes to use for the cache, 0 for unlimited.
         */
-        CacheSource(const Source *src);
+        CacheSource(const Source *src, size_t memoryBudget = 0);
         
         /** Overridden from Source.
         */
@@ -102,6 +150,39 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const;
 
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
+        /** Sets the maximum memory to use for the cache, evicting the least
+        recently used samples if needed.
+        @note
+            Must not be called while the cache is queried from other threads.
+        @param memoryBudget
+            The budget in bytes, 0 for unlimited.
+        */
+        void setMemoryBudget(size_t memoryBudget);
+
+        /** Gets the maximum memory to use for the cache.
+        @return
+            The budget in bytes, 0 for unlimited.
+        */
+        size_t getMemoryBudget(void) const { return mMemoryBudget; }
+
+        /** Gets the amount of cached samples.
+        @return
+            The amount of samples.
+        */
+        size_t getCachedSampleCount(void) const;
+
+        /** Removes all cached samples.
+        */
+        void clear(void);
+
     };
     /** @} */
     /** @} */
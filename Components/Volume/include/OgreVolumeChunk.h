@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreEntity.h"
 
 #include "OgreVolumePrerequisites.h"
+#include "OgreVolumeChunkHandler.h"
 
 namespace Ogre {
 namespace Volume {
@@ -125,6 +126,9 @@ namespace Volume {
         /// The parameters with which the chunktree got loaded.
         ChunkParameters *parameters;
 
+        /// The chunks to be meshed before a synchronous load returns.
+        std::vector<ChunkRequest> pendingRequests;
+
         /** Constructor.
         */
         ChunkTreeSharedData(const ChunkParameters *params) : octreeVisible(false), dualGridVisible(false), volumeVisible(true), chunksBeingProcessed(0)
@@ -108,6 +108,12 @@ namespace Volume {
         */
         void init(void);
 
+        /** Loads the prepared geometry of a request and frees its intermediate data.
+        @param req
+            The ChunkRequest.
+        */
+        void finishRequest(const ChunkRequest &req);
+
     public:
         
         /** Constructor
@@ -128,6 +134,17 @@ namespace Volume {
         */
         void processWorkQueue(void);
 
+        /** Processes the requests right away on the calling thread and the worker threads.
+        @remarks
+            A few requests per thread are prepared in parallel at a time, then their
+            geometry is loaded and their intermediate data is freed before the next
+            ones are started. So only the octrees and meshes of these requests are in
+            memory at once.
+        @param requests
+            The requests, emptied when done.
+        */
+        void processRequests(std::vector<ChunkRequest> &requests);
+
         /// Implementation for WorkQueue::RequestHandler
         WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
         
@@ -28,7 +28,9 @@ THE SOFTWARE.
 #ifndef __Ogre_Volume_MeshBuilder_H__
 #define __Ogre_Volume_MeshBuilder_H__
 
+#include <unordered_map>
 #include <vector>
+#include "OgreCommon.h"
 #include "OgreManualObject.h"
 #include "OgreVector.h"
 #include "OgreAxisAlignedBox.h"
@@ -138,8 +140,26 @@ namespace Volume {
         /// The buffer binding.
         static const unsigned short MAIN_BINDING;
 
+        /// Hashes the bits of a vertex.
+        struct VertexHash
+        {
+            size_t operator()(const Vertex &v) const
+            {
+                return FastHash((const char*)&v, sizeof(Vertex));
+            }
+        };
+
+        /// Compares the bits of two vertices.
+        struct VertexEqual
+        {
+            bool operator()(const Vertex &a, const Vertex &b) const
+            {
+                return memcmp(&a, &b, sizeof(Vertex)) == 0;
+            }
+        };
+
         /// Map to get a vertex index.
-        typedef std::map<Vertex, size_t> UMapVertexIndex;
+        typedef std::unordered_map<Vertex, size_t, VertexHash, VertexEqual> UMapVertexIndex;
         UMapVertexIndex mIndexMap;
 
          /// Holds the vertices of the mesh.
@@ -160,11 +180,9 @@ namespace Volume {
         */
         inline void addVertex(const Vertex &v)
         {
-            size_t i = 0;
-            if (mIndexMap.find(v) == mIndexMap.end())
+            std::pair<UMapVertexIndex::iterator, bool> inserted = mIndexMap.insert(UMapVertexIndex::value_type(v, mVertices.size()));
+            if (inserted.second)
             {
-                i = mVertices.size();
-                mIndexMap[v] = i;
                 mVertices.push_back(v);
 
                 // Update bounding box
@@ -201,11 +219,7 @@ namespace Volume {
                     }
                 }
             }
-            else
-            {
-                i = mIndexMap[v];
-            }
-            mIndices.push_back(i);
+            mIndices.push_back(inserted.first->second);
         }
 
     public:
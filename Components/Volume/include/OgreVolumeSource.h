@@ -101,6 +101,34 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values at several positions at once. Sources override
+        this to save the virtual call per sample and to process the positions in
+        tight loops. The default implementation calls getValue for each position.
+        @note
+            The CSG operations, CSGNoiseSource and CacheSource implement the batched
+            queries, so a subclass changing their getValue or getValueAndGradient must
+            override these as well. The CSG primitives use the default implementations.
+        @param positions
+            The positions.
+        @param count
+            The amount of positions.
+        @param values
+            Receives the densities, one per position.
+        */
+        virtual void getValues(const Vector3 *positions, size_t count, Real *values) const;
+
+        /** Gets the density values and gradients at several positions at once.
+        The default implementation calls getValueAndGradient for each position.
+        @param positions
+            The positions.
+        @param count
+            The amount of positions.
+        @param values
+            Receives vectors with x, y, z containing the gradient and w containing the
+            density, one per position.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
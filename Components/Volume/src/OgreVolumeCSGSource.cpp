@@ -30,6 +30,61 @@ THE SOFTWARE.
 namespace Ogre {
 namespace Volume {
 
+    namespace
+    {
+        /// The amount of samples the operations pass on to their sources at once.
+        const size_t BATCH_SIZE = 64;
+
+        inline void sampleBatch(const Source *src, const Vector3 *positions, size_t count, Real *values)
+        {
+            src->getValues(positions, count, values);
+        }
+
+        inline void sampleBatch(const Source *src, const Vector3 *positions, size_t count, Vector4 *values)
+        {
+            src->getValuesAndGradients(positions, count, values);
+        }
+
+        inline Real densityOf(Real value)
+        {
+            return value;
+        }
+
+        inline Real densityOf(const Vector4 &value)
+        {
+            return value.w;
+        }
+
+        /** Samples both sources of an operation and keeps the smaller or bigger
+        density per position, with the one of b multiplied by factorB.
+        */
+        template<typename T>
+        void combineBatch(const Source *a, const Source *b, Real factorB, bool keepSmaller,
+            const Vector3 *positions, size_t count, T *values)
+        {
+            T valuesB[BATCH_SIZE];
+            for (size_t begin = 0; begin < count; begin += BATCH_SIZE)
+            {
+                size_t num = std::min(BATCH_SIZE, count - begin);
+                T *valuesA = values + begin;
+                sampleBatch(a, positions + begin, num, valuesA);
+                sampleBatch(b, positions + begin, num, valuesB);
+                for (size_t i = 0; i < num; ++i)
+                {
+                    T valueB = factorB * valuesB[i];
+                    bool keepA = keepSmaller ? densityOf(valuesA[i]) < densityOf(valueB) :
+                        densityOf(valuesA[i]) > densityOf(valueB);
+                    if (!keepA)
+                    {
+                        valuesA[i] = valueB;
+                    }
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     Vector3 CSGCubeSource::mBoxNormals[6] = {
         Vector3::UNIT_X,
         Vector3::UNIT_Y,
@@ -205,6 +260,20 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGIntersectionSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        combineBatch(mA, mB, (Real)1.0, true, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        combineBatch(mA, mB, (Real)1.0, true, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnionSource::CSGUnionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -243,6 +312,20 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGUnionSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        combineBatch(mA, mB, (Real)1.0, false, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        combineBatch(mA, mB, (Real)1.0, false, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGDifferenceSource::CSGDifferenceSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -281,6 +364,20 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGDifferenceSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        combineBatch(mA, mB, (Real)-1.0, true, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        combineBatch(mA, mB, (Real)-1.0, true, positions, count, values);
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnarySource::CSGUnarySource(const Source *src) : mSrc(src)
     {
     }
@@ -333,6 +430,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNegateSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        mSrc->getValues(positions, count, values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        mSrc->getValuesAndGradients(positions, count, values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (Real)-1.0 * values[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGScaleSource::CSGScaleSource(const Source *src, const Real scale) : CSGUnarySource(src), mScale(scale)
     {
     }
@@ -353,6 +472,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGScaleSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        Vector3 scaledPositions[BATCH_SIZE];
+        for (size_t begin = 0; begin < count; begin += BATCH_SIZE)
+        {
+            size_t num = std::min(BATCH_SIZE, count - begin);
+            for (size_t i = 0; i < num; ++i)
+            {
+                scaledPositions[i] = positions[begin + i] / mScale;
+            }
+            mSrc->getValues(scaledPositions, num, values + begin);
+            for (size_t i = 0; i < num; ++i)
+            {
+                values[begin + i] = values[begin + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        Vector3 scaledPositions[BATCH_SIZE];
+        for (size_t begin = 0; begin < count; begin += BATCH_SIZE)
+        {
+            size_t num = std::min(BATCH_SIZE, count - begin);
+            for (size_t i = 0; i < num; ++i)
+            {
+                scaledPositions[i] = positions[begin + i] / mScale;
+            }
+            mSrc->getValuesAndGradients(scaledPositions, num, values + begin);
+            for (size_t i = 0; i < num; ++i)
+            {
+                values[begin + i] = values[begin + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void CSGNoiseSource::setData(void)
     {
         mGradientOff = fabs(mFrequencies[0]);
@@ -403,6 +562,56 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNoiseSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        // One batch for the wrapped source, the noise is added afterwards
+        mSrc->getValues(positions, count, values);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = values[i] + getNoise(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        // The central differences need six additional samples per position
+        const size_t samplesPerPosition = 7;
+        const size_t batchPositions = BATCH_SIZE / samplesPerPosition;
+        Vector3 samplePositions[batchPositions * samplesPerPosition];
+        Real sampleValues[batchPositions * samplesPerPosition];
+        for (size_t begin = 0; begin < count; begin += batchPositions)
+        {
+            size_t num = std::min(batchPositions, count - begin);
+            Vector3 *samplePosition = samplePositions;
+            for (size_t i = 0; i < num; ++i)
+            {
+                const Vector3 &position = positions[begin + i];
+                *samplePosition++ = Vector3(position.x + mGradientOff, position.y, position.z);
+                *samplePosition++ = Vector3(position.x - mGradientOff, position.y, position.z);
+                *samplePosition++ = Vector3(position.x, position.y + mGradientOff, position.z);
+                *samplePosition++ = Vector3(position.x, position.y - mGradientOff, position.z);
+                *samplePosition++ = Vector3(position.x, position.y, position.z + mGradientOff);
+                *samplePosition++ = Vector3(position.x, position.y, position.z - mGradientOff);
+                *samplePosition++ = position;
+            }
+            size_t numSamples = num * samplesPerPosition;
+            mSrc->getValues(samplePositions, numSamples, sampleValues);
+            for (size_t j = 0; j < numSamples; ++j)
+            {
+                sampleValues[j] = sampleValues[j] + getNoise(samplePositions[j]);
+            }
+            const Real *v = sampleValues;
+            for (size_t i = 0; i < num; ++i, v += samplesPerPosition)
+            {
+                values[begin + i] = Vector4(-(v[0] - v[1]), -(v[2] - v[3]), -(v[4] - v[5]), v[6]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     long CSGNoiseSource::getSeed(void) const
     {
         return mSeed;
@@ -38,12 +38,70 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
-    CacheSource::CacheSource(const Source *src) : mSrc(src)
+    const size_t CacheSource::BYTES_PER_SAMPLE =
+        // list node with its links
+        sizeof(SampleList::value_type) + 2 * sizeof(void*) +
+        // hash node with its link and cached hash, and a bucket
+        sizeof(UMapPositionValue::value_type) + 3 * sizeof(void*) + sizeof(void*);
+
+    //-----------------------------------------------------------------------
+
+    CacheSource::CacheSource(const Source *src, size_t memoryBudget) : mMemoryBudget(0),
+        mMaxSamplesPerShard(0), mSrc(src)
     {
+        setMemoryBudget(memoryBudget);
     }
     
     //-----------------------------------------------------------------------
 
+    Vector4 CacheSource::getFromCache(const Vector3 &position) const
+    {
+        // The lower bits of the hash choose the bucket within the shard
+        Shard &shard = mShards[(PositionHash()(position) >> 16) % NUM_SHARDS];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            UMapPositionValue::iterator it = shard.index.find(position);
+            if (it != shard.index.end())
+            {
+                // Only keep track of the usage if something might be evicted
+                if (mMaxSamplesPerShard)
+                {
+                    shard.samples.splice(shard.samples.begin(), shard.samples, it->second);
+                }
+                return it->second->second;
+            }
+        }
+
+        // Sample without holding the lock, another thread might do the same meanwhile
+        Vector4 result = mSrc->getValueAndGradient(position);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.index.find(position) == shard.index.end())
+        {
+            shard.samples.push_front(std::make_pair(position, result));
+            shard.index[position] = shard.samples.begin();
+            evict(shard);
+        }
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CacheSource::evict(Shard &shard) const
+    {
+        if (!mMaxSamplesPerShard)
+        {
+            return;
+        }
+        while (shard.samples.size() > mMaxSamplesPerShard)
+        {
+            shard.index.erase(shard.samples.back().first);
+            shard.samples.pop_back();
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     Vector4 CacheSource::getValueAndGradient(const Vector3 &position) const
     {
         return getFromCache(position);
@@ -56,5 +114,68 @@ namespace Volume {
         return getFromCache(position).w;
     }
 
+    //-----------------------------------------------------------------------
+
+    void CacheSource::getValues(const Vector3 *positions, size_t count, Real *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = getFromCache(positions[i]).w;
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CacheSource::getValuesAndGradients(const Vector3 *positions, size_t count, Vector4 *values) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = getFromCache(positions[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CacheSource::setMemoryBudget(size_t memoryBudget)
+    {
+        mMemoryBudget = memoryBudget;
+        mMaxSamplesPerShard = 0;
+        if (memoryBudget)
+        {
+            // Always keep at least one sample per shard
+            mMaxSamplesPerShard = std::max<size_t>(1, memoryBudget / BYTES_PER_SAMPLE / NUM_SHARDS);
+        }
+        for (size_t i = 0; i < NUM_SHARDS; ++i)
+        {
+            std::lock_guard<std::mutex> lock(mShards[i].mutex);
+            evict(mShards[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t CacheSource::getCachedSampleCount(void) const
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < NUM_SHARDS; ++i)
+        {
+            std::lock_guard<std::mutex> lock(mShards[i].mutex);
+            count += mShards[i].samples.size();
+        }
+        return count;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void CacheSource::clear(void)
+    {
+        for (size_t i = 0; i < NUM_SHARDS; ++i)
+        {
+            std::lock_guard<std::mutex> lock(mShards[i].mutex);
+            mShards[i].index.clear();
+            mShards[i].samples.clear();
+        }
+    }
+
 }
 }
\ No newline at end of file
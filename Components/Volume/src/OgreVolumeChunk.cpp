@@ -77,7 +77,15 @@ namespace Volume {
             req.meshBuilder = OGRE_NEW MeshBuilder();
             req.dualGridGenerator = OGRE_NEW DualGridGenerator();
 
-            mChunkHandler.addRequest(req);
+            if (mShared->parameters->async)
+            {
+                mChunkHandler.addRequest(req);
+            }
+            else
+            {
+                // Meshed in parallel batches once the whole tree is traversed
+                mShared->pendingRequests.push_back(req);
+            }
         }
         else
         {
@@ -333,6 +341,9 @@ namespace Volume {
         
         doLoad(parent, from, to, from, to, level, level);
 
+        // Mesh the chunks of a synchronous load
+        mChunkHandler.processRequests(mShared->pendingRequests);
+
         // Wait for the threads.
         if (!parameters->async)
         {
@@ -85,6 +85,38 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
   
+    void ChunkHandler::processRequests(std::vector<ChunkRequest> &requests)
+    {
+        init();
+        size_t batchSize = 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+        for (size_t begin = 0; begin < requests.size(); begin += batchSize)
+        {
+            size_t end = std::min(requests.size(), begin + batchSize);
+            mWQ->parallelFor(end - begin, [&requests, begin](size_t i)
+            {
+                const ChunkRequest &cReq = requests[begin + i];
+                cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo);
+            });
+            for (size_t i = begin; i < end; ++i)
+            {
+                finishRequest(requests[i]);
+            }
+        }
+        requests.clear();
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void ChunkHandler::finishRequest(const ChunkRequest &req)
+    {
+        req.origin->loadGeometry(req.meshBuilder, req.dualGridGenerator, req.root, req.level, req.isUpdate);
+        OGRE_DELETE req.root;
+        OGRE_DELETE req.dualGridGenerator;
+        OGRE_DELETE req.meshBuilder;
+    }
+    
+    //-----------------------------------------------------------------------
+
     WorkQueue::Response* ChunkHandler::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         ChunkRequest cReq = any_cast<ChunkRequest>(req->getData());
@@ -98,11 +130,7 @@ namespace Volume {
     {
         if (res->succeeded())
         {
-            ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
-            cReq.origin->loadGeometry(cReq.meshBuilder, cReq.dualGridGenerator, cReq.root, cReq.level, cReq.isUpdate);
-            OGRE_DELETE cReq.root;
-            OGRE_DELETE cReq.dualGridGenerator;
-            OGRE_DELETE cReq.meshBuilder;
+            finishRequest(any_cast<ChunkRequest>(res->getRequest()->getData()));
         }
     }
 }
@@ -45,18 +45,18 @@ namespace Volume {
     {
         unsigned char cubeIndex = 0;
         Vector4 values[8];
+        if (volumeValues)
+        {
+            std::copy(volumeValues, volumeValues + 8, values);
+        }
+        else
+        {
+            mSrc->getValuesAndGradients(corners, 8, values);
+        }
 
         // Find out the case.
         for (size_t i = 0; i < 8; ++i)
         {
-            if (volumeValues)
-            {
-                values[i] = volumeValues[i];
-            }
-            else
-            {
-                values[i] = mSrc->getValueAndGradient(corners[i]);
-            }
             if (values[i].w >= ISO_LEVEL)
             {
                 cubeIndex |= 1 << i;
@@ -139,6 +139,16 @@ namespace Volume {
         unsigned char squareIndex = 0;
         Vector4 values[4];
 
+        // The gradients of the corners are needed for the normals
+        const Vector3 squareCorners[4] = {
+            corners[indices[0]], corners[indices[1]], corners[indices[2]], corners[indices[3]]
+        };
+        Vector4 cornerValues[4];
+        if (!volumeValues)
+        {
+            mSrc->getValuesAndGradients(squareCorners, 4, cornerValues);
+        }
+
         // Find out the case.
         for (size_t i = 0; i < 4; ++i)
         {
@@ -148,7 +158,7 @@ namespace Volume {
             }
             else
             {
-                values[i] = mSrc->getValueAndGradient(corners[indices[i]]);
+                values[i] = cornerValues[i];
             }
             if (values[i].w >= ISO_LEVEL)
             {
@@ -162,6 +172,11 @@ namespace Volume {
             return;
         }
 
+        if (volumeValues)
+        {
+            mSrc->getValuesAndGradients(squareCorners, 4, cornerValues);
+        }
+
         int edge = msEdges[squareIndex];
 
         // Find the intersection vertices.
@@ -172,25 +187,25 @@ namespace Volume {
         intersectionPoints[4] = corners[indices[2]];
         intersectionPoints[6] = corners[indices[3]];
 
-        Vector4 innerVal = mSrc->getValueAndGradient(intersectionPoints[0]);
+        Vector4 innerVal = cornerValues[0];
         intersectionNormals[0].x = innerVal.x;
         intersectionNormals[0].y = innerVal.y;
         intersectionNormals[0].z = innerVal.z;
         intersectionNormals[0].normalise();
         intersectionNormals[0] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[2]);
+        innerVal = cornerValues[1];
         intersectionNormals[2].x = innerVal.x;
         intersectionNormals[2].y = innerVal.y;
         intersectionNormals[2].z = innerVal.z;
         intersectionNormals[2].normalise();
         intersectionNormals[2] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[4]);
+        innerVal = cornerValues[2];
         intersectionNormals[4].x = innerVal.x;
         intersectionNormals[4].y = innerVal.y;
         intersectionNormals[4].z = innerVal.z;
         intersectionNormals[4].normalise();
         intersectionNormals[4] *= innerVal.w + (Real)1.0;
-        innerVal = mSrc->getValueAndGradient(intersectionPoints[6]);
+        innerVal = cornerValues[3];
         intersectionNormals[6].x = innerVal.x;
         intersectionNormals[6].y = innerVal.y;
         intersectionNormals[6].z = innerVal.z;
@@ -55,6 +55,10 @@ namespace Ogre {
         will calculate concatenated matrices etc only when required, passing back precalculated
         matrices when they are requested more than once when the underlying information has
         not altered.
+    @par
+        The setters also increase a generation counter for each GpuParamVariability
+        their values affect, which GpuProgramParameters::_updateAutoParams uses to skip
+        auto constants that are still up to date.
     */
     class _OgreExport AutoParamDataSource : public SceneMgtAlloc
     {
@@ -127,6 +131,15 @@ namespace Ogre {
 
         SceneNode mDummyNode;
         Light mBlankLight;
+
+        /// Generation counters of GPV_GLOBAL, GPV_PER_OBJECT, GPV_LIGHTS and GPV_PASS_ITERATION_NUMBER
+        uint32 mGenerations[4];
+        /// Identifies this source, unlike its address, which can be reused after deletion
+        uint32 mSourceId;
+        /// Whether the current renderable uses an identity view / projection matrix
+        bool mIdentityView, mIdentityProj;
+        /// Increases the generation counters of the given variability mask
+        void markChanged(uint16 variability);
     public:
         AutoParamDataSource();
         /** Updates the current renderable */
@@ -265,6 +278,25 @@ namespace Ogre {
         void setPassNumber(const int passNumber);
         void incPassNumber(void);
         void updateLightCustomGpuParameter(const GpuProgramParameters::AutoConstantEntry& constantEntry, GpuProgramParameters *params) const;
+
+        /// Gets a number unique to this source, which the generations refer to
+        uint32 getSourceId() const { return mSourceId; }
+
+        /** Gets a number which changes whenever values of the given variability may have changed.
+        @remarks
+            Values which depend on the current pass, like the surface colours, are not
+            tracked, as GpuProgramParameters can be shared between passes.
+        */
+        uint32 getGeneration(uint16 variability) const
+        {
+            uint32 generation = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                if (variability & (1 << i))
+                    generation += mGenerations[i];
+            }
+            return generation;
+        }
     };
     /** @} */
     /** @} */
@@ -805,6 +805,71 @@ namespace Ogre {
 
     };
 
+    /** A batch of up to 32 axis aligned boxes in structure of arrays layout.
+    @remarks
+        The centre and half size components of the boxes are kept in separate arrays,
+        so that batched tests like Frustum::isVisible(const AxisAlignedBoxBatch&) can
+        process several boxes per instruction. Null boxes are stored with a negative and
+        infinite boxes with a huge half size, so they need no special casing there.
+    @par
+        The batch also references the boxes it was built from, which must outlive it.
+    */
+    struct AxisAlignedBoxBatch
+    {
+        enum
+        {
+            /// Maximum number of boxes, so the results fit into a uint32 mask
+            CAPACITY = 32
+        };
+
+        /// centre x, y, z followed by half size x, y, z
+        Real data[6][CAPACITY];
+        /// The boxes the batch was built from
+        const AxisAlignedBox* boxes[CAPACITY];
+        /// Number of boxes in the batch
+        size_t size;
+
+        AxisAlignedBoxBatch() : size(0) {}
+
+        void clear() { size = 0; }
+        bool full() const { return size == CAPACITY; }
+
+        /// Appends a box, the batch must not be full
+        void add(const AxisAlignedBox& box)
+        {
+            assert(!full() && "AxisAlignedBoxBatch is full");
+            boxes[size] = &box;
+            if (box.isFinite())
+            {
+                Vector3 centre = box.getCenter();
+                Vector3 halfSize = box.getHalfSize();
+                for (int i = 0; i < 3; ++i)
+                {
+                    data[i][size] = centre[i];
+                    data[i + 3][size] = halfSize[i];
+                }
+            }
+            else
+            {
+                Real halfSize = box.isNull() ? -std::numeric_limits<Real>::max()
+                                             : std::numeric_limits<Real>::max();
+                for (int i = 0; i < 3; ++i)
+                {
+                    data[i][size] = 0;
+                    data[i + 3][size] = halfSize;
+                }
+            }
+            ++size;
+        }
+
+        /// Gets box i
+        const AxisAlignedBox& get(size_t i) const
+        {
+            assert(i < size && "AxisAlignedBoxBatch index out of range");
+            return *boxes[i];
+        }
+    };
+
     /** @} */
     /** @} */
 } // namespace Ogre
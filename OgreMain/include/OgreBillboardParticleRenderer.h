@@ -200,9 +200,10 @@ namespace Ogre {
 
         /// @copydoc ParticleSystemRenderer::getType
         const String& getType(void) const;
+        using ParticleSystemRenderer::_updateRenderQueue;
         /// @copydoc ParticleSystemRenderer::_updateRenderQueue
         void _updateRenderQueue(RenderQueue* queue, 
-            std::list<Particle*>& currentParticles, bool cullIndividually);
+            std::vector<Particle*>& currentParticles, bool cullIndividually);
         /// @copydoc ParticleSystemRenderer::visitRenderables
         void visitRenderables(Renderable::Visitor* visitor, 
             bool debugRenderables = false);
@@ -220,6 +221,12 @@ namespace Ogre {
         void _notifyAttached(Node* parent, bool isTagPoint = false);
         /// @copydoc ParticleSystemRenderer::_notifyDefaultDimensions
         void _notifyDefaultDimensions(Real width, Real height);
+        using ParticleSystemRenderer::_notifyParticleMoved;
+        /// @copydoc ParticleSystemRenderer::_notifyParticleMoved
+        void _notifyParticleMoved(std::vector<Particle*>& currentParticles) {}
+        using ParticleSystemRenderer::_notifyParticleCleared;
+        /// @copydoc ParticleSystemRenderer::_notifyParticleCleared
+        void _notifyParticleCleared(std::vector<Particle*>& currentParticles) {}
         /// @copydoc ParticleSystemRenderer::setRenderQueueGroup
         void setRenderQueueGroup(uint8 queueID);
         /// @copydoc MovableObject::setRenderQueueGroupAndPriority
@@ -587,6 +587,13 @@ namespace Ogre {
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
         bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
+        /** Tests the boxes at once using SIMD instructions where available, or forwards
+            to the culling frustum if there is one.
+        @note
+            Subclasses overriding isVisible(const AxisAlignedBox&, FrustumPlane*) must
+            override this too, e.g. by calling Frustum::isVisible(const AxisAlignedBoxBatch&).
+        */
+        uint32 isVisible(const AxisAlignedBoxBatch& boxes) const;
         /// @copydoc Frustum::getWorldSpaceCorners
         const Corners& getWorldSpaceCorners(void) const;
         /// @copydoc Frustum::getFrustumPlane
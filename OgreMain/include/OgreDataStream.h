@@ -474,6 +474,44 @@ namespace Ogre {
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
     };
 
+    /** Read only stream on a memory mapped file.
+    @remarks
+        The file contents are exposed through the MemoryDataStream interface,
+        so consumers can use getPtr() directly instead of copying the data.
+        Pages are read in on demand from the page cache, without an
+        intermediate buffer.
+    @note
+        The file must not be truncated while the stream is open. On platforms
+        without memory mapping, the file is read into memory instead.
+    */
+    class _OgreExport MappedFileDataStream : public MemoryDataStream
+    {
+        /// Platform mapping handle, if any
+        void* mMapping;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        /// Map the opened file, the path is used for errors only
+        void mapFile(void* file, const String& path);
+#endif
+    public:
+        /** Map the file at the given path.
+        @param name The name to give the stream
+        @param path The path of the file
+        */
+        MappedFileDataStream(const String& name, const String& path);
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        /** Map the file at the given UTF-16 path, for the wide character file IO routines
+        @param name The name to give the stream, also used for errors
+        @param path The path of the file
+        */
+        MappedFileDataStream(const String& name, const std::wstring& path);
+#endif
+        ~MappedFileDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+    };
+
     /** Common subclass of DataStream for handling data from 
         std::basic_istream.
     */
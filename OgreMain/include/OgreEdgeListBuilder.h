@@ -249,23 +249,18 @@ namespace Ogre {
         VertexDataList mVertexDataList;
         CommonVertexList mVertices;
         EdgeData* mEdgeData;
-        /// Map for identifying common vertices
-        typedef std::map<Vector3, size_t, vectorLess> CommonVertexMap;
-        CommonVertexMap mCommonVertexMap;
-        /** Edge map, used to connect edges. Note we allow many triangles on an edge,
-        after connected an existing edge, we will remove it and never used again.
-        */
-        typedef std::multimap< std::pair<size_t, size_t>, std::pair<size_t, size_t> > EdgeMap;
-        EdgeMap mEdgeMap;
+        /// Open addressing hash table of indexes into mVertices, for identifying common vertices
+        std::vector<size_t> mCommonVertexTable;
 
-        void buildTrianglesEdges(const Geometry &geometry);
+        void buildTriangles(const Geometry &geometry);
+        /** Connects the triangles. Note we allow many triangles on an edge, each side of an edge
+        is connected to the oldest unconnected opposite side, and never used again.
+        */
+        void buildEdges(void);
 
         /// Finds an existing common vertex, or inserts a new one
         size_t findOrCreateCommonVertex(const Vector3& vec, size_t vertexSet, 
             size_t indexSet, size_t originalIndex);
-        /// Connect existing edge or create a new edge - utility method during building
-        void connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, size_t vertIndex0, size_t vertIndex1, 
-            size_t sharedVertIndex0, size_t sharedVertIndex1);
     };
     /** @} */
     /** @} */
@@ -70,6 +70,13 @@ namespace Ogre {
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static bool getIgnoreHidden();
+
+        /// Set the size in bytes from which files opened read only are memory mapped,
+        /// see MappedFileDataStream. The default is 1MB.
+        static void setMemoryMapThreshold(size_t bytes);
+
+        /// Get the size in bytes from which files opened read only are memory mapped.
+        static size_t getMemoryMapThreshold();
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
@@ -192,6 +192,13 @@ namespace Ogre
         /// Is this frustum using an oblique depth projection?
         bool mObliqueDepthProjection;
 
+        /** Tests the boxes against the planes of this Frustum using SIMD instructions where available.
+        @remarks
+            Gives the same results as the single box test of Frustum, so subclasses keeping
+            that may use it to override isVisible(const AxisAlignedBoxBatch&).
+        */
+        uint32 isVisibleBatched(const AxisAlignedBoxBatch& boxes) const;
+
     public:
 
         /// Named constructor
@@ -471,6 +478,19 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests whether several bounding boxes are visible in the Frustum.
+        @remarks
+            Gives the same results as isVisible(const AxisAlignedBox&, FrustumPlane*)
+            for each box, which is what the default implementation calls. Camera tests
+            several boxes at once instead, so Camera subclasses overriding the single box
+            test must override this as well.
+        @param boxes
+            Bounding boxes to be checked (world space).
+        @return
+            A mask with bit i set if box i is visible.
+        */
+        virtual uint32 isVisible(const AxisAlignedBoxBatch& boxes) const;
+
         uint32 getTypeFlags(void) const override;
         const AxisAlignedBox& getBoundingBox(void) const override;
         Real getBoundingRadius(void) const override;
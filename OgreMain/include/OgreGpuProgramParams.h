@@ -1284,16 +1284,18 @@ namespace Ogre {
             };
             /// The variability of this parameter (see GpuParamVariability)
             uint16 variability;
+            /// AutoParamDataSource::getGeneration when the value was written, 0 if it needs an update
+            uint32 generation;
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, size_t theData,
                           uint16 theVariability, size_t theElemCount = 4)
             : paramType(theType), physicalIndex(theIndex), elementCount(theElemCount),
-                data(theData), variability(theVariability) {}
+                data(theData), variability(theVariability), generation(0) {}
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, Real theData,
                           uint16 theVariability, size_t theElemCount = 4)
             : paramType(theType), physicalIndex(theIndex), elementCount(theElemCount),
-                fData(theData), variability(theVariability) {}
+                fData(theData), variability(theVariability), generation(0) {}
 
         };
         // Auto parameter storage
@@ -1353,6 +1355,10 @@ namespace Ogre {
         bool mIgnoreMissingParams;
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
+        /// AutoParamDataSource::getSourceId of the last _updateAutoParams, the generations of the entries refer to it
+        uint32 mAutoParamSourceId;
+        /// Physical float constants written since the last _clearDirtyFloatRange
+        size_t mDirtyFloatBegin, mDirtyFloatEnd;
 
         /// Return the variability for an auto constant
         static uint16 deriveVariability(AutoConstantType act);
@@ -1865,11 +1871,41 @@ namespace Ogre {
         /// @}
 
         /** Update automatic parameters.
+            @remarks
+                Autos whose values did not change since they were last written, as
+                tracked by AutoParamDataSource::getGeneration, are skipped.
             @param source The source of the parameters
             @param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
         */
         void _updateAutoParams(const AutoParamDataSource* source, uint16 variabilityMask);
 
+        /** Gets the physical float constants written since _clearDirtyFloatRange was last called.
+            @remarks
+                As _updateAutoParams skips autos which did not change, render systems
+                which keep the constants on the GPU between draws can upload just this
+                range instead of all constants matching the variability mask.
+            @return The first and one past the last physical index, equal if nothing was written
+        */
+        std::pair<size_t, size_t> getDirtyFloatRange() const
+        {
+            return mDirtyFloatBegin < mDirtyFloatEnd ? std::make_pair(mDirtyFloatBegin, mDirtyFloatEnd)
+                                                     : std::make_pair(size_t(0), size_t(0));
+        }
+
+        /// Adds physical float constants written without _writeRawConstants to getDirtyFloatRange
+        void _markDirtyFloatRange(size_t physicalIndex, size_t count)
+        {
+            mDirtyFloatBegin = std::min(mDirtyFloatBegin, physicalIndex);
+            mDirtyFloatEnd = std::max(mDirtyFloatEnd, physicalIndex + count);
+        }
+
+        /// Empties getDirtyFloatRange, to be called by render systems once they uploaded it
+        void _clearDirtyFloatRange()
+        {
+            mDirtyFloatBegin = std::numeric_limits<size_t>::max();
+            mDirtyFloatEnd = 0;
+        }
+
         /** Tells the program whether to ignore missing parameters or not.
          */
         void setIgnoreMissingParams(bool state) { mIgnoreMissingParams = state; }
@@ -397,13 +397,19 @@ namespace Ogre {
             FILTER_BILINEAR,
             FILTER_BOX,
             FILTER_TRIANGLE,
-            FILTER_BICUBIC
+            FILTER_BICUBIC,
+            FILTER_LANCZOS
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
             @param  dst         PixelBox containing the destination pointer, dimensions and format
             @param  filter      Which filter to use
             @remarks    This function can do pixel format conversion in the process.
+            FILTER_BOX, FILTER_TRIANGLE, FILTER_BICUBIC and FILTER_LANCZOS take all covered
+            source pixels into account when shrinking, which makes them the better choice
+            for generating mipmaps. They are only implemented for 2D images, volumes are
+            scaled with FILTER_BILINEAR instead. Large images are scaled in parallel on the
+            WorkQueue threads.
             @note   dst and src can point to the same PixelBox object without any problem
         */
         static void scale(const PixelBox &src, const PixelBox &dst, Filter filter = FILTER_BILINEAR);
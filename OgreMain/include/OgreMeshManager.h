@@ -402,6 +402,8 @@ namespace Ogre {
         */
         MeshSerializerListener *getListener();
 
+        bool isParallelPrepareSafe(void) const override { return true; }
+
     protected:
 
         /// @copydoc ResourceManager::createImpl
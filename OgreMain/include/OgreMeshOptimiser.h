@@ -0,0 +1,131 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _OgreMeshOptimiser_H_
+#define _OgreMeshOptimiser_H_
+
+#include "OgrePrerequisites.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+    /** Reorders the triangles and vertices of meshes for faster rendering.
+
+    Only the order of the data is changed, so the rendered result stays the same
+    (apart from the order in which overlapping transparent triangles are blended).
+    Triangle lists are reordered for the post transform vertex cache of the GPU
+    using Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". Optionally, the
+    result is split into clusters which are sorted for less overdraw, as in
+    "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" by Sander
+    et al. Finally, the vertices are stored in the order they are first used, so
+    vertex fetch reads memory sequentially.
+
+    Meshes are optimised before they are used, usually offline by OgreMeshUpgrader.
+    Objects that copy the mesh data, such as StaticGeometry, keep the optimised order.
+    */
+    class _OgreExport MeshOptimiser
+    {
+    public:
+        /// Post transform vertex cache behaviour of a triangle list
+        struct VertexCacheStatistics
+        {
+            size_t triangleCount;
+            /// Number of different vertices used by the triangles
+            size_t vertexCount;
+            /// Number of vertex shader invocations, i.e. cache misses
+            size_t vertexTransforms;
+            /// Average cache miss ratio: transforms per triangle, between 0.5 and 3
+            float acmr;
+            /// Average transform to vertex ratio: transforms per vertex, 1 at best
+            float atvr;
+
+            VertexCacheStatistics()
+                : triangleCount(0), vertexCount(0), vertexTransforms(0), acmr(0), atvr(0) {}
+        };
+
+        /// FIFO cache size used for the statistics, a common size of GPU caches
+        static const size_t DEFAULT_CACHE_SIZE = 16;
+
+        /** Simulates a FIFO post transform cache of the given size.
+        @param indexData A triangle list
+        @param cacheSize Number of vertices in the cache
+        */
+        static VertexCacheStatistics analyseVertexCache(const IndexData* indexData,
+                                                        size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+        /** Sums the statistics of the full detail triangle lists of the mesh.
+        */
+        static VertexCacheStatistics analyseVertexCache(const Mesh* mesh,
+                                                        size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+        /** Reorders the triangles of a triangle list for the vertex cache.
+        @remarks
+            The cache is modelled after Forsyth's LRU cache of 32 entries, which
+            works well for all FIFO and LRU cache sizes in use.
+        */
+        static void optimiseVertexCache(IndexData* indexData);
+
+        /** Reorders the triangle clusters of a vertex cache optimised triangle list
+            to draw outer, outwards facing triangles first.
+        @param indexData A triangle list, optimised by optimiseVertexCache
+        @param vertexData The vertices, with a VET_FLOAT3 position
+        @param threshold How much the cache miss ratio may grow. Higher values
+            allow smaller clusters, which can be sorted better.
+        */
+        static void optimiseOverdraw(IndexData* indexData, const VertexData* vertexData,
+                                     float threshold = 1.05f);
+
+        /** Optimises the triangles of all LOD levels of the SubMesh and reorders
+            its own vertices for fetching.
+        @remarks
+            Shared vertices are only reordered by optimise(Mesh*), which knows all
+            SubMeshes using them. Bone assignments, poses and morph animations are
+            updated, edge lists are rebuilt.
+        @param subMesh The SubMesh to optimise
+        @param overdraw Whether to call optimiseOverdraw
+        */
+        static void optimise(SubMesh* subMesh, bool overdraw = false);
+
+        /** Optimises all SubMeshes and the shared vertices.
+        @param mesh The Mesh to optimise
+        @param overdraw Whether to call optimiseOverdraw
+        */
+        static void optimise(Mesh* mesh, bool overdraw = false);
+    };
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
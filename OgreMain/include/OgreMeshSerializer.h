@@ -147,6 +147,25 @@ namespace Ogre {
                         MeshVersion version,
                         Endian endianMode = ENDIAN_NATIVE);
         
+        /** Exports a mesh to the file specified, in the baked format.
+        @remarks
+            Baked meshes are a little endian image of the mesh data that is loaded
+            without parsing and uploaded straight from the (memory mapped) file.
+            They are meant for shipping and are not compatible between OGRE
+            versions, so keep the classic .mesh file as the source. importMesh
+            detects the format on its own.
+        @param pMesh Pointer to the Mesh to export
+        @param filename The destination filename
+        */
+        void exportBakedMesh(const Mesh* pMesh, const String& filename);
+
+        /** Exports a mesh to the stream specified, in the baked format.
+        @param pMesh Pointer to the Mesh to export
+        @param stream Writeable stream
+        @see exportBakedMesh
+        */
+        void exportBakedMesh(const Mesh* pMesh, DataStreamPtr stream);
+
         /** Imports Mesh and (optionally) Material data from a .mesh file DataStream.
         @remarks
             This method imports data from a DataStream opened from a .mesh file and places it's
@@ -167,6 +186,7 @@ namespace Ogre {
 
         MeshSerializerListener *mListener;
 
+        void importClassicMesh(DataStreamPtr& stream, Mesh* pDest);
     };
 
     /** 
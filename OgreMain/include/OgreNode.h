@@ -554,6 +554,19 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /// List of children still to be updated along with their parentHasChanged flag
+        typedef std::vector<std::pair<Node*, bool> > PendingUpdateList;
+
+        /** Internal method to split a recursive _update across several threads.
+        @note
+            Calls _update(true, parentHasChanged), but Node::_update appends the children
+            it would have updated to the given list rather than updating them. The caller is
+            responsible for updating them, and for updating the bounds of a SceneNode
+            afterwards. Overrides of _update are called as usual, but any work they do
+            after Node::_update sees the children before they are updated.
+        */
+        void _updateDeferChildren(bool parentHasChanged, PendingUpdateList& children);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
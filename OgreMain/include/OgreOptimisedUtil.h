@@ -72,6 +72,13 @@ namespace Ogre {
         */
         static OptimisedUtil* getImplementation(void) { return msImplementation; }
 
+        /** Gets the portable implementation of this class.
+        @note
+            Only useful to check the result of the implementation picked by
+            getImplementation against.
+        */
+        static OptimisedUtil* getGeneralImplementation(void);
+
         /** Performs software vertex skinning.
         @param srcPosPtr Pointer to source position buffer.
         @param destPosPtr Pointer to destination position buffer.
@@ -204,6 +211,45 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Test axis aligned boxes against a set of planes.
+        @remarks
+            A box is culled when it lies completely on the negative side of
+            any plane, with the same result as Plane::getSide(centre, halfSize)
+            returning Plane::NEGATIVE_SIDE. This is the visibility test of
+            Frustum::isVisible for many boxes at once.
+        @param planes An array of planes, typically the frustum planes.
+        @param numPlanes Number of planes in the array.
+        @param boxes Pointer to six consecutive arrays, holding the x, y and z
+            components of the box centres followed by those of the half sizes,
+            see AxisAlignedBoxBatch. No SIMD alignment requirement.
+        @param stride Number of elements from the start of one array to the
+            start of the next one.
+        @param numBoxes Number of boxes to test.
+        @param visibility An array of (numBoxes + 31) / 32 masks to store the
+            results, bit i % 32 of element i / 32 is set if box i is visible.
+        */
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* boxes,
+            size_t stride,
+            size_t numBoxes,
+            uint32* visibility) = 0;
+
+        /** Adjust the colours of particles, clamping the result.
+        @remarks
+            Every channel of Particle::mColour is incremented by the matching
+            channel of the adjustment and then clamped to [0, 1]. This is the
+            per frame update of the ColourFader affector.
+        @param particles An array of pointers to the particles to adjust.
+        @param numParticles Number of particles in the array.
+        @param adjust Amount to add to the colour of every particle.
+        */
+        virtual void adjustParticleColours(
+            Particle* const* particles,
+            size_t numParticles,
+            const ColourValue& adjust) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -353,9 +353,12 @@ namespace Ogre {
             this is the easiest way to step through all the particles in a system and apply the
             changes the affector wants to make.
         */
-        const std::list<Particle*>& _getActiveParticles() { return mActiveParticles; }
+        const std::vector<Particle*>& _getActiveParticleVector() { return mActiveParticles; }
 
-        /// @deprecated use _getActiveParticles()
+        /// @deprecated use _getActiveParticleVector(), this copies the particles into a list
+        OGRE_DEPRECATED const std::list<Particle*>& _getActiveParticles();
+
+        /// @deprecated use _getActiveParticleVector()
         OGRE_DEPRECATED ParticleIterator _getIterator(void);
 
         /** Sets the name of the material to be used for this billboard set.
@@ -680,9 +683,10 @@ namespace Ogre {
         /// Used to control if the particle system should emit particles or not.
         bool mIsEmitting;
 
-        typedef std::list<Particle*> ActiveParticleList;
-        typedef std::list<Particle*> FreeParticleList;
+        typedef std::vector<Particle*> ActiveParticleList;
+        typedef std::vector<Particle*> FreeParticleList;
         typedef std::vector<Particle*> ParticlePool;
+        typedef std::vector<Particle*> ParticleBlockList;
 
         /** Sort by direction functor */
         struct SortByDirectionFunctor
@@ -708,21 +712,25 @@ namespace Ogre {
 
         /** Active particle list.
             @remarks
-                This is a linked list of pointers to particles in the particle pool.
+                This is a contiguous array of pointers to particles in the particle pool,
+                so the per-frame passes over it (expiry, motion, affectors) walk linear memory.
             @par
-                This allows very fast insertions and deletions from anywhere in 
-                the list to activate / deactivate particles as well as reuse of 
-                Particle instances in the pool without construction & destruction 
+                Expired particles are removed with a single stable compaction pass per frame,
+                which keeps the emission order for unsorted systems and allows reuse of
+                Particle instances in the pool without construction & destruction
                 which avoids memory thrashing.
         */
         ActiveParticleList mActiveParticles;
 
+        /// Copy of mActiveParticles handed out by the deprecated list accessors
+        std::list<Particle*> mActiveParticleListCopy;
+
         /** Free particle queue.
             @remarks
                 This contains a list of the particles free for use as new instances
                 as required by the set. Particle instances are preconstructed up 
                 to the estimated size in the mParticlePool vector and are 
-                referenced on this deque at startup. As they get used this list
+                referenced on this stack at startup. As they get used this list
                 reduces, as they get released back to to the set they get added
                 back to the list.
         */
@@ -734,6 +742,13 @@ namespace Ogre {
         */
         ParticlePool mParticlePool;
 
+        /** Contiguous blocks backing mParticlePool.
+            @remarks
+                Each increasePool call allocates its particles as one array, so neighbouring
+                pool entries are neighbours in memory as well.
+        */
+        ParticleBlockList mParticleBlocks;
+
         typedef std::list<ParticleEmitter*> FreeEmittedEmitterList;
         typedef std::list<ParticleEmitter*> ActiveEmittedEmitterList;
         typedef std::vector<ParticleEmitter*> EmittedEmitterList;
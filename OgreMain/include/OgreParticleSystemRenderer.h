@@ -60,10 +60,22 @@ namespace Ogre {
         /** Delegated to by ParticleSystem::_updateRenderQueue
         @remarks
             The subclass must update the render queue using whichever Renderable
-            instance(s) it wishes.
+            instance(s) it wishes. Subclasses must override either this or the
+            deprecated std::list overload, which this forwards to by default.
         */
         virtual void _updateRenderQueue(RenderQueue* queue, 
-            std::list<Particle*>& currentParticles, bool cullIndividually) = 0;
+            std::vector<Particle*>& currentParticles, bool cullIndividually)
+        {
+            std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+            _updateRenderQueue(queue, particles, cullIndividually);
+        }
+        /// @deprecated override the std::vector overload instead
+        virtual void _updateRenderQueue(RenderQueue* queue, 
+            std::list<Particle*>& currentParticles, bool cullIndividually)
+        {
+            std::vector<Particle*> particles(currentParticles.begin(), currentParticles.end());
+            _updateRenderQueue(queue, particles, cullIndividually);
+        }
 
         /** Sets the material this renderer must use; called by ParticleSystem. */
         virtual void _setMaterial(MaterialPtr& mat) = 0;
@@ -83,9 +95,28 @@ namespace Ogre {
         virtual void _notifyParticleEmitted(Particle* particle) {}
         /** Optional callback notified when particle expired */
         virtual void _notifyParticleExpired(Particle* particle) {}
-        /** Optional callback notified when particles moved */
+        /** Optional callback notified when particles moved
+        @remarks
+            The default copies the particles to call the deprecated std::list overload,
+            so renderers should override this even if they ignore the notification.
+        */
+        virtual void _notifyParticleMoved(std::vector<Particle*>& currentParticles)
+        {
+            std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+            _notifyParticleMoved(particles);
+        }
+        /// @deprecated override the std::vector overload instead
         virtual void _notifyParticleMoved(std::list<Particle*>& currentParticles) {}
-        /** Optional callback notified when particles cleared */
+        /** Optional callback notified when particles cleared
+        @remarks
+            The default forwards to the deprecated std::list overload.
+        */
+        virtual void _notifyParticleCleared(std::vector<Particle*>& currentParticles)
+        {
+            std::list<Particle*> particles(currentParticles.begin(), currentParticles.end());
+            _notifyParticleCleared(particles);
+        }
+        /// @deprecated override the std::vector overload instead
         virtual void _notifyParticleCleared(std::list<Particle*>& currentParticles) {}
         /** Create a new ParticleVisualData instance for attachment to a particle.
         @remarks
@@ -43,6 +43,7 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 
 #include "OgrePrerequisites.h"
 #include "OgreSingleton.h"
+#include <mutex>
 #include "OgreHeaderPrefix.h"
 
 #if OGRE_PROFILING == 1
@@ -55,6 +56,10 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #   define OgreProfileBeginGPUEvent( g ) Ogre::Profiler::getSingleton().beginGPUEvent(g)
 #   define OgreProfileEndGPUEvent( g ) Ogre::Profiler::getSingleton().endGPUEvent(g)
 #   define OgreProfileMarkGPUEvent( e ) Ogre::Profiler::getSingleton().markGPUEvent(e)
+#   define OgreProfileTrace( a, g ) \
+        static const Ogre::ProfileMarker OGRE_TOKEN_PASTE(_OgreProfileMarker, __LINE__) = { (a), (g) }; \
+        Ogre::ProfileScope OGRE_TOKEN_PASTE(_OgreProfileScope, __LINE__) ( &OGRE_TOKEN_PASTE(_OgreProfileMarker, __LINE__) )
+#   define OgreProfileMarkFrame() Ogre::Profiler::getSingleton()._markTraceFrame()
 #else
 #   define OgreProfile( a )
 #   define OgreProfileBegin( a )
@@ -65,6 +70,8 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #   define OgreProfileBeginGPUEvent( e )
 #   define OgreProfileEndGPUEvent( e )
 #   define OgreProfileMarkGPUEvent( e )
+#   define OgreProfileTrace( a, g )
+#   define OgreProfileMarkFrame()
 #endif
 
 namespace Ogre {
@@ -142,6 +149,20 @@ namespace Ogre {
 
     };
 
+    /** Static description of a trace marker
+        @remarks
+            Use the macro OgreProfileTrace(name, group), which declares one of these per
+            call site. The address of the marker identifies it, so recording an event
+            neither copies nor hashes the name.
+    */
+    struct ProfileMarker
+    {
+        /// The name of the marker, must outlive the Profiler (usually a string literal)
+        const char* name;
+        /// A profile group identifier, see ProfileGroupMask
+        uint32 groupID;
+    };
+
     /// Represents an individual profile call
     class _OgreExport ProfileInstance : public ProfilerAlloc
     {
@@ -371,6 +392,67 @@ namespace Ogre {
             */
             void removeListener(ProfileSessionListener* listener);
 
+            /** Sets whether trace events are recorded
+            @remarks
+                Tracing is independent of the aggregated statistics enabled by setEnabled.
+                Every thread hitting an OgreProfileTrace marker records its events into its
+                own ring buffer, so tracing is cheap enough to be left on and the last
+                frames can be exported with writeChromeTrace once something interesting
+                happened.
+            */
+            void setTraceEnabled(bool enabled);
+
+            /** Gets whether trace events are recorded */
+            bool getTraceEnabled() const { return mTraceEnabled.load(std::memory_order_relaxed); }
+
+            /** Sets the number of frames exported by writeChromeTrace, defaults to 10 */
+            void setTraceFrameCount(size_t frames);
+
+            /** Gets the number of frames exported by writeChromeTrace */
+            size_t getTraceFrameCount() const { return mTraceFrameCount; }
+
+            /** Writes the trace events of the last frames in the Chrome trace_event format
+            @remarks
+                The output can be loaded into chrome://tracing or similar viewers. Events
+                older than the frame count set with setTraceFrameCount are skipped, as are
+                events that were overwritten in the ring buffers while exporting.
+            */
+            void writeChromeTrace(std::ostream& stream) const;
+
+            /** Writes the trace events of the last frames to the given file
+            @see writeChromeTrace
+            */
+            void saveChromeTrace(const String& filename) const;
+
+            /// Returns a monotonic timestamp in nanoseconds, as used by trace events
+            static uint64 getTraceTimestamp();
+
+            /// Whether a trace event of the given group should be recorded
+            bool _isTracing(uint32 groupID) const
+            {
+                return mTraceEnabled.load(std::memory_order_relaxed) && (groupID & mProfileMask);
+            }
+
+            /** Records a trace event on the calling thread
+            @remarks
+                Use the macro OgreProfileTrace(name, group) instead of calling this directly
+            */
+            void _recordTraceEvent(const ProfileMarker* marker, uint64 begin, uint64 end);
+
+            /** Marks the beginning of a frame in the trace
+            @remarks
+                Called by Root, use the macro OgreProfileMarkFrame() in custom render loops
+            */
+            void _markTraceFrame();
+
+            /** Releases the trace buffer of a thread which ended
+            @remarks
+                Called when a thread which recorded trace events exits. The buffer is
+                freed once its events are older than the frames exported by writeChromeTrace.
+            @param serial identifies the Profiler the buffer was created by
+            */
+            void _releaseThreadTraceBuffer(uint32 serial, void* buffer);
+
             /// @copydoc Singleton::getSingleton()
             static Profiler& getSingleton(void);
             /// @copydoc Singleton::getSingleton()
@@ -439,6 +521,29 @@ namespace Ogre {
             Real mAverageFrameTime;
             bool mResetExtents;
 
+            struct TraceBuffer;
+            typedef std::vector<std::unique_ptr<TraceBuffer>> TraceBufferList;
+
+            /// Returns the trace buffer of the calling thread, creating it on first use
+            TraceBuffer* getThreadTraceBuffer();
+            /// Frees the buffers of ended threads, which hold no exported events. mTraceMutex must be locked
+            void pruneTraceBuffers();
+
+            /// guards the buffer list and frames, independent of OGRE_THREAD_SUPPORT as workers trace anyway
+            mutable std::mutex mTraceMutex;
+            /// One ring buffer per thread that recorded trace events
+            TraceBufferList mTraceBuffers;
+            /// Index of the next thread that records trace events
+            uint32 mNextTraceThreadIndex;
+            /// Start times of the last mTraceFrameCount frames
+            std::deque<uint64> mTraceFrames;
+            size_t mTraceFrameCount;
+            /// Origin of the exported timestamps
+            uint64 mTraceEpoch;
+            /// Distinguishes this instance from earlier Profilers in thread local caches
+            uint32 mTraceSerial;
+            std::atomic<bool> mTraceEnabled;
+
 
     }; // end class
 
@@ -469,6 +574,33 @@ namespace Ogre {
         /// The group ID
         uint32 mGroupID;
     };
+
+    /** A scoped trace event that will be recorded by the Profiler
+        @remarks
+            Use the macro OgreProfileTrace(name, group) instead of instantiating this
+            directly. Nothing but a flag is checked if tracing is disabled.
+    */
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const ProfileMarker* marker) : mMarker(marker), mBegin(0)
+        {
+            Profiler* profiler = Profiler::getSingletonPtr();
+            if (profiler && profiler->_isTracing(marker->groupID))
+                mBegin = Profiler::getTraceTimestamp();
+        }
+        ~ProfileScope()
+        {
+            if (mBegin)
+                Profiler::getSingleton()._recordTraceEvent(mMarker, mBegin,
+                                                           Profiler::getTraceTimestamp());
+        }
+
+    private:
+        const ProfileMarker* mMarker;
+        /// The start time, 0 if the event is not recorded
+        uint64 mBegin;
+    };
     /** @} */
     /** @} */
 
@@ -82,7 +82,8 @@ namespace Ogre {
         implementation can handle both unsigned and signed integers, as well as
         floats (which are often not supported by other radix sorters). doubles
         are not supported; you will need to implement your functor object to convert
-        to float if you wish to use this sort routine.
+        to float if you wish to use this sort routine. 64 bit unsigned integers are
+        supported, so several sort criteria can be packed into a single key.
     */
     template <class TContainer, class TContainerValueType, typename TCompValueType>
     class RadixSort
@@ -91,8 +92,8 @@ namespace Ogre {
         typedef typename TContainer::iterator ContainerIter;
     protected:
         /// Alpha-pass counters of values (histogram)
-        /// 4 of them so we can radix sort a maximum of a 32bit value
-        int mCounters[4][256];
+        /// 8 of them so we can radix sort a maximum of a 64bit value
+        int mCounters[8][256];
         /// Beta-pass offsets 
         int mOffsets[256];
         /// Sort area size
@@ -302,6 +303,11 @@ namespace Ogre {
 
             for (p = 0; p < mNumPasses - 1; ++p)
             {
+                // skip bytes which are the same for all values, e.g. the high
+                // bytes of packed keys, the pass would not change the order
+                if (mCounters[p][getByte(p, (*mSrc)[0].key)] == mSortSize)
+                    continue;
+
                 sortPass(p);
                 // flip src/dst
                 SortVector* tmp = mSrc;
@@ -139,6 +139,7 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersCannotBeReceivers;
+        bool mSortKeysEnabled;
 
         RenderableListener* mRenderableListener;
     public:
@@ -274,6 +275,18 @@ namespace Ogre {
         */
         bool getShadowCastersCannotBeReceivers(void) const;
 
+        /** Sets whether the queue groups are ordered by 64 bit sort keys.
+        @remarks
+            Recommended for scenes with many renderables per queue group, where
+            the map of pass groups becomes expensive to update each frame.
+            Call this when the queue is empty.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
+        /** Gets whether the queue groups are ordered by 64 bit sort keys. */
+        bool getSortKeysEnabled(void) const { return mSortKeysEnabled; }
+
         /** Set a renderable listener on the queue.
         @remarks
             There can only be a single renderable listener on the queue, since
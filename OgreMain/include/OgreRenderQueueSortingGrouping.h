@@ -219,6 +219,43 @@ namespace Ogre {
         /// Radix sorter for sort value 2 (distance)
         static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
 
+        /// Functor for the sort key of pass groups: pass hash, then pass
+        struct RadixSortFunctorPassKey
+        {
+            uint64 operator()(const RenderablePass& p) const
+            {
+                // separates passes with the same hash, a collision of the pointer
+                // bits only splits a group
+                uint32 passBits = uint32(reinterpret_cast<uintptr_t>(p.pass) >> 3);
+                return (uint64(p.pass->getHash()) << 32) | passBits;
+            }
+        };
+
+        /// Functor for the sort key of depth sorting: descending distance, then pass hash
+        struct RadixSortFunctorDepthKey
+        {
+            const Camera* camera;
+
+            RadixSortFunctorDepthKey(const Camera* cam)
+                : camera(cam)
+            {
+            }
+
+            uint64 operator()(const RenderablePass& p) const
+            {
+                float depth = static_cast<float>(p.renderable->getSquaredViewDepth(camera));
+                uint32 depthBits;
+                memcpy(&depthBits, &depth, sizeof(float));
+                // map the float to an unsigned value of the same order, then invert it
+                // to sort descending
+                depthBits ^= (depthBits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+                return (uint64(~depthBits) << 32) | p.pass->getHash();
+            }
+        };
+
+        /// Radix sorter for 64 bit sort keys
+        static RadixSort<RenderablePassList, RenderablePass, uint64> msRadixSorterKeys;
+
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
 
@@ -226,10 +263,18 @@ namespace Ogre {
         PassGroupRenderableMap mGrouped;
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
+        /// Whether to use sort keys instead of mGrouped
+        bool mSortKeysEnabled;
+        /// Grouped by sort key, used instead of mGrouped if sort keys are enabled
+        RenderablePassList mSortedByPass;
+        /// Renderables of the pass group currently visited
+        mutable RenderableList mVisitedGroup;
 
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
+        void acceptVisitorSortedByPass(QueuedRenderableVisitor* visitor) const;
+        /// Internal visitor implementation
         void acceptVisitorDescending(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
         void acceptVisitorAscending(QueuedRenderableVisitor* visitor) const;
@@ -267,6 +312,21 @@ namespace Ogre {
             mOrganisationMode |= uint8(om);
         }
 
+        /** Sets whether to order the collection by 64 bit sort keys.
+        @remarks
+            Instead of maintaining a map of pass groups, the renderables are kept in
+            flat lists, which are ordered by a radix sort on keys packing the pass
+            hash, or the view depth, in sort(). The order is the same, except for
+            passes with equal hashes or renderables at equal depths. This saves the
+            map lookups for large numbers of renderables.
+        @par
+            You can only do this when the collection is empty.
+        */
+        void setSortKeysEnabled(bool enabled);
+
+        /** Gets whether the collection is ordered by 64 bit sort keys. */
+        bool getSortKeysEnabled(void) const { return mSortKeysEnabled; }
+
         /// Add a renderable to the collection using a given pass
         void addRenderable(Pass* pass, Renderable* rend);
         
@@ -434,6 +494,11 @@ namespace Ogre {
             mShadowCastersNotReceivers = ind;
         }
 
+        /** Sets whether the collections are ordered by 64 bit sort keys.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
         /** Merge group of renderables. 
         */
         void merge( const RenderPriorityGroup* rhs );
@@ -466,6 +531,8 @@ namespace Ogre {
         bool mShadowsEnabled;
         /// Bitmask of the organisation modes requested (for new priority groups)
         uint8 mOrganisationMode;
+        /// Whether the priority groups use sort keys
+        bool mSortKeysEnabled;
 
 
     public:
@@ -479,6 +546,7 @@ namespace Ogre {
             , mShadowCastersNotReceivers(shadowCastersNotReceivers)
             , mShadowsEnabled(true)
             , mOrganisationMode(0)
+            , mSortKeysEnabled(false)
         {
         }
 
@@ -521,6 +589,8 @@ namespace Ogre {
                     pPriorityGrp->resetOrganisationModes();
                     pPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                 }
+                if (mSortKeysEnabled)
+                    pPriorityGrp->setSortKeysEnabled(true);
 
                 mPriorityGroups.emplace(priority, pPriorityGrp);
             }
@@ -615,6 +685,19 @@ namespace Ogre {
                 i->second->setShadowCastersCannotBeReceivers(ind);
             }
         }
+        /** Sets whether the priority groups are ordered by 64 bit sort keys.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mSortKeysEnabled = enabled;
+            PriorityMap::iterator i, iend;
+            iend = mPriorityGroups.end();
+            for (i = mPriorityGroups.begin(); i != iend; ++i)
+            {
+                i->second->setSortKeysEnabled(enabled);
+            }
+        }
         /** Reset the organisation modes required for the solids in this group. 
         @remarks
             You can only do this when the group is empty, ie after clearing the 
@@ -695,6 +778,8 @@ namespace Ogre {
                         pDstPriorityGrp->resetOrganisationModes();
                         pDstPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                     }
+                    if (mSortKeysEnabled)
+                        pDstPriorityGrp->setSortKeysEnabled(true);
 
                     mPriorityGroups.emplace(priority, pDstPriorityGrp);
                 }
@@ -417,8 +417,15 @@ namespace Ogre {
             Resource* resourceBeingLoaded,
             bool throwOnFailure = true) const;
 
+        /** Prepare the resources of a group using the WorkQueue worker threads. Internal use only
+        @see setParallelPrepare
+        */
+        void prepareResourcesParallel(ResourceGroup* grp);
+
         /// Stored current group - optimisation for when bulk loading a group
         ResourceGroup* mCurrentGroup;
+        /// Prepare resources using the WorkQueue worker threads when loading a group?
+        bool mParallelPrepare;
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -493,6 +500,22 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Sets whether loadResourceGroup prepares the resources using the WorkQueue
+            worker threads.
+
+            When enabled, the prepare stage (I/O and decoding) of the resources in the
+            group is run concurrently before loading, one load order at a time. The load
+            stage then runs in order on the calling thread as usual.
+        @note
+            Any ResourceLoadingListener must be thread safe. Resources whose manager does
+            not report ResourceManager::isParallelPrepareSafe, like meshes and textures do,
+            and manually loaded resources are always prepared on the calling thread.
+        */
+        void setParallelPrepare(bool parallel) { mParallelPrepare = parallel; }
+
+        /// Gets whether loadResourceGroup prepares the resources concurrently
+        bool getParallelPrepare() const { return mParallelPrepare; }
+
         /** Unloads a resource group.
 
             This method unloads all the resources that have been declared as
@@ -422,6 +422,15 @@ namespace Ogre {
         /** Gets a string identifying the type of resource this manager handles. */
         const String& getResourceType(void) const { return mResourceType; }
 
+        /** Whether resources of this type can be prepared on the WorkQueue worker threads
+            while loading a resource group.
+        @remarks
+            Only return true if preparing just reads and decodes the resource stream. Resources
+            preparing further resources would modify the resource managers concurrently.
+        @see ResourceGroupManager::setParallelPrepare
+        */
+        virtual bool isParallelPrepareSafe(void) const { return false; }
+
         /** Sets whether this manager and its resources habitually produce log output */
         void setVerbose(bool v) { mVerbose = v; }
 
@@ -212,10 +212,13 @@ namespace Ogre
             Defaults to "ogre.cfg", may be left blank to load nothing.
         @param logFileName The logfile to create, defaults to Ogre.log, may be 
             left blank if you've already set up LogManager & Log yourself
+        @param workStealingQueue Use a WorkStealingWorkQueue instead of the
+            DefaultWorkQueue, which scales better with many small requests
         */
         Root(const String& pluginFileName = "plugins.cfg",
             const String& configFileName = "ogre.cfg", 
-            const String& logFileName = "Ogre.log");
+            const String& logFileName = "Ogre.log",
+            bool workStealingQueue = false);
         ~Root();
 
         /** Saves the details of the current configuration
@@ -589,6 +589,47 @@ namespace Ogre {
         LightInfoList mTestLightInfos; // potentially new list
         ulong mLightsDirtyCounter;
 
+        /** Uniform grid over the lights affecting the frustum, used by _populateLightList.
+        @remarks
+            The cells are not stored as an array but as a sorted list of (cell, light)
+            pairs, so sparse scenes need no memory for empty cells. The grid holds
+            indices into the light list, so the lights found for a query can be
+            visited in the order of the light list.
+        */
+        struct _OgrePrivate LightGrid
+        {
+            /// Below this number of lights, a linear scan is faster
+            static const size_t MIN_LIGHTS = 32;
+            /// Lights and queries overlapping more cells are not put into the grid
+            static const size_t MAX_CELLS = 64;
+
+            /// mLightsDirtyCounter when the grid was built
+            ulong dirtyCounter;
+            /// Number of lights when the grid was built
+            size_t lightCount;
+            /// Whether there are enough lights to use the grid
+            bool enabled;
+            Real cellSize;
+            /// (cell key, light index), sorted by cell
+            std::vector<std::pair<uint64, uint32> > cells;
+            /// Lights which are in every cell, i.e. directional and very large lights
+            std::vector<uint32> unbounded;
+            /// Lights found by the last query
+            std::vector<uint32> found;
+
+            LightGrid() : dirtyCounter(~0ul), lightCount(0), enabled(false), cellSize(1) {}
+
+            void build(const LightList& lights);
+            /** Collects the lights of the cells overlapping the sphere, in ascending order.
+            @return false if the sphere overlaps too many cells to be worth it
+            */
+            bool query(const Vector3& position, Real radius);
+
+        private:
+            bool getCellRange(const Vector3& position, Real radius, int64* minCell, int64* maxCell) const;
+        };
+        LightGrid mLightGrid;
+
         /// Simple structure to hold MovableObject map and a mutex to go with it.
         struct MovableObjectCollection
         {
@@ -1024,6 +1065,10 @@ namespace Ogre {
         /// Visibility mask used to show / hide objects
         uint32 mVisibilityMask;
         bool mFindVisibleObjects;
+        /// Update the scene graph using the WorkQueue worker threads?
+        bool mParallelSceneGraphUpdate;
+        /// Cull the scene graph using the WorkQueue worker threads?
+        bool mParallelVisibilityCulling;
         /// Suppress render state changes?
         bool mSuppressRenderStateChanges;
         /// Suppress shadows?
@@ -1884,6 +1929,18 @@ namespace Ogre {
         */
         virtual void _updateSceneGraph(Camera* cam);
 
+        /** Internal method for updating the given subtree using the WorkQueue worker threads.
+            @see setParallelSceneGraphUpdate
+        */
+        void _updateSceneGraphParallel(SceneNode* node);
+
+        /** Whether the nodes of this SceneManager can be updated concurrently.
+            @remarks
+                Subclasses using SceneNode implementations which modify shared state while
+                being updated must return false, in which case the update is always serial.
+        */
+        virtual bool supportsParallelSceneGraphUpdate(void) const { return true; }
+
         /** Internal method which parses the scene to find visible objects to render.
             @remarks
                 If you're implementing a custom scene manager, this is the most important method to
@@ -1897,6 +1954,12 @@ namespace Ogre {
         */
         virtual void _findVisibleObjects(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
 
+        /** Internal method for finding the visible objects of the given subtree using the WorkQueue worker threads.
+            @see setParallelVisibilityCulling
+        */
+        void _findVisibleObjectsParallel(SceneNode* node, Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+                                         bool onlyShadowCasters);
+
         /** Internal method for issuing the render operation.*/
         void _issueRenderOp(Renderable* rend, const Pass* pass);
 
@@ -3350,6 +3413,36 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets whether the scene graph is updated in parallel.
+        @remarks
+            If enabled, _updateSceneGraph splits the tree of SceneNode instances
+            into independent subtrees and updates their derived transforms and
+            world bounds on the worker threads of the Root WorkQueue. The results
+            are identical to the serial update, but Node::Listener::nodeUpdated and
+            MovableObject::Listener::objectMoved may then be called concurrently from
+            several threads. Scene managers whose nodes modify shared state during the
+            update always update serially. Disabled by default.
+        */
+        void setParallelSceneGraphUpdate(bool enabled) { mParallelSceneGraphUpdate = enabled; }
+
+        /** Gets whether the scene graph is updated in parallel. */
+        bool getParallelSceneGraphUpdate(void) const { return mParallelSceneGraphUpdate; }
+
+        /** Sets whether the scene graph is culled in parallel.
+        @remarks
+            If enabled, _findVisibleObjects tests disjoint subtrees of SceneNode instances
+            against the camera frustum on the worker threads of the Root WorkQueue. The
+            visible objects are then added to the RenderQueue on the calling thread in the
+            same order as the serial traversal, so rendering is unaffected and
+            MovableObject::_updateRenderQueue is never called concurrently. Only the default
+            scene graph traversal supports this; scene managers with their own spatial
+            structure ignore the setting. Disabled by default.
+        */
+        void setParallelVisibilityCulling(bool enabled) { mParallelVisibilityCulling = enabled; }
+
+        /** Gets whether the scene graph is culled in parallel. */
+        bool getParallelVisibilityCulling(void) const { return mParallelVisibilityCulling; }
+
         /** Set whether to automatically normalise normals on objects whenever they
             are scaled.
         @remarks
@@ -61,6 +61,10 @@ namespace Ogre {
         typedef std::vector<MovableObject*> ObjectMap;
         typedef VectorIterator<ObjectMap> ObjectIterator;
         typedef ConstVectorIterator<ObjectMap> ConstObjectIterator;
+        /** Visible nodes in the order _findVisibleObjects visits them.
+            The flag is false when entering a node and true when leaving it after its children.
+        */
+        typedef std::vector<std::pair<SceneNode*, bool> > VisibleNodeList;
 
     protected:
         ObjectMap mObjectsByName;
@@ -219,6 +223,23 @@ namespace Ogre {
             VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which culls this node and its children against the camera, recording
+            the visible nodes rather than adding their objects to a queue.
+            @remarks
+                Only reads the node and camera state, so disjoint subtrees may be processed concurrently
+                once the camera frustum planes are up to date. Pass the entries to _addToRenderQueue
+                in order to get the same result as _findVisibleObjects.
+        */
+        void _findVisibleNodes(Camera* cam, VisibleNodeList& nodes);
+
+        /** Internal method which adds an entry recorded by _findVisibleNodes to the queue.
+            @param leaving false to add the attached objects, true to add the debug renderables
+                which _findVisibleObjects adds after the children
+            @see _findVisibleObjects for the other parameters
+        */
+        void _addToRenderQueue(Camera* cam, RenderQueue* queue, VisibleObjectsBoundsInfo* visibleBounds,
+            bool leaving, bool displayNodes, bool onlyShadowCasters);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
@@ -61,6 +61,7 @@ namespace Ogre {
     {
         friend class Mesh;
         friend class MeshSerializerImpl;
+        friend class MeshSerializerBakedImpl;
         friend class MeshSerializerImpl_v1_2;
         friend class MeshSerializerImpl_v1_1;
     public:
@@ -402,6 +402,8 @@ namespace Ogre {
         /// get the default sampler
         const SamplerPtr& getDefaultSampler();
 
+        bool isParallelPrepareSafe(void) const override { return true; }
+
         /// @copydoc Singleton::getSingleton()
         static TextureManager& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
@@ -273,6 +273,32 @@ namespace Ogre
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false) = 0;
 
+        /** Add a generic task to the queue.
+        @remarks
+            Tasks are lightweight alternatives to requests for fire-and-forget
+            work that needs no RequestHandler or Response. They are picked up by
+            the worker threads before any pending requests. If the queue is not
+            running or threading is disabled, the task is executed immediately
+            on the calling thread, which is all the default implementation does.
+        @note
+            Tasks must not throw; use parallelFor if errors need to be
+            propagated back to the caller.
+        */
+        virtual void addTask(std::function<void()> task) { task(); }
+
+        /** Call func(0) to func(count - 1) in parallel using the worker threads.
+        @remarks
+            The calling thread takes part in processing and the method only
+            returns once all items have been processed. It is therefore safe
+            to call even if all workers are busy or threading is disabled.
+            Items may be processed in any order and concurrently, so func
+            must be thread safe. The first exception thrown by func is 
+            rethrown on the calling thread once all items are done.
+        @param count The number of items to process
+        @param func The function processing a single item
+        */
+        void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
         /** Abort a previously issued request.
         If the request is still waiting to be processed, it will be 
         removed from the queue.
@@ -443,6 +469,8 @@ namespace Ogre
         /// @copydoc WorkQueue::addRequest
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::addTask
+        virtual void addTask(std::function<void()> task);
         /// @copydoc WorkQueue::abortRequest
         virtual void abortRequest(RequestID id);
         /// @copydoc WorkQueue::abortPendingRequest
@@ -571,17 +599,32 @@ namespace Ogre
         void processRequestResponse(Request* r, bool synchronous);
         Response* processRequest(Request* r);
         void processResponse(Response* r);
+        /** Retry, deliver or discard the outcome of a processed request.
+        @remarks
+            The caller must hold the lock protecting r from being aborted concurrently.
+        @param r The processed request
+        @param response The response returned by the RequestHandler, may be null
+        @param synchronous Whether to call the response handlers immediately
+            instead of queueing the response for processResponses
+        */
+        void dispatchResponse(Request* r, Response* response, bool synchronous);
         /// Notify workers about a new request. 
         virtual void notifyWorkers() = 0;
         /// Put a Request on the queue with a specific RequestID.
-        void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
+        virtual void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
         
         RequestQueue mIdleRequestQueue; // Guarded by mIdleMutex
         bool mIdleThreadRunning; // Guarded by mIdleMutex
         Request* mIdleProcessed; // Guarded by mProcessMutex
-        
+
+        typedef std::deque<std::function<void()> > TaskQueue;
+        TaskQueue mTaskQueue; // Guarded by mRequestMutex
 
         bool processIdleRequests();
+        /// Execute the next pending task, returns false if there was none
+        bool processNextTask();
+        /// Execute the tasks left over once the workers have stopped
+        void processRemainingTasks();
     };
 
 
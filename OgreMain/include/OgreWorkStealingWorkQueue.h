@@ -0,0 +1,186 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __OgreWorkStealingWorkQueue_H__
+#define __OgreWorkStealingWorkQueue_H__
+
+#include "OgreWorkQueue.h"
+
+#include <atomic>
+
+#include "OgreHeaderPrefix.h"
+
+/// TBB has no thread synchronisers to wait for work with, so the queue processes all requests synchronously
+#define OGRE_WORK_STEALING_THREADS (OGRE_THREAD_SUPPORT && OGRE_THREAD_PROVIDER != 3)
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** Work queue distributing requests over per-worker queues.
+    @remarks
+        Where DefaultWorkQueue funnels every request through a single locked
+        queue, this implementation gives each worker thread its own queue. 
+        Requests are submitted without taking a lock. A worker taking a job
+        locks its own queue together with each queue it probes, starting with
+        its own and stealing the oldest job of another worker once its own
+        is empty. So contention is spread over the queues rather than on a
+        single lock, which scales better when many small requests are
+        submitted from several threads.
+    @par
+        Channels, request and response handlers, retries, aborting, idle
+        requests and tasks behave as with DefaultWorkQueue. Requests are
+        processed in order of submission per worker queue only.
+        Use Root's constructor to make this the default work queue.
+        The worker threads need a thread provider other than TBB.
+    @note
+        startup and shutdown add and remove the queues of the workers, so they
+        must not be called while other threads add requests or tasks.
+    */
+    class _OgreExport WorkStealingWorkQueue : public DefaultWorkQueueBase
+    {
+    public:
+        WorkStealingWorkQueue(const String& name = BLANKSTRING);
+        virtual ~WorkStealingWorkQueue();
+
+        /// @copydoc WorkQueue::startup
+        virtual void startup(bool forceRestart = true);
+        /// @copydoc WorkQueue::shutdown
+        virtual void shutdown();
+
+        /// Main function for each thread spawned.
+        virtual void _threadMain();
+        /// @copydoc DefaultWorkQueueBase::_processNextRequest
+        virtual void _processNextRequest();
+
+        /// @copydoc WorkQueue::addRequest
+        virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
+            bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::addTask
+        virtual void addTask(std::function<void()> task);
+        /// @copydoc WorkQueue::abortRequest
+        virtual void abortRequest(RequestID id);
+        /// @copydoc WorkQueue::abortPendingRequest
+        virtual bool abortPendingRequest(RequestID id);
+        /// @copydoc WorkQueue::abortRequestsByChannel
+        virtual void abortRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortPendingRequestsByChannel
+        virtual void abortPendingRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortAllRequests
+        virtual void abortAllRequests();
+        /// @copydoc WorkQueue::setPaused
+        virtual void setPaused(bool pause);
+        /// @copydoc WorkQueue::isPaused
+        virtual bool isPaused() const;
+
+    protected:
+        virtual void notifyWorkers();
+        virtual void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
+
+    private:
+        /// A queued request or task
+        struct Job
+        {
+            Job* next;
+            Request* request;
+            std::function<void()> task;
+        };
+
+        /// The queue of a single worker; slot 0 is shared by all other threads
+        struct Slot
+        {
+            /// Jobs submitted but not yet moved to the queues below, most recent first
+            std::atomic<Job*> inbox;
+
+            /// Guards everything below
+            OGRE_WQ_MUTEX(mutex);
+            std::deque<Job*> tasks;
+            std::deque<Job*> requests;
+            /// Requests taken from any slot which are being processed by this slot's thread
+            RequestQueue processing;
+
+            Slot() : inbox(NULL) {}
+            /// Move the inbox to the queues, the mutex must be locked
+            void drainInbox();
+        };
+
+        typedef std::vector<Slot*> SlotList;
+        /// Only resized by startup and shutdown, which must not race with submitting jobs
+        SlotList mSlots;
+        /// Set while mSlots is resized, to catch jobs submitted concurrently in debug builds
+        std::atomic<bool> mResizingSlots;
+#if OGRE_WORK_STEALING_THREADS
+        typedef std::vector<OGRE_THREAD_TYPE*> WorkerThreadList;
+        WorkerThreadList mWorkers;
+#endif
+
+        std::atomic<RequestID> mNextRequestID;
+        std::atomic<size_t> mNextSubmitSlot;
+        std::atomic<size_t> mNextWorkerSlot;
+        std::atomic<size_t> mPendingTasks;
+        std::atomic<size_t> mPendingRequests;
+        std::atomic<bool> mPausedRequests;
+
+        OGRE_WQ_MUTEX(mWakeMutex);
+        OGRE_WQ_THREAD_SYNCHRONISER(mWakeCondition);
+        std::atomic<size_t> mSleepingWorkers;
+        size_t mNumThreadsRegisteredWithRS; // Guarded by mWakeMutex
+
+        /// Slot of the calling thread
+        size_t getCurrentSlot() const;
+        /// Slot to queue new jobs of the calling thread to
+        size_t getSubmitSlot();
+        /// Queue a job to the given slot without locking
+        void pushJob(size_t slot, Job* job);
+        void queueRequest(Request* r);
+        /// Take the next job from the given slot or steal one, returns null if there is none
+        Job* takeJob(size_t slot, bool task);
+        void processJob(size_t slot, Job* job);
+        /// Process a single job, returns false if there was none
+        bool processNextJob();
+        bool hasWork();
+        void waitForWork();
+        void wakeWorkers(bool all);
+
+        /// Abort the requests held by the slots, which match pred. The first lockedSlots are locked by the caller
+        template<typename P> bool abortInSlots(const P& pred, bool pendingOnly, bool firstOnly,
+                                               size_t lockedSlots = 0);
+    };
+
+    /** @} */
+    /** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -65,8 +65,13 @@ namespace Ogre {
          mCurrentSceneManager(0),
          mMainCamBoundsInfo(0),
          mCurrentPass(0),
-         mDummyNode(NULL)
+         mDummyNode(NULL),
+         mIdentityView(false),
+         mIdentityProj(false)
     {
+        static std::atomic<uint32> nextSourceId(0);
+        mSourceId = ++nextSourceId;
+
         mBlankLight.setDiffuseColour(ColourValue::Black);
         mBlankLight.setSpecularColour(ColourValue::Black);
         mBlankLight.setAttenuation(0,1,0,0);
@@ -80,7 +85,18 @@ namespace Ogre {
             mCurrentTextureProjector[i] = 0;
             mShadowCamDepthRangesDirty[i] = false;
         }
-
+        // 0 is reserved for values never written
+        for (int i = 0; i < 4; ++i)
+            mGenerations[i] = 1;
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::markChanged(uint16 variability)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            if (variability & (1 << i))
+                ++mGenerations[i];
+        }
     }
     //-----------------------------------------------------------------------------
 	const Camera* AutoParamDataSource::getCurrentCamera() const
@@ -103,6 +119,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderable(const Renderable* rend)
     {
+        markChanged(GPV_PER_OBJECT);
+        // the view and projection matrices are global, unless the renderable overrides them
+        bool identityView = rend && rend->getUseIdentityView();
+        bool identityProj = rend && rend->getUseIdentityProjection();
+        if (identityView != mIdentityView || identityProj != mIdentityProj)
+        {
+            markChanged(GPV_GLOBAL);
+            mIdentityView = identityView;
+            mIdentityProj = identityProj;
+        }
         mCurrentRenderable = rend;
         mWorldMatrixDirty = true;
         mViewMatrixDirty = true;
@@ -127,6 +153,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
     {
+        // also covers values changing once per frame, like the time
+        markChanged(GPV_ALL);
         mCurrentCamera = cam;
         mCameraRelativeRendering = useCameraRelative;
         mCameraRelativePosition = cam->getDerivedPosition();
@@ -146,6 +174,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentLightList(const LightList* ll)
     {
+        markChanged(GPV_LIGHTS);
         mCurrentLightList = ll;
         for(size_t i = 0; i < ll->size() && i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
         {
@@ -246,17 +275,20 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setMainCamBoundsInfo(VisibleObjectsBoundsInfo* info)
     {
+        markChanged(GPV_ALL);
         mMainCamBoundsInfo = info;
         mSceneDepthRangeDirty = true;
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentSceneManager(const SceneManager* sm)
     {
+        markChanged(GPV_ALL);
         mCurrentSceneManager = sm;
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setWorldMatrices(const Affine3* m, size_t count)
     {
+        markChanged(GPV_PER_OBJECT);
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
@@ -508,6 +540,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setAmbientLightColour(const ColourValue& ambient)
     {
+        markChanged(GPV_GLOBAL);
         mAmbientLight = ambient;
     }
     //---------------------------------------------------------------------
@@ -614,11 +647,14 @@ namespace Ogre {
         Real expDensity, Real linearStart, Real linearEnd)
     {
         (void)mode; // ignored
+        Vector4f params(expDensity, linearStart, linearEnd,
+                        linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0);
+        // set for every pass, so only mark a change
+        if (colour == mFogColour && params == mFogParams)
+            return;
+        markChanged(GPV_GLOBAL);
         mFogColour = colour;
-        mFogParams[0] = expDensity;
-        mFogParams[1] = linearStart;
-        mFogParams[2] = linearEnd;
-        mFogParams[3] = linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0;
+        mFogParams = params;
     }
     //-----------------------------------------------------------------------------
     const ColourValue& AutoParamDataSource::getFogColour(void) const
@@ -633,9 +669,14 @@ namespace Ogre {
 
     void AutoParamDataSource::setPointParameters(bool attenuation, const Vector4f& params)
     {
-        mPointParams = params;
+        Vector4f pointParams = params;
         if(attenuation)
-            mPointParams[0] *= getViewportHeight();
+            pointParams[0] *= getViewportHeight();
+        // set for every pass, so only mark a change
+        if (pointParams == mPointParams)
+            return;
+        markChanged(GPV_GLOBAL);
+        mPointParams = pointParams;
     }
 
     const Vector4f& AutoParamDataSource::getPointParams() const
@@ -647,6 +688,7 @@ namespace Ogre {
     {
         if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
         {
+            markChanged(GPV_LIGHTS);
             mCurrentTextureProjector[index] = frust;
             mTextureViewProjMatrixDirty[index] = true;
             mTextureWorldViewProjMatrixDirty[index] = true;
@@ -800,6 +842,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
+        markChanged(GPV_ALL);
         mCurrentRenderTarget = target;
     }
     //-----------------------------------------------------------------------------
@@ -810,16 +853,19 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentViewport(const Viewport* viewport)
     {
+        markChanged(GPV_ALL);
         mCurrentViewport = viewport;
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowDirLightExtrusionDistance(Real dist)
     {
+        markChanged(GPV_LIGHTS);
         mDirLightExtrusionDistance = dist;
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowPointLightExtrusionDistance(Real dist)
     {
+        markChanged(GPV_LIGHTS);
         mPointLightExtrusionDistance = dist;
     }
     //-----------------------------------------------------------------------------
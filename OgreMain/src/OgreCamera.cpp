@@ -942,6 +942,18 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    uint32 Camera::isVisible(const AxisAlignedBoxBatch& boxes) const
+    {
+        if (mCullFrustum)
+        {
+            return mCullFrustum->isVisible(boxes);
+        }
+        else
+        {
+            return isVisibleBatched(boxes);
+        }
+    }
+    //-----------------------------------------------------------------------
     const Frustum::Corners& Camera::getWorldSpaceCorners(void) const
     {
         if (mCullFrustum)
@@ -279,6 +279,7 @@ void CompositorChain::setCompositorEnabled(size_t position, bool state)
 //-----------------------------------------------------------------------
 void CompositorChain::preRenderTargetUpdate(const RenderTargetEvent& evt)
 {
+    OgreProfileTrace("CompositorChain::preRenderTargetUpdate", OGREPROF_RENDERING);
     /// Compile if state is dirty
     if(mDirty)
         _compile();
@@ -461,6 +462,7 @@ void CompositorChain::clearCompiledState()
 //-----------------------------------------------------------------------
 void CompositorChain::_compile()
 {
+    OgreProfileTrace("CompositorChain::_compile", OGREPROF_GENERAL);
     // remove original scene if it has the wrong material scheme
     if( mOriginalSceneScheme != mViewport->getMaterialScheme() )
     {
@@ -27,6 +27,20 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#include <sys/stat.h>
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   if !defined(NOMINMAX) && defined(_MSC_VER)
+#       define NOMINMAX // required to stop windows.h messing up std::min
+#   endif
+#   include <windows.h>
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -467,6 +481,113 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, const String& path)
+        : MemoryDataStream(name, NULL, 0, false, true), mMapping(NULL)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        mapFile(::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL), path);
+#elif OGRE_PLATFORM == OGRE_PLATFORM_WINRT
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        // no file mapping available, so read it all
+        file.seekg(0, std::ios::end);
+        mSize = static_cast<size_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+        if (mSize > 0)
+        {
+            mData = OGRE_ALLOC_T(uchar, mSize, MEMCATEGORY_GENERAL);
+            mFreeOnClose = true;
+            if (!file.read(reinterpret_cast<char*>(mData), mSize))
+                mSize = 0;
+        }
+        mPos = mData;
+        mEnd = mData + mSize;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        struct stat tagStat;
+        if (::fstat(fd, &tagStat) == 0 && tagStat.st_size > 0)
+        {
+            mSize = static_cast<size_t>(tagStat.st_size);
+            void* data = ::mmap(NULL, mSize, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED)
+                mData = static_cast<uchar*>(data);
+        }
+        // the mapping stays valid after closing the descriptor
+        ::close(fd);
+
+        if (mSize > 0 && !mData)
+        {
+            close();
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot map file: " + path);
+        }
+        mPos = mData;
+        mEnd = mData + mSize;
+#endif
+    }
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::MappedFileDataStream(const String& name, const std::wstring& path)
+        : MemoryDataStream(name, NULL, 0, false, true), mMapping(NULL)
+    {
+        mapFile(::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL), name);
+    }
+    //-----------------------------------------------------------------------
+    void MappedFileDataStream::mapFile(void* handle, const String& path)
+    {
+        HANDLE file = static_cast<HANDLE>(handle);
+        if (file == INVALID_HANDLE_VALUE)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        LARGE_INTEGER fileSize;
+        if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            mSize = static_cast<size_t>(fileSize.QuadPart);
+            mMapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mMapping)
+                mData = static_cast<uchar*>(::MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        ::CloseHandle(file);
+
+        if (mSize > 0 && !mData)
+        {
+            close();
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot map file: " + path);
+        }
+        mPos = mData;
+        mEnd = mData + mSize;
+    }
+#endif
+    //-----------------------------------------------------------------------
+    MappedFileDataStream::~MappedFileDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MappedFileDataStream::close(void)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        if (mData)
+            ::UnmapViewOfFile(mData);
+        if (mMapping)
+            ::CloseHandle(mMapping);
+        mData = 0;
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+        if (mData)
+            ::munmap(mData, mSize);
+        mData = 0;
+#endif
+        mMapping = NULL;
+        MemoryDataStream::close();
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
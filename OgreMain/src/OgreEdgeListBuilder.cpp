@@ -29,9 +29,93 @@ THE SOFTWARE.
 #include "OgreEdgeListBuilder.h"
 #include "OgreVertexIndexData.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
+    namespace
+    {
+        const size_t NO_INDEX = ~size_t(0);
+        /// Connect the edges of big meshes in parallel
+        const size_t PARALLEL_HALF_EDGE_COUNT = 3 * 16384;
+
+        /// One side of a triangle edge, used to connect edges
+        struct HalfEdge
+        {
+            size_t sharedVertIndex[2]; /// The common vertices of the edge, the smaller one first
+            size_t id;                 /// Triangle index * 3 + edge index within the triangle
+            bool reversed;             /// Whether the triangle walks the edge from the bigger vertex
+        };
+        typedef std::vector<HalfEdge> HalfEdgeList;
+
+        size_t hashPosition(const Vector3& vec)
+        {
+            // adding 0 turns -0 into 0, as they are the same position
+            Vector3 pos(vec.x + 0, vec.y + 0, vec.z + 0);
+            return FastHash(reinterpret_cast<const char*>(pos.ptr()), sizeof(Vector3));
+        }
+
+        size_t hashEdge(size_t sharedVertIndex0, size_t sharedVertIndex1)
+        {
+            size_t hash = sharedVertIndex0 * 2654435761u + sharedVertIndex1;
+            return hash ^ (hash >> 16);
+        }
+
+        bool halfEdgeLess(const HalfEdge& a, const HalfEdge& b)
+        {
+            if (a.sharedVertIndex[0] != b.sharedVertIndex[0])
+                return a.sharedVertIndex[0] < b.sharedVertIndex[0];
+            if (a.sharedVertIndex[1] != b.sharedVertIndex[1])
+                return a.sharedVertIndex[1] < b.sharedVertIndex[1];
+            return a.id < b.id;
+        }
+
+        /** Connects the half edges in [begin, end), which must be in triangle order for every edge.
+        @param connectedTo For each half edge the half edge it connects to, or NO_INDEX if it starts
+            a new edge
+        @return The number of edges, which are connected on one side only
+        */
+        size_t connectHalfEdges(HalfEdge* begin, HalfEdge* end,
+                                std::vector<size_t>& connectedTo)
+        {
+            std::sort(begin, end, halfEdgeLess);
+
+            size_t openCount = 0;
+            // unconnected half edges of the current edge in both directions, oldest first
+            std::vector<size_t> open[2];
+            for (HalfEdge* run = begin; run != end;)
+            {
+                HalfEdge* runEnd = run + 1;
+                while (runEnd != end && runEnd->sharedVertIndex[0] == run->sharedVertIndex[0] &&
+                       runEnd->sharedVertIndex[1] == run->sharedVertIndex[1])
+                {
+                    ++runEnd;
+                }
+
+                open[0].clear();
+                open[1].clear();
+                size_t oldest[2] = {0, 0};
+                for (HalfEdge* h = run; h != runEnd; ++h)
+                {
+                    int other = h->reversed ? 0 : 1;
+                    if (oldest[other] < open[other].size())
+                    {
+                        connectedTo[h->id] = open[other][oldest[other]++];
+                    }
+                    else
+                    {
+                        connectedTo[h->id] = NO_INDEX;
+                        open[1 - other].push_back(h->id);
+                    }
+                }
+                openCount += open[0].size() - oldest[0] + open[1].size() - oldest[1];
+                run = runEnd;
+            }
+            return openCount;
+        }
+    }
+
     EdgeData::EdgeData() : isClosed(false){}
     
     void EdgeData::log(Log* l)
@@ -125,11 +209,17 @@ namespace Ogre {
               End If
               Populate the original vertex index and common vertex index 
             Next vertex
-            Connect to existing edge(v1, v0) or create a new edge(v0, v1)
-            Connect to existing edge(v2, v1) or create a new edge(v1, v2)
-            Connect to existing edge(v0, v2) or create a new edge(v2, v0)
           Next set of 3 indexes
         Next index set
+        For each triangle in turn
+          Connect to existing edge(v1, v0) or create a new edge(v0, v1)
+          Connect to existing edge(v2, v1) or create a new edge(v1, v2)
+          Connect to existing edge(v0, v2) or create a new edge(v2, v0)
+        Next triangle
+
+        The edges are connected by sorting the sides of all triangles by their common
+        vertices, so each edge can be connected independently of the others. This is
+        done in parallel for big meshes.
 
         Note that all edges 'belong' to the index set which originally caused them
         to be created, which also means that the 2 vertices on the edge are both referencing the 
@@ -181,24 +271,38 @@ namespace Ogre {
             mEdgeData->edgeGroups[vSet].triCount = 0;
         }
 
-        // Build triangles and edge list
+        // Size the common vertex table for a load factor of at most 0.5
+        size_t vertexCount = 0;
+        for (size_t vSet = 0; vSet < mVertexDataList.size(); ++vSet)
+        {
+            vertexCount += mVertexDataList[vSet]->vertexCount;
+        }
+        size_t tableSize = 16;
+        while (tableSize < 2 * vertexCount)
+        {
+            tableSize *= 2;
+        }
+        mCommonVertexTable.assign(tableSize, NO_INDEX);
+        mVertices.reserve(vertexCount);
+
+        // Build triangles
         GeometryList::const_iterator i, iend;
         iend = mGeometryList.end();
         for (i = mGeometryList.begin(); i != iend; ++i)
         {
-            buildTrianglesEdges(*i);
+            buildTriangles(*i);
         }
 
+        // Build edge list, this records closed, ie the mesh is manifold
+        buildEdges();
+
         // Allocate memory for light facing calculate
         mEdgeData->triangleLightFacings.resize(mEdgeData->triangles.size());
 
-        // Record closed, ie the mesh is manifold
-        mEdgeData->isClosed = mEdgeMap.empty();
-
         return mEdgeData;
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::buildTrianglesEdges(const Geometry &geometry)
+    void EdgeListBuilder::buildTriangles(const Geometry &geometry)
     {
         size_t indexSet = geometry.indexSet;
         size_t vertexSet = geometry.vertexSet;
@@ -321,16 +425,6 @@ namespace Ogre {
                     Math::calculateFaceNormalWithoutNormalize(v[0], v[1], v[2]));
                 // Add triangle to list
                 mEdgeData->triangles.push_back(tri);
-                // Connect or create edges from common list
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[0], tri.vertIndex[1], 
-                    tri.sharedVertIndex[0], tri.sharedVertIndex[1]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[1], tri.vertIndex[2], 
-                    tri.sharedVertIndex[1], tri.sharedVertIndex[2]);
-                connectOrCreateEdge(vertexSet, triangleIndex, 
-                    tri.vertIndex[2], tri.vertIndex[0], 
-                    tri.sharedVertIndex[2], tri.sharedVertIndex[0]);
                 ++triangleIndex;
             }
         }
@@ -340,40 +434,125 @@ namespace Ogre {
         eg.triCount = triangleIndex - eg.triStart;
     }
     //---------------------------------------------------------------------
-    void EdgeListBuilder::connectOrCreateEdge(size_t vertexSet, size_t triangleIndex, 
-        size_t vertIndex0, size_t vertIndex1, size_t sharedVertIndex0, 
-        size_t sharedVertIndex1)
+    void EdgeListBuilder::buildEdges(void)
     {
-        // Find the existing edge (should be reversed order) on shared vertices
-        EdgeMap::iterator emi = mEdgeMap.find(std::pair<size_t, size_t>(sharedVertIndex1, sharedVertIndex0));
-        if (emi != mEdgeMap.end())
-        {
-            // The edge already exist, connect it
-            EdgeData::Edge& e = mEdgeData->edgeGroups[emi->second.first].edges[emi->second.second];
-            // update with second side
-            e.triIndex[1] = triangleIndex;
-            e.degenerate = false;
-
-            // Remove from the edge map, so we never supplied to connect edge again
-            mEdgeMap.erase(emi);
+        const EdgeData::TriangleList& triangles = mEdgeData->triangles;
+        size_t halfEdgeCount = triangles.size() * 3;
+
+        WorkQueue* workQueue = NULL;
+        size_t bucketCount = 1;
+        if (halfEdgeCount >= PARALLEL_HALF_EDGE_COUNT && Root::getSingletonPtr())
+        {
+            workQueue = Root::getSingleton().getWorkQueue();
+            bucketCount = 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+        }
+
+        // Distribute the half edges to buckets by their edge, keeping them in triangle order
+        std::vector<size_t> bucketStart(bucketCount + 1, 0);
+        for (size_t t = 0; t < triangles.size(); ++t)
+        {
+            const EdgeData::Triangle& tri = triangles[t];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                size_t v0 = tri.sharedVertIndex[k];
+                size_t v1 = tri.sharedVertIndex[(k + 1) % 3];
+                ++bucketStart[hashEdge(std::min(v0, v1), std::max(v0, v1)) % bucketCount + 1];
+            }
+        }
+        for (size_t b = 0; b < bucketCount; ++b)
+        {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        HalfEdgeList halfEdges(halfEdgeCount);
+        std::vector<size_t> bucketEnd(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t t = 0; t < triangles.size(); ++t)
+        {
+            const EdgeData::Triangle& tri = triangles[t];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                HalfEdge h;
+                size_t v0 = tri.sharedVertIndex[k];
+                size_t v1 = tri.sharedVertIndex[(k + 1) % 3];
+                h.sharedVertIndex[0] = std::min(v0, v1);
+                h.sharedVertIndex[1] = std::max(v0, v1);
+                h.id = t * 3 + k;
+                h.reversed = v0 > v1;
+                halfEdges[bucketEnd[hashEdge(h.sharedVertIndex[0], h.sharedVertIndex[1]) % bucketCount]++] = h;
+            }
+        }
+
+        // Connect the half edges of each bucket
+        std::vector<size_t> connectedTo(halfEdgeCount);
+        std::vector<size_t> openCount(bucketCount);
+        auto connectBucket = [&](size_t b)
+        {
+            openCount[b] = connectHalfEdges(halfEdges.data() + bucketStart[b],
+                                            halfEdges.data() + bucketStart[b + 1], connectedTo);
+        };
+        if (workQueue)
+        {
+            workQueue->parallelFor(bucketCount, connectBucket);
         }
         else
         {
-            // Not found, create new edge
-            mEdgeMap.emplace(std::pair<size_t, size_t>(sharedVertIndex0, sharedVertIndex1),
-                             std::pair<size_t, size_t>(vertexSet, mEdgeData->edgeGroups[vertexSet].edges.size()));
-            EdgeData::Edge e;
-            e.degenerate = true; // initialise as degenerate
-
-            // Set only first tri, the other will be completed in connect existing edge
-            e.triIndex[0] = triangleIndex;
-            e.triIndex[1] = static_cast<size_t>(~0);
-            e.sharedVertIndex[0] = sharedVertIndex0;
-            e.sharedVertIndex[1] = sharedVertIndex1;
-            e.vertIndex[0] = vertIndex0;
-            e.vertIndex[1] = vertIndex1;
-            mEdgeData->edgeGroups[vertexSet].edges.push_back(e);
+            connectBucket(0);
+        }
+        HalfEdgeList().swap(halfEdges); // Free memory
+
+        // Create the edges in triangle order, so every edge group lists its edges in
+        // the order the triangles created them
+        std::vector<size_t> edgeCount(mEdgeData->edgeGroups.size(), 0);
+        for (size_t id = 0; id < halfEdgeCount; ++id)
+        {
+            if (connectedTo[id] == NO_INDEX)
+                ++edgeCount[triangles[id / 3].vertexSet];
         }
+        for (size_t vSet = 0; vSet < edgeCount.size(); ++vSet)
+        {
+            mEdgeData->edgeGroups[vSet].edges.reserve(edgeCount[vSet]);
+        }
+        for (size_t id = 0; id < halfEdgeCount; ++id)
+        {
+            size_t triangleIndex = id / 3;
+            const EdgeData::Triangle& tri = triangles[triangleIndex];
+            if (connectedTo[id] == NO_INDEX)
+            {
+                // Not connected, create new edge
+                EdgeData::EdgeList& edges = mEdgeData->edgeGroups[tri.vertexSet].edges;
+                size_t k = id % 3;
+                EdgeData::Edge e;
+                e.degenerate = true; // initialise as degenerate
+
+                // Set only first tri, the other will be completed by the connected half edge
+                e.triIndex[0] = triangleIndex;
+                e.triIndex[1] = static_cast<size_t>(~0);
+                e.sharedVertIndex[0] = tri.sharedVertIndex[k];
+                e.sharedVertIndex[1] = tri.sharedVertIndex[(k + 1) % 3];
+                e.vertIndex[0] = tri.vertIndex[k];
+                e.vertIndex[1] = tri.vertIndex[(k + 1) % 3];
+                // the half edge is done, remember its edge for the one connecting to it
+                connectedTo[id] = edges.size();
+                edges.push_back(e);
+            }
+            else
+            {
+                // The edge already exist, connect it. It was created by an earlier half edge.
+                size_t other = connectedTo[id];
+                EdgeData::Edge& e =
+                    mEdgeData->edgeGroups[triangles[other / 3].vertexSet].edges[connectedTo[other]];
+                // update with second side
+                e.triIndex[1] = triangleIndex;
+                e.degenerate = false;
+            }
+        }
+
+        // Record closed, ie the mesh is manifold
+        size_t totalOpenCount = 0;
+        for (size_t b = 0; b < bucketCount; ++b)
+        {
+            totalOpenCount += openCount[b];
+        }
+        mEdgeData->isClosed = totalOpenCount == 0;
     }
     //---------------------------------------------------------------------
     size_t EdgeListBuilder::findOrCreateCommonVertex(const Vector3& vec, 
@@ -382,13 +561,33 @@ namespace Ogre {
         // Because the algorithm doesn't care about manifold or not, we just identifying
         // the common vertex by EXACT same position.
         // Hint: We can use quantize method for welding almost same position vertex fastest.
-        std::pair<CommonVertexMap::iterator, bool> inserted = mCommonVertexMap.emplace(vec, mVertices.size());
-        if (!inserted.second)
+        if (2 * mVertices.size() >= mCommonVertexTable.size())
+        {
+            // More vertices than expected, rehash with twice the size
+            mCommonVertexTable.assign(std::max<size_t>(16, 2 * mCommonVertexTable.size()), NO_INDEX);
+            size_t mask = mCommonVertexTable.size() - 1;
+            for (size_t v = 0; v < mVertices.size(); ++v)
+            {
+                size_t slot = hashPosition(mVertices[v].position) & mask;
+                while (mCommonVertexTable[slot] != NO_INDEX)
+                    slot = (slot + 1) & mask;
+                mCommonVertexTable[slot] = v;
+            }
+        }
+
+        size_t mask = mCommonVertexTable.size() - 1;
+        size_t slot = hashPosition(vec) & mask;
+        for (; mCommonVertexTable[slot] != NO_INDEX; slot = (slot + 1) & mask)
         {
-            // Already existing, return old one
-            return inserted.first->second;
+            size_t index = mCommonVertexTable[slot];
+            if (mVertices[index].position == vec)
+            {
+                // Already existing, return old one
+                return index;
+            }
         }
         // Not found, insert
+        mCommonVertexTable[slot] = mVertices.size();
         CommonVertex newCommon;
         newCommon.index = mVertices.size();
         newCommon.position = vec;
@@ -116,6 +116,7 @@ namespace {
     };
 
     bool gIgnoreHidden = true;
+    size_t gMemoryMapThreshold = 1024 * 1024;
 }
 
     //-----------------------------------------------------------------------
@@ -354,6 +355,16 @@ namespace {
 #endif
         size_t st_size = ret == 0 ? tagStat.st_size : 0;
 
+        // large files are mapped, so they can be used in place without copying
+        if (!(mode & std::ios::out) && ret == 0 && st_size >= gMemoryMapThreshold)
+        {
+#ifndef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
+            return DataStreamPtr(OGRE_NEW MappedFileDataStream(name.empty() ? full_path : name, full_path));
+#elif OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            return DataStreamPtr(OGRE_NEW MappedFileDataStream(name.empty() ? full_path : name, to_wpath(full_path)));
+#endif
+        }
+
         std::istream* baseStream = 0;
         std::ifstream* roStream = 0;
         std::fstream* rwStream = 0;
@@ -573,4 +584,14 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setMemoryMapThreshold(size_t bytes)
+    {
+        gMemoryMapThreshold = bytes;
+    }
+
+    size_t FileSystemArchiveFactory::getMemoryMapThreshold()
+    {
+        return gMemoryMapThreshold;
+    }
 }
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreMovablePlane.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre {
 
@@ -248,6 +249,42 @@ namespace Ogre {
         return true;
     }
 
+    //-----------------------------------------------------------------------
+    uint32 Frustum::isVisible(const AxisAlignedBoxBatch& boxes) const
+    {
+        uint32 visibility = 0;
+        for (size_t i = 0; i < boxes.size; ++i)
+        {
+            if (isVisible(boxes.get(i)))
+                visibility |= 1u << i;
+        }
+        return visibility;
+    }
+    //-----------------------------------------------------------------------
+    uint32 Frustum::isVisibleBatched(const AxisAlignedBoxBatch& boxes) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        const Plane* planes = mFrustumPlanes;
+        size_t numPlanes = 6;
+
+        Plane finitePlanes[5];
+        if (mFarDist == 0)
+        {
+            // Skip far plane if infinite view frustum
+            finitePlanes[0] = mFrustumPlanes[FRUSTUM_PLANE_NEAR];
+            std::copy(mFrustumPlanes + FRUSTUM_PLANE_LEFT, mFrustumPlanes + 6, finitePlanes + 1);
+            planes = finitePlanes;
+            numPlanes = 5;
+        }
+
+        uint32 visibility = 0;
+        OptimisedUtil::getImplementation()->calculateBoxVisibility(
+            planes, numPlanes, boxes.data[0], AxisAlignedBoxBatch::CAPACITY, boxes.size, &visibility);
+        return visibility;
+    }
+
     //-----------------------------------------------------------------------
     bool Frustum::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
     {
@@ -781,6 +781,8 @@ namespace Ogre
             {
                 const float* pSrc = sharedParams->getFloatPointer(e.srcDefinition->physicalIndex);
                 float* pDst = mParams->getFloatPointer(e.dstDefinition->physicalIndex);
+                mParams->_markDirtyFloatRange(e.dstDefinition->physicalIndex,
+                                              e.dstDefinition->elementSize * e.dstDefinition->arraySize);
 
                 // Deal with matrix transposition here!!!
                 // transposition is specific to the dest param set, shared params don't do it
@@ -933,6 +935,9 @@ namespace Ogre
         , mTransposeMatrices(false)
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
+        , mAutoParamSourceId(0)
+        , mDirtyFloatBegin(std::numeric_limits<size_t>::max())
+        , mDirtyFloatEnd(0)
     {
     }
     GpuProgramParameters::~GpuProgramParameters() {}
@@ -963,6 +968,10 @@ namespace Ogre
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
+        // the generations of the copied autos refer to another object
+        mAutoParamSourceId = 0;
+        _clearDirtyFloatRange();
+        _markDirtyFloatRange(0, mFloatConstants.size());
 
         return *this;
     }
@@ -1275,6 +1284,7 @@ namespace Ogre
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const double* val, size_t count)
     {
         assert(physicalIndex + count <= mFloatConstants.size());
+        _markDirtyFloatRange(physicalIndex, count);
         for (size_t i = 0; i < count; ++i)
         {
             mFloatConstants[physicalIndex+i] = static_cast<float>(val[i]);
@@ -1284,6 +1294,7 @@ namespace Ogre
     void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const float* val, size_t count)
     {
         assert(physicalIndex + count <= mFloatConstants.size());
+        _markDirtyFloatRange(physicalIndex, count);
         memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
     }
     //-----------------------------------------------------------------------------
@@ -1601,6 +1612,7 @@ namespace Ogre
                     if (ac.physicalIndex > physicalIndex && def && isElementType<T>(def->elementType))
                     {
                         ac.physicalIndex += insertCount;
+                        ac.generation = 0;
                     }
                 }
                 if (mNamedConstants)
@@ -1807,6 +1819,7 @@ namespace Ogre
                 i->data = extraInfo;
                 i->elementCount = elementSize;
                 i->variability = variability;
+                i->generation = 0;
                 found = true;
                 break;
             }
@@ -1857,6 +1870,7 @@ namespace Ogre
                 i->fData = rData;
                 i->elementCount = elementSize;
                 i->variability = variability;
+                i->generation = 0;
                 found = true;
                 break;
             }
@@ -1939,6 +1953,36 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------------
 
+    //-----------------------------------------------------------------------------
+    /// whether the value depends on the current pass, which AutoParamDataSource::getGeneration does not track
+    static bool isPassDependent(GpuProgramParameters::AutoConstantType type)
+    {
+        switch (type)
+        {
+        case GpuProgramParameters::ACT_SURFACE_AMBIENT_COLOUR:
+        case GpuProgramParameters::ACT_SURFACE_DIFFUSE_COLOUR:
+        case GpuProgramParameters::ACT_SURFACE_SPECULAR_COLOUR:
+        case GpuProgramParameters::ACT_SURFACE_EMISSIVE_COLOUR:
+        case GpuProgramParameters::ACT_SURFACE_SHININESS:
+        case GpuProgramParameters::ACT_SURFACE_ALPHA_REJECTION_VALUE:
+        case GpuProgramParameters::ACT_DERIVED_AMBIENT_LIGHT_COLOUR:
+        case GpuProgramParameters::ACT_DERIVED_SCENE_COLOUR:
+        case GpuProgramParameters::ACT_DERIVED_LIGHT_DIFFUSE_COLOUR:
+        case GpuProgramParameters::ACT_DERIVED_LIGHT_SPECULAR_COLOUR:
+        case GpuProgramParameters::ACT_DERIVED_LIGHT_DIFFUSE_COLOUR_ARRAY:
+        case GpuProgramParameters::ACT_DERIVED_LIGHT_SPECULAR_COLOUR_ARRAY:
+        case GpuProgramParameters::ACT_TEXTURE_SIZE:
+        case GpuProgramParameters::ACT_INVERSE_TEXTURE_SIZE:
+        case GpuProgramParameters::ACT_PACKED_TEXTURE_SIZE:
+        case GpuProgramParameters::ACT_TEXTURE_MATRIX:
+        case GpuProgramParameters::ACT_PASS_NUMBER:
+        case GpuProgramParameters::ACT_PASS_ITERATION_NUMBER:
+        case GpuProgramParameters::ACT_VERTEX_WINDING:
+            return true;
+        default:
+            return false;
+        }
+    }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
     {
@@ -1960,12 +2004,22 @@ namespace Ogre
 
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
+        // the generations only compare to the source they were taken from
+        if (source->getSourceId() != mAutoParamSourceId)
+        {
+            for (AutoConstantList::iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+                i->generation = 0;
+            mAutoParamSourceId = source->getSourceId();
+        }
+
         // Autoconstant index is not a physical index
-        for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+        for (AutoConstantList::iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
         {
-            // Only update needed slots
-            if (i->variability & mask)
+            // Only update needed slots, which changed since they were written
+            if ((i->variability & mask) && i->generation != source->getGeneration(i->variability))
             {
+                if (!isPassDependent(i->paramType))
+                    i->generation = source->getGeneration(i->variability);
 
                 switch(i->paramType)
                 {
@@ -2965,11 +3019,14 @@ namespace Ogre
         mIntConstants = source.getIntConstantList();
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
+        mAutoParamSourceId = 0;
         copySharedParamSetUsage(source.mSharedParamSets);
     }
     //---------------------------------------------------------------------
     void GpuProgramParameters::copyMatchingNamedConstantsFrom(const GpuProgramParameters& source)
     {
+        // the copied values overwrite autos, which have to be written again
+        mAutoParamSourceId = 0;
         if (mNamedConstants && source.mNamedConstants)
         {
             std::map<size_t, String> srcToDestNamedMap;
@@ -3107,6 +3164,7 @@ namespace Ogre
         {
             // This is a physical index
             ++mFloatConstants[mActivePassIterationIndex];
+            _markDirtyFloatRange(mActivePassIterationIndex, 1);
         }
     }
     //---------------------------------------------------------------------
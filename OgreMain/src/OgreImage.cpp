@@ -519,6 +519,7 @@ namespace Ogre {
         assert(PixelUtil::isAccessible(scaled.format));
         MemoryDataStreamPtr buf; // For auto-delete
         PixelBox temp;
+        ResampleFunc resampler = NULL;
         switch (filter) 
         {
         default:
@@ -538,23 +539,18 @@ namespace Ogre {
             // super-optimized: no conversion
             switch (PixelUtil::getNumElemBytes(src.format)) 
             {
-            case 1: NearestResampler<1>::scale(src, temp); break;
-            case 2: NearestResampler<2>::scale(src, temp); break;
-            case 3: NearestResampler<3>::scale(src, temp); break;
-            case 4: NearestResampler<4>::scale(src, temp); break;
-            case 6: NearestResampler<6>::scale(src, temp); break;
-            case 8: NearestResampler<8>::scale(src, temp); break;
-            case 12: NearestResampler<12>::scale(src, temp); break;
-            case 16: NearestResampler<16>::scale(src, temp); break;
+            case 1: resampler = NearestResampler<1>::scale; break;
+            case 2: resampler = NearestResampler<2>::scale; break;
+            case 3: resampler = NearestResampler<3>::scale; break;
+            case 4: resampler = NearestResampler<4>::scale; break;
+            case 6: resampler = NearestResampler<6>::scale; break;
+            case 8: resampler = NearestResampler<8>::scale; break;
+            case 12: resampler = NearestResampler<12>::scale; break;
+            case 16: resampler = NearestResampler<16>::scale; break;
             default:
                 // never reached
                 assert(false);
             }
-            if(temp.data != scaled.data)
-            {
-                // Blit temp buffer
-                PixelUtil::bulkPixelConversion(temp, scaled);
-            }
             break;
 
         case FILTER_LINEAR:
@@ -581,34 +577,69 @@ namespace Ogre {
                 // super-optimized: byte-oriented math, no conversion
                 switch (PixelUtil::getNumElemBytes(src.format)) 
                 {
-                case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-                case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-                case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-                case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+                case 1: resampler = LinearResampler_Byte<1>::scale; break;
+                case 2: resampler = LinearResampler_Byte<2>::scale; break;
+                case 3: resampler = LinearResampler_Byte<3>::scale; break;
+                case 4: resampler = LinearResampler_Byte<4>::scale; break;
                 default:
                     // never reached
                     assert(false);
                 }
-                if(temp.data != scaled.data)
-                {
-                    // Blit temp buffer
-                    PixelUtil::bulkPixelConversion(temp, scaled);
-                }
                 break;
             case PF_FLOAT32_RGB:
             case PF_FLOAT32_RGBA:
                 if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
                 {
                     // float32 to float32, avoid unpack/repack overhead
-                    LinearResampler_Float32::scale(src, scaled);
+                    temp = scaled;
+                    resampler = LinearResampler_Float32::scale;
                     break;
                 }
                 // else, fall through
             default:
                 // non-optimized: floating-point math, performs conversion but always works
-                LinearResampler::scale(src, scaled);
+                temp = scaled;
+                resampler = LinearResampler::scale;
             }
             break;
+
+        case FILTER_BOX:
+        case FILTER_TRIANGLE:
+        case FILTER_BICUBIC:
+        case FILTER_LANCZOS:
+            switch (src.format)
+            {
+            case PF_L8: case PF_R8: case PF_A8: case PF_BYTE_LA:
+            case PF_R8G8B8: case PF_B8G8R8:
+            case PF_R8G8B8A8: case PF_B8G8R8A8:
+            case PF_A8B8G8R8: case PF_A8R8G8B8:
+            case PF_X8B8G8R8: case PF_X8R8G8B8:
+                if (src.format == scaled.format)
+                {
+                    // byte channels filtered as they are, no conversion
+                    FilterResampler::scale(src, scaled, filter, PixelUtil::getNumElemBytes(src.format));
+                    return;
+                }
+                // else, fall through
+            default:
+                // floating-point math, performs conversion
+                FilterResampler::scale(src, scaled, filter, 0);
+                return;
+            }
+        }
+
+        if (resampler)
+        {
+            resampleRows(temp.getHeight() * temp.getDepth(), temp.getWidth(),
+                         [resampler, &src, &temp](size_t rowBegin, size_t rowEnd) {
+                             resampler(src, temp, rowBegin, rowEnd);
+                         });
+        }
+
+        if(temp.data != scaled.data)
+        {
+            // Blit temp buffer
+            PixelUtil::bulkPixelConversion(temp, scaled);
         }
     }
 
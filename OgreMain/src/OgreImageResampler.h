@@ -30,6 +30,14 @@ THE SOFTWARE.
 
 #include <algorithm>
 
+// SSE2 is part of x86-64, but 32 bit builds are only compiled with -msse
+#if __OGRE_HAVE_SSE && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define OGRE_RESAMPLER_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define OGRE_RESAMPLER_SSE2 0
+#endif
+
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
 namespace Ogre {
@@ -47,17 +55,44 @@ namespace Ogre {
 // sx2 = upper-bound integer x-position in source
 // sxf = fractional weight between sx1 and sx2
 // x,y,z = location of output pixel in destination
+// row = y + z * dst.getHeight(), the unit of work of the resamplers
+
+// resamplers process the destination rows [rowBegin, rowEnd) only, so the
+// rows of a large image can be split between threads with identical results
+typedef void (*ResampleFunc)(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd);
+
+// calls func(rowBegin, rowEnd) for all rows, using the WorkQueue threads
+// if there are enough pixels to be worth it
+inline void resampleRows(size_t rows, size_t pixelsPerRow,
+                         const std::function<void(size_t, size_t)>& func)
+{
+    // below this, the synchronisation costs more than it saves
+    const size_t minParallelPixels = 128 * 128;
+
+    WorkQueue* queue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+    if (!queue || rows < 2 || rows * pixelsPerRow < minParallelPixels)
+    {
+        func(0, rows);
+        return;
+    }
+
+    // a few ranges per thread, so uneven progress still balances out
+    size_t numItems = std::min(rows, 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY));
+    queue->parallelFor(numItems, [rows, numItems, &func](size_t item) {
+        func(rows * item / numItems, rows * (item + 1) / numItems);
+    });
+}
 
 // nearest-neighbor resampler, does not convert formats.
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         // assert(src.format == dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -65,26 +100,25 @@ template<unsigned int elemsize> struct NearestResampler {
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
 
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
+        for (size_t row = rowBegin; row < rowEnd; row++) {
+            size_t y = row % dst.getHeight();
+            size_t z = row / dst.getHeight();
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint64 sz_48 = (stepz >> 1) - 1 + z * stepz;
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
             size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
-            
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
-                size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
-            
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48 += stepx) {
-                    uchar* psrc = srcdata +
-                        elemsize*((size_t)(sx_48 >> 48) + srcyoff + srczoff);
-                    memcpy(pdst, psrc, elemsize);
-                    pdst += elemsize;
-                }
-                pdst += elemsize*dst.getRowSkip();
+            size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
+            uchar* pdst = dstdata + elemsize*(y * dst.rowPitch + z * dst.slicePitch);
+
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = 0; x < dst.getWidth(); x++, sx_48 += stepx) {
+                uchar* psrc = srcdata +
+                    elemsize*((size_t)(sx_48 >> 48) + srcyoff + srczoff);
+                memcpy(pdst, psrc, elemsize);
+                pdst += elemsize;
             }
-            pdst += elemsize*dst.getSliceSkip();
         }
     }
 };
@@ -92,24 +126,29 @@ template<unsigned int elemsize> struct NearestResampler {
 
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
         size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
-        
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
+
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
-        
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
+
+        for (size_t row = rowBegin; row < rowEnd; row++) {
+            size_t y = row % dst.getHeight();
+            size_t z = row / dst.getHeight();
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint64 sz_48 = (stepz >> 1) - 1 + z * stepz;
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
+
             // temp is 16/16 bit fixed precision, used to adjust a source
             // coordinate (x, y, or z) backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -121,51 +160,48 @@ struct LinearResampler {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
-                temp = static_cast<unsigned int>(sy_48 >> 32);
+            temp = static_cast<unsigned int>(sy_48 >> 32);
+            temp = (temp > 0x8000)? temp - 0x8000 : 0;
+            uint32 sy1 = temp >> 16;                    // src y #1
+            uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
+            float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
+
+            uchar* pdst = dstdata + dstelemsize*(y * dst.rowPitch + z * dst.slicePitch);
+
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = 0; x < dst.getWidth(); x++, sx_48+=stepx) {
+                temp = static_cast<unsigned int>(sx_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                uint32 sy1 = temp >> 16;                    // src y #1
-                uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
-                float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                    temp = static_cast<unsigned int>(sx_48 >> 32);
-                    temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                    uint32 sx1 = temp >> 16;                    // src x #1
-                    uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
-                    float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
-                    ColourValue x1y1z1, x2y1z1, x1y2z1, x2y2z1;
-                    ColourValue x1y1z2, x2y1z2, x1y2z2, x2y2z2;
+                uint32 sx1 = temp >> 16;                    // src x #1
+                uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
+                float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
+
+                ColourValue x1y1z1, x2y1z1, x1y2z1, x2y2z1;
+                ColourValue x1y1z2, x2y1z2, x1y2z2, x2y2z2;
 
 #define UNPACK(dst,x,y,z) PixelUtil::unpackColour(&dst, src.format, \
     srcdata + srcelemsize*((x)+(y)*src.rowPitch+(z)*src.slicePitch))
 
-                    UNPACK(x1y1z1,sx1,sy1,sz1); UNPACK(x2y1z1,sx2,sy1,sz1);
-                    UNPACK(x1y2z1,sx1,sy2,sz1); UNPACK(x2y2z1,sx2,sy2,sz1);
-                    UNPACK(x1y1z2,sx1,sy1,sz2); UNPACK(x2y1z2,sx2,sy1,sz2);
-                    UNPACK(x1y2z2,sx1,sy2,sz2); UNPACK(x2y2z2,sx2,sy2,sz2);
+                UNPACK(x1y1z1,sx1,sy1,sz1); UNPACK(x2y1z1,sx2,sy1,sz1);
+                UNPACK(x1y2z1,sx1,sy2,sz1); UNPACK(x2y2z1,sx2,sy2,sz1);
+                UNPACK(x1y1z2,sx1,sy1,sz2); UNPACK(x2y1z2,sx2,sy1,sz2);
+                UNPACK(x1y2z2,sx1,sy2,sz2); UNPACK(x2y2z2,sx2,sy2,sz2);
 #undef UNPACK
 
-                    ColourValue accum =
-                        x1y1z1 * ((1.0f - sxf)*(1.0f - syf)*(1.0f - szf)) +
-                        x2y1z1 * (        sxf *(1.0f - syf)*(1.0f - szf)) +
-                        x1y2z1 * ((1.0f - sxf)*        syf *(1.0f - szf)) +
-                        x2y2z1 * (        sxf *        syf *(1.0f - szf)) +
-                        x1y1z2 * ((1.0f - sxf)*(1.0f - syf)*        szf ) +
-                        x2y1z2 * (        sxf *(1.0f - syf)*        szf ) +
-                        x1y2z2 * ((1.0f - sxf)*        syf *        szf ) +
-                        x2y2z2 * (        sxf *        syf *        szf );
+                ColourValue accum =
+                    x1y1z1 * ((1.0f - sxf)*(1.0f - syf)*(1.0f - szf)) +
+                    x2y1z1 * (        sxf *(1.0f - syf)*(1.0f - szf)) +
+                    x1y2z1 * ((1.0f - sxf)*        syf *(1.0f - szf)) +
+                    x2y2z1 * (        sxf *        syf *(1.0f - szf)) +
+                    x1y1z2 * ((1.0f - sxf)*(1.0f - syf)*        szf ) +
+                    x2y1z2 * (        sxf *(1.0f - syf)*        szf ) +
+                    x1y2z2 * ((1.0f - sxf)*        syf *        szf ) +
+                    x2y2z2 * (        sxf *        syf *        szf );
 
-                    PixelUtil::packColour(accum, dst.format, pdst);
+                PixelUtil::packColour(accum, dst.format, pdst);
 
-                    pdst += dstelemsize;
-                }
-                pdst += dstelemsize*dst.getRowSkip();
+                pdst += dstelemsize;
             }
-            pdst += dstelemsize*dst.getSliceSkip();
         }
     }
 };
@@ -174,26 +210,31 @@ struct LinearResampler {
 // float32 linear resampler, converts FLOAT32_RGB/FLOAT32_RGBA only.
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
         size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
         // assert(srcchannels == 3 || srcchannels == 4);
         // assert(dstchannels == 3 || dstchannels == 4);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         float* srcdata = (float*)src.getTopLeftFrontPixelPtr();
-        float* pdst = (float*)dst.getTopLeftFrontPixelPtr();
-        
+        float* dstdata = (float*)dst.getTopLeftFrontPixelPtr();
+
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
-        
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
+
+        for (size_t row = rowBegin; row < rowEnd; row++) {
+            size_t y = row % dst.getHeight();
+            size_t z = row / dst.getHeight();
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint64 sz_48 = (stepz >> 1) - 1 + z * stepz;
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
+
             // temp is 16/16 bit fixed precision, used to adjust a source
             // coordinate (x, y, or z) backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -205,24 +246,49 @@ struct LinearResampler_Float32 {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
-                temp = static_cast<unsigned int>(sy_48 >> 32);
+            temp = static_cast<unsigned int>(sy_48 >> 32);
+            temp = (temp > 0x8000)? temp - 0x8000 : 0;
+            uint32 sy1 = temp >> 16;                    // src y #1
+            uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
+            float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
+
+            float* pdst = dstdata + dstchannels*(y * dst.rowPitch + z * dst.slicePitch);
+
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = 0; x < dst.getWidth(); x++, sx_48+=stepx) {
+                temp = static_cast<unsigned int>(sx_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                uint32 sy1 = temp >> 16;                    // src y #1
-                uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
-                float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                    temp = static_cast<unsigned int>(sx_48 >> 32);
-                    temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                    uint32 sx1 = temp >> 16;                    // src x #1
-                    uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
-                    float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                    
-                    // process R,G,B,A simultaneously for cache coherence?
-                    float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                uint32 sx1 = temp >> 16;                    // src x #1
+                uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
+                float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
+
+#if OGRE_RESAMPLER_SSE2
+                if (srcchannels == 4 && dstchannels == 4) {
+                    // RGBA, one pixel per register in the same order as ACCUM4
+                    __m128 accum = _mm_setzero_ps();
+
+#define ACCUM4_SSE(x,y,z,factor) \
+    accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps( \
+        srcdata + (x+y*src.rowPitch+z*src.slicePitch)*4), _mm_set1_ps(factor)));
+
+                    ACCUM4_SSE(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
+                    ACCUM4_SSE(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
+                    ACCUM4_SSE(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
+                    ACCUM4_SSE(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
+                    ACCUM4_SSE(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
+                    ACCUM4_SSE(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
+                    ACCUM4_SSE(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
+                    ACCUM4_SSE(sx2,sy2,sz2,      sxf *      syf *      szf );
+#undef ACCUM4_SSE
+
+                    _mm_storeu_ps(pdst, accum);
+                    pdst += 4;
+                    continue;
+                }
+#endif
+
+                // process R,G,B,A simultaneously for cache coherence?
+                float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 #define ACCUM3(x,y,z,factor) \
     { float f = factor; \
@@ -236,39 +302,36 @@ struct LinearResampler_Float32 {
     accum[0]+=srcdata[off+0]*f; accum[1]+=srcdata[off+1]*f; \
     accum[2]+=srcdata[off+2]*f; accum[3]+=srcdata[off+3]*f; }
 
-                    if (srcchannels == 3 || dstchannels == 3) {
-                        // RGB, no alpha
-                        ACCUM3(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
-                        ACCUM3(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
-                        ACCUM3(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
-                        ACCUM3(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
-                        ACCUM3(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
-                        ACCUM3(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
-                        ACCUM3(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
-                        ACCUM3(sx2,sy2,sz2,      sxf *      syf *      szf );
-                        accum[3] = 1.0f;
-                    } else {
-                        // RGBA
-                        ACCUM4(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
-                        ACCUM4(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
-                        ACCUM4(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
-                        ACCUM4(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
-                        ACCUM4(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
-                        ACCUM4(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
-                        ACCUM4(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
-                        ACCUM4(sx2,sy2,sz2,      sxf *      syf *      szf );
-                    }
-
-                    memcpy(pdst, accum, sizeof(float)*dstchannels);
+                if (srcchannels == 3 || dstchannels == 3) {
+                    // RGB, no alpha
+                    ACCUM3(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
+                    ACCUM3(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
+                    ACCUM3(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
+                    ACCUM3(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
+                    ACCUM3(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
+                    ACCUM3(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
+                    ACCUM3(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
+                    ACCUM3(sx2,sy2,sz2,      sxf *      syf *      szf );
+                    accum[3] = 1.0f;
+                } else {
+                    // RGBA
+                    ACCUM4(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
+                    ACCUM4(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
+                    ACCUM4(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
+                    ACCUM4(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
+                    ACCUM4(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
+                    ACCUM4(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
+                    ACCUM4(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
+                    ACCUM4(sx2,sy2,sz2,      sxf *      syf *      szf );
+                }
+
+                memcpy(pdst, accum, sizeof(float)*dstchannels);
 
 #undef ACCUM3
 #undef ACCUM4
 
-                    pdst += dstchannels;
-                }
-                pdst += dstchannels*dst.getRowSkip();
+                pdst += dstchannels;
             }
-            pdst += dstchannels*dst.getSliceSkip();
         }
     }
 };
@@ -281,26 +344,27 @@ struct LinearResampler_Float32 {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t rowBegin, size_t rowEnd) {
         // assert(src.format == dst.format);
 
         // only optimized for 2D
         if (src.getDepth() > 1 || dst.getDepth() > 1) {
-            LinearResampler::scale(src, dst);
+            LinearResampler::scale(src, dst, rowBegin, rowEnd);
             return;
         }
 
-        // srcdata stays at beginning of slice, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning of slice, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
-        
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+
+        for (size_t y = rowBegin; y < rowEnd; y++) {
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
+
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -313,8 +377,18 @@ template<unsigned int channels> struct LinearResampler_Byte {
             size_t syoff1 = sy1 * src.rowPitch;
             size_t syoff2 = sy2 * src.rowPitch;
 
+            uchar* pdst = dstdata + channels * y * dst.rowPitch;
+
+#if OGRE_RESAMPLER_SSE2
+            if (channels == 4) {
+                scaleRowSSE2(srcdata + syoff1 * 4, srcdata + syoff2 * 4, pdst, stepx, dst.getWidth(),
+                             src.getWidth(), syf);
+                continue;
+            }
+#endif
+
             uint64 sx_48 = (stepx >> 1) - 1;
-            for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
+            for (size_t x = 0; x < dst.getWidth(); x++, sx_48+=stepx) {
                 temp = static_cast<unsigned int>(sx_48 >> 36);
                 temp = (temp > 0x800)? temp - 0x800 : 0;
                 unsigned int sxf = temp & 0xFFF;
@@ -333,9 +407,227 @@ template<unsigned int channels> struct LinearResampler_Byte {
                     *pdst++ = static_cast<uchar>((accum + 0x800000) >> 24);
                 }
             }
-            pdst += channels*dst.getRowSkip();
         }
     }
+
+#if OGRE_RESAMPLER_SSE2
+    // one row of 4 channel pixels, with exactly the same result as the generic loop.
+    // The weights above factor into (0x1000-sxf)*(0x1000-syf) etc., so the samples
+    // are blended horizontally first and then vertically. Both steps are 16 bit
+    // multiply-adds, the 20 bit horizontal results are split into 15 bit halves.
+    static void scaleRowSSE2(const uchar* srcrow1, const uchar* srcrow2, uchar* pdst, uint64 stepx,
+                             size_t width, uint32 srcwidth, unsigned int syf) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i low15 = _mm_set1_epi32(0x7FFF);
+        const __m128i round = _mm_set1_epi32(0x800000);
+        // (0x1000-syf, syf) pairs for the vertical blend
+        const __m128i wy = _mm_set1_epi32(int((syf << 16) | (0x1000 - syf)));
+
+        uint64 sx_48 = (stepx >> 1) - 1;
+        for (size_t x = 0; x < width; x++, sx_48+=stepx) {
+            unsigned int temp = static_cast<unsigned int>(sx_48 >> 36);
+            temp = (temp > 0x800)? temp - 0x800 : 0;
+            unsigned int sxf = temp & 0xFFF;
+            uint32 sx1 = temp >> 12;
+            uint32 sx2 = std::min(sx1+1, srcwidth-1);
+            const __m128i wx = _mm_set1_epi32(int((sxf << 16) | (0x1000 - sxf)));
+
+            int p[4];
+            memcpy(&p[0], srcrow1 + sx1*4, 4);
+            memcpy(&p[1], srcrow1 + sx2*4, 4);
+            memcpy(&p[2], srcrow2 + sx1*4, 4);
+            memcpy(&p[3], srcrow2 + sx2*4, 4);
+
+            // interleave the channels of the two samples of each row, widened to 16 bit
+            __m128i row1 = _mm_unpacklo_epi8(
+                _mm_unpacklo_epi8(_mm_cvtsi32_si128(p[0]), _mm_cvtsi32_si128(p[1])), zero);
+            __m128i row2 = _mm_unpacklo_epi8(
+                _mm_unpacklo_epi8(_mm_cvtsi32_si128(p[2]), _mm_cvtsi32_si128(p[3])), zero);
+            __m128i h1 = _mm_madd_epi16(row1, wx);
+            __m128i h2 = _mm_madd_epi16(row2, wx);
+
+            __m128i lo = _mm_or_si128(_mm_and_si128(h1, low15),
+                                      _mm_slli_epi32(_mm_and_si128(h2, low15), 16));
+            __m128i hi = _mm_or_si128(_mm_srli_epi32(h1, 15),
+                                      _mm_slli_epi32(_mm_srli_epi32(h2, 15), 16));
+            __m128i accum = _mm_add_epi32(_mm_madd_epi16(lo, wy),
+                                          _mm_slli_epi32(_mm_madd_epi16(hi, wy), 15));
+            accum = _mm_srli_epi32(_mm_add_epi32(accum, round), 24);
+
+            accum = _mm_packs_epi32(accum, accum);
+            int result = _mm_cvtsi128_si32(_mm_packus_epi16(accum, accum));
+            memcpy(pdst, &result, 4);
+            pdst += 4;
+        }
+    }
+#endif
+};
+
+
+// separable filtering resampler for the box, triangle, bicubic and lanczos
+// filters, does format conversion. The filters are widened when minifying, so
+// every source pixel contributes, which makes them suitable for mipmaps.
+// 2D only; punts 3D pixelboxes to default LinearResampler.
+struct FilterResampler {
+    // the contributing source pixels of each destination pixel along one axis
+    struct Contributions {
+        size_t taps;
+        std::vector<uint32> first;
+        std::vector<uint32> count;
+        std::vector<float> weights; // taps per destination pixel
+
+        Contributions(uint32 srcsize, uint32 dstsize, Image::Filter filter) {
+            float radius = getRadius(filter);
+            float ratio = float(srcsize) / dstsize;
+            // the filter is stretched over the source pixels when minifying
+            float filterscale = std::max(ratio, 1.0f);
+            float support = radius * filterscale;
+
+            taps = size_t(std::ceil(support)) * 2 + 1;
+            first.resize(dstsize);
+            count.resize(dstsize);
+            weights.resize(dstsize * taps);
+
+            for (uint32 i = 0; i < dstsize; i++) {
+                // center of the destination pixel in source pixel coordinates
+                float center = (i + 0.5f) * ratio - 0.5f;
+                int32 left = std::max(int32(std::ceil(center - support)), 0);
+                int32 right = std::min(int32(std::floor(center + support)), int32(srcsize) - 1);
+                right = std::min(right, left + int32(taps) - 1);
+
+                float* w = &weights[i * taps];
+                float sum = 0;
+                for (int32 j = left; j <= right; j++) {
+                    w[j - left] = evaluate(filter, (j - center) / filterscale);
+                    sum += w[j - left];
+                }
+
+                if (right < left || sum == 0) {
+                    // nothing in reach, take the nearest pixel
+                    left = std::min(std::max(int32(center + 0.5f), 0), int32(srcsize) - 1);
+                    right = left;
+                    w[0] = sum = 1;
+                }
+
+                first[i] = left;
+                count[i] = right - left + 1;
+                for (uint32 k = 0; k < count[i]; k++)
+                    w[k] /= sum;
+            }
+        }
+
+        static float getRadius(Image::Filter filter) {
+            switch (filter) {
+            case Image::FILTER_BOX: return 0.5f;
+            case Image::FILTER_TRIANGLE: return 1.0f;
+            case Image::FILTER_BICUBIC: return 2.0f;
+            default: return 3.0f;
+            }
+        }
+
+        static float evaluate(Image::Filter filter, float x) {
+            x = std::abs(x);
+            switch (filter) {
+            case Image::FILTER_BOX:
+                return x < 0.5f ? 1.0f : x == 0.5f ? 0.5f : 0.0f;
+            case Image::FILTER_TRIANGLE:
+                return std::max(1.0f - x, 0.0f);
+            case Image::FILTER_BICUBIC:
+                // Catmull-Rom spline
+                if (x < 1)
+                    return (1.5f * x - 2.5f) * x * x + 1;
+                if (x < 2)
+                    return ((-0.5f * x + 2.5f) * x - 4) * x + 2;
+                return 0;
+            default: {
+                // Lanczos with 3 lobes
+                if (x >= 3)
+                    return 0;
+                if (x < 1e-5f)
+                    return 1;
+                float px = Math::PI * x;
+                return 3 * std::sin(px) * std::sin(px / 3) / (px * px);
+            }
+            }
+        }
+    };
+
+    // bytechannels is the number of channels if src and dst have the same format with
+    // 1 byte per channel, which is filtered without conversion. 0 otherwise.
+    static void scale(const PixelBox& src, const PixelBox& dst, Image::Filter filter,
+                      size_t bytechannels) {
+        // only implemented for 2D
+        if (src.getDepth() > 1 || dst.getDepth() > 1) {
+            resampleRows(dst.getHeight() * dst.getDepth(), dst.getWidth(),
+                         [&src, &dst](size_t rowBegin, size_t rowEnd) {
+                             LinearResampler::scale(src, dst, rowBegin, rowEnd);
+                         });
+            return;
+        }
+
+        size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
+        size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
+        Contributions horizontal(src.getWidth(), dst.getWidth(), filter);
+        Contributions vertical(src.getHeight(), dst.getHeight(), filter);
+
+        // source rows filtered horizontally, as ColourValue (same layout as PF_FLOAT32_RGBA)
+        // or as the raw byte values of up to 4 channels
+        uint32 width = dst.getWidth();
+        std::vector<ColourValue> filtered(size_t(width) * src.getHeight());
+
+        resampleRows(src.getHeight(), src.getWidth() + width,
+                     [&](size_t rowBegin, size_t rowEnd) {
+            std::vector<ColourValue> srcrow(src.getWidth());
+            PixelBox srcrowbox(src.getWidth(), 1, 1, PF_FLOAT32_RGBA, srcrow.data());
+            for (size_t y = rowBegin; y < rowEnd; y++) {
+                uchar* psrcrow = src.getTopLeftFrontPixelPtr() + y * src.rowPitch * srcelemsize;
+                if (bytechannels) {
+                    // channel order does not matter, as all are filtered alike
+                    for (uint32 x = 0; x < src.getWidth(); x++)
+                        for (size_t k = 0; k < bytechannels; k++)
+                            srcrow[x][k] = psrcrow[x * bytechannels + k];
+                } else {
+                    PixelUtil::bulkPixelConversion(
+                        PixelBox(src.getWidth(), 1, 1, src.format, psrcrow), srcrowbox);
+                }
+
+                ColourValue* pdst = &filtered[y * width];
+                for (uint32 x = 0; x < width; x++) {
+                    const ColourValue* psrc = &srcrow[horizontal.first[x]];
+                    const float* w = &horizontal.weights[x * horizontal.taps];
+                    ColourValue accum(0, 0, 0, 0);
+                    for (uint32 k = 0; k < horizontal.count[x]; k++)
+                        accum += psrc[k] * w[k];
+                    pdst[x] = accum;
+                }
+            }
+        });
+
+        resampleRows(dst.getHeight(), vertical.taps * width, [&](size_t rowBegin, size_t rowEnd) {
+            std::vector<ColourValue> dstrow(width);
+            PixelBox dstrowbox(width, 1, 1, PF_FLOAT32_RGBA, dstrow.data());
+            for (size_t y = rowBegin; y < rowEnd; y++) {
+                // blend whole rows at once, which keeps the memory accesses linear
+                std::fill(dstrow.begin(), dstrow.end(), ColourValue(0, 0, 0, 0));
+                const float* w = &vertical.weights[y * vertical.taps];
+                for (uint32 k = 0; k < vertical.count[y]; k++) {
+                    const ColourValue* psrc = &filtered[(vertical.first[y] + k) * size_t(width)];
+                    for (uint32 x = 0; x < width; x++)
+                        dstrow[x] += psrc[x] * w[k];
+                }
+
+                uchar* pdstrow = dst.getTopLeftFrontPixelPtr() + y * dst.rowPitch * dstelemsize;
+                if (bytechannels) {
+                    for (uint32 x = 0; x < width; x++)
+                        for (size_t k = 0; k < bytechannels; k++)
+                            pdstrow[x * bytechannels + k] =
+                                static_cast<uchar>(Math::Clamp(dstrow[x][k] + 0.5f, 0.0f, 255.0f));
+                } else {
+                    PixelUtil::bulkPixelConversion(dstrowbox, PixelBox(width, 1, 1, dst.format, pdstrow));
+                }
+            }
+        });
+    }
 };
 /** @} */
 /** @} */
@@ -208,8 +208,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless the stream already is (e.g. memory mapped)
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -0,0 +1,728 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreMeshOptimiser.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgrePose.h"
+
+namespace Ogre
+{
+    namespace
+    {
+        /// Size of the LRU cache the vertex scores are tuned for
+        const int FORSYTH_CACHE_SIZE = 32;
+        const uint32 UNUSED = 0xFFFFFFFF;
+
+        void readIndexes(HardwareIndexBuffer* ibuf, size_t start, size_t count,
+                         std::vector<uint32>& indexes)
+        {
+            indexes.resize(count);
+            if (count == 0)
+                return;
+            size_t indexSize = ibuf->getIndexSize();
+            HardwareBufferLockGuard lock(ibuf, start * indexSize, count * indexSize,
+                                         HardwareBuffer::HBL_READ_ONLY);
+            if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+            {
+                memcpy(indexes.data(), lock.pData, count * indexSize);
+            }
+            else
+            {
+                const uint16* src = static_cast<const uint16*>(lock.pData);
+                std::copy(src, src + count, indexes.begin());
+            }
+        }
+
+        void writeIndexes(HardwareIndexBuffer* ibuf, size_t start, const std::vector<uint32>& indexes)
+        {
+            if (indexes.empty())
+                return;
+            size_t indexSize = ibuf->getIndexSize();
+            HardwareBufferLockGuard lock(ibuf, start * indexSize, indexes.size() * indexSize,
+                                         HardwareBuffer::HBL_NORMAL);
+            if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+            {
+                memcpy(lock.pData, indexes.data(), indexes.size() * indexSize);
+            }
+            else
+            {
+                uint16* dst = static_cast<uint16*>(lock.pData);
+                for (size_t i = 0; i < indexes.size(); ++i)
+                    dst[i] = static_cast<uint16>(indexes[i]);
+            }
+        }
+
+        /// Whether the triangles of the index data can be reordered on their own
+        bool isReorderable(const IndexData* indexData, const std::vector<IndexData*>& siblings)
+        {
+            if (!indexData || !indexData->indexBuffer || indexData->indexCount < 6 ||
+                indexData->indexCount % 3 != 0)
+                return false;
+
+            // generated LOD levels may share the indexes with other levels
+            for (size_t i = 0; i < siblings.size(); ++i)
+            {
+                const IndexData* other = siblings[i];
+                if (other == indexData || other->indexBuffer != indexData->indexBuffer)
+                    continue;
+                if (other->indexStart < indexData->indexStart + indexData->indexCount &&
+                    indexData->indexStart < other->indexStart + other->indexCount)
+                    return false;
+            }
+            return true;
+        }
+
+        /// FIFO cache simulation, where a vertex is cached if it was one of the last cacheSize misses
+        class FifoCache
+        {
+        public:
+            FifoCache(uint32 vertexCount, size_t cacheSize)
+                : mTimestamps(vertexCount, 0), mTime(uint32(cacheSize) + 1), mCacheSize(uint32(cacheSize))
+            {
+            }
+
+            /// Returns the number of cache misses of the triangle
+            int addTriangle(const uint32* tri)
+            {
+                int misses = 0;
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (mTime - mTimestamps[tri[i]] > mCacheSize)
+                    {
+                        mTimestamps[tri[i]] = mTime++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            }
+
+            void clear() { mTime += mCacheSize + 1; }
+
+        private:
+            std::vector<uint32> mTimestamps;
+            uint32 mTime;
+            uint32 mCacheSize;
+        };
+
+        /// Forsyth's scores for the position in the LRU cache and the number of remaining triangles
+        struct VertexScores
+        {
+            float cache[FORSYTH_CACHE_SIZE];
+            float valence[64];
+
+            VertexScores()
+            {
+                for (int i = 0; i < FORSYTH_CACHE_SIZE; ++i)
+                {
+                    // the vertices of the last triangle get a fixed score, so a triangle
+                    // using two of them is not preferred over a fresh strip
+                    cache[i] = i < 3 ? 0.75f
+                                     : std::pow(1.0f - float(i - 3) / (FORSYTH_CACHE_SIZE - 3), 1.5f);
+                }
+                valence[0] = -1.0f;
+                for (int i = 1; i < 64; ++i)
+                    valence[i] = getValenceScore(i);
+            }
+
+            static float getValenceScore(uint32 remaining)
+            {
+                // finish vertices with few triangles left, not to leave lone triangles behind
+                return 2.0f / std::sqrt(float(remaining));
+            }
+
+            float get(int cachePosition, uint32 remaining) const
+            {
+                if (remaining == 0)
+                    return -1.0f;
+                float score = remaining < 64 ? valence[remaining] : getValenceScore(remaining);
+                if (cachePosition >= 0)
+                    score += cache[cachePosition];
+                return score;
+            }
+        };
+
+        void reorderForVertexCache(std::vector<uint32>& indexes)
+        {
+            static const VertexScores scores;
+
+            size_t triCount = indexes.size() / 3;
+            uint32 vertexCount = *std::max_element(indexes.begin(), indexes.end()) + 1;
+
+            // triangles of every vertex, the first remaining[v] of them are not emitted yet
+            std::vector<uint32> adjacencyStart(vertexCount + 1, 0);
+            for (size_t i = 0; i < indexes.size(); ++i)
+                ++adjacencyStart[indexes[i] + 1];
+            for (uint32 v = 0; v < vertexCount; ++v)
+                adjacencyStart[v + 1] += adjacencyStart[v];
+            std::vector<uint32> remaining(vertexCount, 0);
+            std::vector<uint32> adjacency(indexes.size());
+            for (size_t i = 0; i < indexes.size(); ++i)
+            {
+                uint32 v = indexes[i];
+                adjacency[adjacencyStart[v] + remaining[v]++] = uint32(i / 3);
+            }
+
+            std::vector<int> cachePosition(vertexCount, -1);
+            std::vector<float> vertexScore(vertexCount);
+            for (uint32 v = 0; v < vertexCount; ++v)
+                vertexScore[v] = scores.get(-1, remaining[v]);
+
+            std::vector<float> triScore(triCount);
+            for (size_t t = 0; t < triCount; ++t)
+            {
+                triScore[t] = vertexScore[indexes[3 * t]] + vertexScore[indexes[3 * t + 1]] +
+                              vertexScore[indexes[3 * t + 2]];
+            }
+            std::vector<bool> emitted(triCount, false);
+
+            std::vector<uint32> result;
+            result.reserve(indexes.size());
+            uint32 cache[FORSYTH_CACHE_SIZE + 3];
+            int cacheSize = 0;
+            size_t nextUnemitted = 0;
+            size_t bestTri = std::max_element(triScore.begin(), triScore.end()) - triScore.begin();
+
+            for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount)
+            {
+                if (bestTri == size_t(UNUSED))
+                {
+                    // nothing in the cache is left, continue with the next triangle of the
+                    // original order, which usually is close to the last one
+                    while (emitted[nextUnemitted])
+                        ++nextUnemitted;
+                    bestTri = nextUnemitted;
+                }
+
+                const uint32* tri = &indexes[3 * bestTri];
+                result.insert(result.end(), tri, tri + 3);
+                emitted[bestTri] = true;
+
+                uint32 newCache[FORSYTH_CACHE_SIZE + 3];
+                int newCacheSize = 0;
+                for (int i = 0; i < 3; ++i)
+                {
+                    uint32 v = tri[i];
+                    // remove the triangle from the adjacency of the vertex
+                    uint32* begin = &adjacency[adjacencyStart[v]];
+                    uint32* last = begin + --remaining[v];
+                    std::swap(*std::find(begin, last + 1, uint32(bestTri)), *last);
+
+                    if (std::find(newCache, newCache + newCacheSize, v) == newCache + newCacheSize)
+                        newCache[newCacheSize++] = v;
+                }
+                for (int i = 0; i < cacheSize; ++i)
+                {
+                    uint32 v = cache[i];
+                    if (v != tri[0] && v != tri[1] && v != tri[2])
+                        newCache[newCacheSize++] = v;
+                }
+
+                // update the scores of the cached and the evicted vertices and their triangles
+                for (int i = 0; i < newCacheSize; ++i)
+                {
+                    uint32 v = newCache[i];
+                    cachePosition[v] = i < FORSYTH_CACHE_SIZE ? i : -1;
+                    float score = scores.get(cachePosition[v], remaining[v]);
+                    float delta = score - vertexScore[v];
+                    vertexScore[v] = score;
+                    for (uint32 j = 0; j < remaining[v]; ++j)
+                        triScore[adjacency[adjacencyStart[v] + j]] += delta;
+                }
+
+                cacheSize = std::min(newCacheSize, FORSYTH_CACHE_SIZE);
+                memcpy(cache, newCache, sizeof(cache));
+
+                bestTri = UNUSED;
+                float bestScore = -1.0f;
+                for (int i = 0; i < cacheSize; ++i)
+                {
+                    uint32 v = cache[i];
+                    for (uint32 j = 0; j < remaining[v]; ++j)
+                    {
+                        uint32 t = adjacency[adjacencyStart[v] + j];
+                        if (triScore[t] > bestScore)
+                        {
+                            bestScore = triScore[t];
+                            bestTri = t;
+                        }
+                    }
+                }
+            }
+
+            indexes.swap(result);
+        }
+
+        struct Cluster
+        {
+            size_t start;
+            size_t end;
+            float sortKey;
+
+            bool operator<(const Cluster& other) const { return sortKey > other.sortKey; }
+        };
+
+        void reorderForOverdraw(std::vector<uint32>& indexes, const std::vector<Vector3>& positions,
+                                float threshold)
+        {
+            size_t triCount = indexes.size() / 3;
+            FifoCache fifo(uint32(positions.size()), MeshOptimiser::DEFAULT_CACHE_SIZE);
+
+            // the vertex cache order starts anew where all vertices of a triangle miss the cache
+            // the first one too, which a degenerate triangle would not hit
+            std::vector<size_t> hardBoundaries(1, 0);
+            for (size_t t = 0; t < triCount; ++t)
+            {
+                if (fifo.addTriangle(&indexes[3 * t]) == 3 && t > 0)
+                    hardBoundaries.push_back(t);
+            }
+            hardBoundaries.push_back(triCount);
+
+            // split further, wherever starting with a cold cache keeps the miss ratio of the
+            // cluster below the threshold
+            std::vector<Cluster> clusters;
+            for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+            {
+                size_t start = hardBoundaries[i];
+                size_t end = hardBoundaries[i + 1];
+
+                fifo.clear();
+                size_t misses = 0;
+                for (size_t t = start; t < end; ++t)
+                    misses += fifo.addTriangle(&indexes[3 * t]);
+                float maxAcmr = threshold * misses / (end - start);
+
+                fifo.clear();
+                misses = 0;
+                Cluster cluster = {start, end, 0};
+                for (size_t t = start; t < end; ++t)
+                {
+                    misses += fifo.addTriangle(&indexes[3 * t]);
+                    if (t + 1 < end && misses <= maxAcmr * (t + 1 - cluster.start))
+                    {
+                        cluster.end = t + 1;
+                        clusters.push_back(cluster);
+                        cluster.start = t + 1;
+                        fifo.clear();
+                        misses = 0;
+                    }
+                }
+                cluster.end = end;
+                clusters.push_back(cluster);
+            }
+
+            // draw the clusters facing away from the centre first, they are more likely to
+            // occlude the others
+            std::vector<Vector3> centroids(clusters.size(), Vector3::ZERO);
+            std::vector<Vector3> normals(clusters.size(), Vector3::ZERO);
+            Vector3 meshCentroid = Vector3::ZERO;
+            Real meshArea = 0;
+            for (size_t c = 0; c < clusters.size(); ++c)
+            {
+                Real clusterArea = 0;
+                for (size_t t = clusters[c].start; t < clusters[c].end; ++t)
+                {
+                    const Vector3& p0 = positions[indexes[3 * t]];
+                    const Vector3& p1 = positions[indexes[3 * t + 1]];
+                    const Vector3& p2 = positions[indexes[3 * t + 2]];
+                    Vector3 normal = (p1 - p0).crossProduct(p2 - p0);
+                    Real area = normal.length();
+                    centroids[c] += (p0 + p1 + p2) * (area / 3);
+                    normals[c] += normal;
+                    clusterArea += area;
+                }
+                meshCentroid += centroids[c];
+                meshArea += clusterArea;
+                if (clusterArea > 0)
+                    centroids[c] /= clusterArea;
+            }
+            if (meshArea > 0)
+                meshCentroid /= meshArea;
+
+            for (size_t c = 0; c < clusters.size(); ++c)
+            {
+                normals[c].normalise();
+                clusters[c].sortKey = float((centroids[c] - meshCentroid).dotProduct(normals[c]));
+            }
+            std::stable_sort(clusters.begin(), clusters.end());
+
+            std::vector<uint32> result;
+            result.reserve(indexes.size());
+            for (size_t c = 0; c < clusters.size(); ++c)
+            {
+                result.insert(result.end(), indexes.begin() + 3 * clusters[c].start,
+                              indexes.begin() + 3 * clusters[c].end);
+            }
+            indexes.swap(result);
+        }
+
+        bool readPositions(const VertexData* vertexData, std::vector<Vector3>& positions)
+        {
+            const VertexElement* posElem =
+                vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+            if (!posElem || posElem->getType() != VET_FLOAT3)
+                return false;
+
+            const HardwareVertexBufferSharedPtr& vbuf =
+                vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+            size_t vertexSize = vbuf->getVertexSize();
+            HardwareBufferLockGuard lock(vbuf, vertexData->vertexStart * vertexSize,
+                                         vertexData->vertexCount * vertexSize,
+                                         HardwareBuffer::HBL_READ_ONLY);
+            positions.resize(vertexData->vertexCount);
+            const uchar* vertex = static_cast<const uchar*>(lock.pData);
+            for (size_t i = 0; i < vertexData->vertexCount; ++i, vertex += vertexSize)
+            {
+                float* pFloat;
+                posElem->baseVertexPointerToElement(const_cast<uchar*>(vertex), &pFloat);
+                positions[i] = Vector3(pFloat[0], pFloat[1], pFloat[2]);
+            }
+            return true;
+        }
+
+        void optimiseIndexData(IndexData* indexData, const std::vector<IndexData*>& siblings,
+                               const VertexData* vertexData, bool overdraw)
+        {
+            if (!isReorderable(indexData, siblings))
+                return;
+            MeshOptimiser::optimiseVertexCache(indexData);
+            if (overdraw)
+                MeshOptimiser::optimiseOverdraw(indexData, vertexData);
+        }
+
+        std::vector<IndexData*> getIndexDatas(SubMesh* subMesh)
+        {
+            std::vector<IndexData*> indexDatas(1, subMesh->indexData);
+            indexDatas.insert(indexDatas.end(), subMesh->mLodFaceList.begin(),
+                              subMesh->mLodFaceList.end());
+            return indexDatas;
+        }
+
+        void optimiseTriangles(SubMesh* subMesh, bool overdraw)
+        {
+            if (subMesh->operationType != RenderOperation::OT_TRIANGLE_LIST)
+                return;
+
+            std::vector<IndexData*> indexDatas = getIndexDatas(subMesh);
+            const VertexData* vertexData =
+                subMesh->useSharedVertices ? subMesh->parent->sharedVertexData : subMesh->vertexData;
+            for (size_t i = 0; i < indexDatas.size(); ++i)
+                optimiseIndexData(indexDatas[i], indexDatas, vertexData, overdraw);
+        }
+
+        template <typename T>
+        void permute(std::vector<T>& data, size_t stride, const std::vector<uint32>& remap)
+        {
+            std::vector<T> result(data.size());
+            for (size_t i = 0; i < remap.size(); ++i)
+                std::copy(&data[i * stride], &data[i * stride] + stride, &result[remap[i] * stride]);
+            data.swap(result);
+        }
+
+        void permuteVertexBuffer(HardwareVertexBuffer* vbuf, size_t vertexStart,
+                                 const std::vector<uint32>& remap)
+        {
+            size_t vertexSize = vbuf->getVertexSize();
+            std::vector<uchar> data(remap.size() * vertexSize);
+            vbuf->readData(vertexStart * vertexSize, data.size(), data.data());
+            permute(data, vertexSize, remap);
+            vbuf->writeData(vertexStart * vertexSize, data.size(), data.data());
+        }
+
+        void remapBoneAssignments(Mesh* mesh, SubMesh* subMesh, const std::vector<uint32>& remap)
+        {
+            Mesh::VertexBoneAssignmentList assignments =
+                subMesh ? subMesh->getBoneAssignments() : mesh->getBoneAssignments();
+            if (assignments.empty())
+                return;
+
+            if (subMesh)
+                subMesh->clearBoneAssignments();
+            else
+                mesh->clearBoneAssignments();
+
+            Mesh::VertexBoneAssignmentList::iterator i;
+            for (i = assignments.begin(); i != assignments.end(); ++i)
+            {
+                i->second.vertexIndex = remap[i->second.vertexIndex];
+                if (subMesh)
+                    subMesh->addBoneAssignment(i->second);
+                else
+                    mesh->addBoneAssignment(i->second);
+            }
+        }
+
+        void remapPoses(Mesh* mesh, ushort target, const std::vector<uint32>& remap)
+        {
+            const PoseList& poses = mesh->getPoseList();
+            for (size_t p = 0; p < poses.size(); ++p)
+            {
+                Pose* pose = poses[p];
+                if (pose->getTarget() != target)
+                    continue;
+
+                Pose::VertexOffsetMap offsets = pose->getVertexOffsets();
+                Pose::NormalsMap normals = pose->getNormals();
+                pose->clearVertices();
+                Pose::VertexOffsetMap::const_iterator i;
+                for (i = offsets.begin(); i != offsets.end(); ++i)
+                {
+                    if (normals.empty())
+                        pose->addVertex(remap[i->first], i->second);
+                    else
+                        pose->addVertex(remap[i->first], i->second, normals[i->first]);
+                }
+            }
+        }
+
+        void remapMorphAnimations(Mesh* mesh, ushort target, const std::vector<uint32>& remap)
+        {
+            for (unsigned short a = 0; a < mesh->getNumAnimations(); ++a)
+            {
+                const Animation::VertexTrackList& tracks = mesh->getAnimation(a)->_getVertexTrackList();
+                Animation::VertexTrackList::const_iterator track = tracks.find(target);
+                if (track == tracks.end() || track->second->getAnimationType() != VAT_MORPH)
+                    continue;
+
+                for (unsigned short k = 0; k < track->second->getNumKeyFrames(); ++k)
+                {
+                    VertexMorphKeyFrame* keyFrame = track->second->getVertexMorphKeyFrame(k);
+                    permuteVertexBuffer(keyFrame->getVertexBuffer().get(), 0, remap);
+                }
+            }
+        }
+
+        /** Stores the vertices in the order they are first used by the full detail level,
+            followed by the other LOD levels.
+        @param target 0 for the shared vertices, otherwise the index of the SubMesh + 1
+        */
+        void optimiseVertexFetch(Mesh* mesh, ushort target, const std::vector<IndexData*>& indexDatas)
+        {
+            SubMesh* subMesh = target == 0 ? NULL : mesh->getSubMesh(target - 1);
+            VertexData* vertexData = subMesh ? subMesh->vertexData : mesh->sharedVertexData;
+            if (!vertexData || vertexData->vertexCount == 0)
+                return;
+
+            std::vector<uint32> remap(vertexData->vertexCount, UNUSED);
+            uint32 nextVertex = 0;
+            // the indexes of every buffer, the ranges of LOD levels sharing a buffer may overlap
+            std::map<HardwareIndexBuffer*, std::vector<bool> > usedIndexes;
+            std::vector<uint32> indexes;
+            for (size_t i = 0; i < indexDatas.size(); ++i)
+            {
+                const IndexData* indexData = indexDatas[i];
+                if (!indexData->indexBuffer || indexData->indexCount == 0)
+                    continue;
+
+                HardwareIndexBuffer* ibuf = indexData->indexBuffer.get();
+                std::vector<bool>& used = usedIndexes[ibuf];
+                used.resize(ibuf->getNumIndexes(), false);
+                std::fill(used.begin() + indexData->indexStart,
+                          used.begin() + indexData->indexStart + indexData->indexCount, true);
+
+                readIndexes(ibuf, indexData->indexStart, indexData->indexCount, indexes);
+                for (size_t j = 0; j < indexes.size(); ++j)
+                {
+                    if (indexes[j] < remap.size() && remap[indexes[j]] == UNUSED)
+                        remap[indexes[j]] = nextVertex++;
+                }
+            }
+
+            // keep the unused vertices, they may be referenced by something else
+            bool identity = true;
+            for (size_t v = 0; v < remap.size(); ++v)
+            {
+                if (remap[v] == UNUSED)
+                    remap[v] = nextVertex++;
+                identity = identity && remap[v] == v;
+            }
+            if (identity)
+                return;
+
+            std::map<HardwareIndexBuffer*, std::vector<bool> >::iterator i;
+            for (i = usedIndexes.begin(); i != usedIndexes.end(); ++i)
+            {
+                readIndexes(i->first, 0, i->first->getNumIndexes(), indexes);
+                for (size_t j = 0; j < indexes.size(); ++j)
+                {
+                    if (i->second[j] && indexes[j] < remap.size())
+                        indexes[j] = remap[indexes[j]];
+                }
+                writeIndexes(i->first, 0, indexes);
+            }
+
+            std::set<HardwareVertexBuffer*> vertexBuffers;
+            const VertexBufferBinding::VertexBufferBindingMap& bindings =
+                vertexData->vertexBufferBinding->getBindings();
+            VertexBufferBinding::VertexBufferBindingMap::const_iterator b;
+            for (b = bindings.begin(); b != bindings.end(); ++b)
+            {
+                if (vertexBuffers.insert(b->second.get()).second)
+                    permuteVertexBuffer(b->second.get(), vertexData->vertexStart, remap);
+            }
+
+            remapBoneAssignments(mesh, subMesh, remap);
+            remapPoses(mesh, target, remap);
+            remapMorphAnimations(mesh, target, remap);
+        }
+    }
+    //---------------------------------------------------------------------
+    MeshOptimiser::VertexCacheStatistics MeshOptimiser::analyseVertexCache(const IndexData* indexData,
+                                                                           size_t cacheSize)
+    {
+        VertexCacheStatistics stats;
+        if (!indexData->indexBuffer || indexData->indexCount < 3)
+            return stats;
+
+        std::vector<uint32> indexes;
+        readIndexes(indexData->indexBuffer.get(), indexData->indexStart, indexData->indexCount, indexes);
+        uint32 vertexCount = *std::max_element(indexes.begin(), indexes.end()) + 1;
+
+        FifoCache fifo(vertexCount, cacheSize);
+        std::vector<bool> used(vertexCount, false);
+        stats.triangleCount = indexes.size() / 3;
+        for (size_t t = 0; t < stats.triangleCount; ++t)
+        {
+            stats.vertexTransforms += fifo.addTriangle(&indexes[3 * t]);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (!used[indexes[3 * t + i]])
+                {
+                    used[indexes[3 * t + i]] = true;
+                    ++stats.vertexCount;
+                }
+            }
+        }
+        stats.acmr = float(stats.vertexTransforms) / stats.triangleCount;
+        stats.atvr = float(stats.vertexTransforms) / stats.vertexCount;
+        return stats;
+    }
+    //---------------------------------------------------------------------
+    MeshOptimiser::VertexCacheStatistics MeshOptimiser::analyseVertexCache(const Mesh* mesh,
+                                                                           size_t cacheSize)
+    {
+        VertexCacheStatistics stats;
+        for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh* subMesh = mesh->getSubMesh(i);
+            if (subMesh->operationType != RenderOperation::OT_TRIANGLE_LIST)
+                continue;
+
+            VertexCacheStatistics subStats = analyseVertexCache(subMesh->indexData, cacheSize);
+            stats.triangleCount += subStats.triangleCount;
+            stats.vertexCount += subStats.vertexCount;
+            stats.vertexTransforms += subStats.vertexTransforms;
+        }
+        if (stats.triangleCount > 0)
+        {
+            stats.acmr = float(stats.vertexTransforms) / stats.triangleCount;
+            stats.atvr = float(stats.vertexTransforms) / stats.vertexCount;
+        }
+        return stats;
+    }
+    //---------------------------------------------------------------------
+    void MeshOptimiser::optimiseVertexCache(IndexData* indexData)
+    {
+        if (indexData->indexCount < 6)
+            return;
+
+        std::vector<uint32> indexes;
+        readIndexes(indexData->indexBuffer.get(), indexData->indexStart, indexData->indexCount, indexes);
+        reorderForVertexCache(indexes);
+        writeIndexes(indexData->indexBuffer.get(), indexData->indexStart, indexes);
+    }
+    //---------------------------------------------------------------------
+    void MeshOptimiser::optimiseOverdraw(IndexData* indexData, const VertexData* vertexData,
+                                         float threshold)
+    {
+        std::vector<Vector3> positions;
+        if (indexData->indexCount < 6 || !readPositions(vertexData, positions))
+            return;
+
+        std::vector<uint32> indexes;
+        readIndexes(indexData->indexBuffer.get(), indexData->indexStart, indexData->indexCount, indexes);
+        if (*std::max_element(indexes.begin(), indexes.end()) >= positions.size())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "index out of range of the vertex data",
+                        "MeshOptimiser::optimiseOverdraw");
+        }
+        reorderForOverdraw(indexes, positions, threshold);
+        writeIndexes(indexData->indexBuffer.get(), indexData->indexStart, indexes);
+    }
+    //---------------------------------------------------------------------
+    void MeshOptimiser::optimise(SubMesh* subMesh, bool overdraw)
+    {
+        Mesh* mesh = subMesh->parent;
+        bool rebuildEdgeLists = mesh->isEdgeListBuilt();
+        mesh->freeEdgeList();
+
+        optimiseTriangles(subMesh, overdraw);
+        if (!subMesh->useSharedVertices)
+        {
+            ushort target = 0;
+            while (mesh->getSubMesh(target) != subMesh)
+                ++target;
+            optimiseVertexFetch(mesh, target + 1, getIndexDatas(subMesh));
+        }
+
+        if (rebuildEdgeLists)
+            mesh->buildEdgeList();
+    }
+    //---------------------------------------------------------------------
+    void MeshOptimiser::optimise(Mesh* mesh, bool overdraw)
+    {
+        bool rebuildEdgeLists = mesh->isEdgeListBuilt();
+        mesh->freeEdgeList();
+
+        // all full detail levels first, they are used most
+        std::vector<IndexData*> sharedIndexDatas;
+        std::vector<IndexData*> sharedLodIndexDatas;
+        for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+        {
+            SubMesh* subMesh = mesh->getSubMesh(i);
+            optimiseTriangles(subMesh, overdraw);
+            if (subMesh->useSharedVertices)
+            {
+                sharedIndexDatas.push_back(subMesh->indexData);
+                sharedLodIndexDatas.insert(sharedLodIndexDatas.end(), subMesh->mLodFaceList.begin(),
+                                           subMesh->mLodFaceList.end());
+            }
+            else
+            {
+                optimiseVertexFetch(mesh, i + 1, getIndexDatas(subMesh));
+            }
+        }
+        sharedIndexDatas.insert(sharedIndexDatas.end(), sharedLodIndexDatas.begin(),
+                                sharedLodIndexDatas.end());
+        optimiseVertexFetch(mesh, 0, sharedIndexDatas);
+
+        if (rebuildEdgeLists)
+            mesh->buildEdgeList();
+    }
+}
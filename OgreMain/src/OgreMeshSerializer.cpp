@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreMeshSerializerImpl.h"
+#include "OgreMeshSerializerBaked.h"
 
 namespace Ogre {
 
@@ -155,7 +156,38 @@ namespace Ogre {
         impl->exportMesh(pMesh, stream, endianMode);
     }
     //---------------------------------------------------------------------
+    void MeshSerializer::exportBakedMesh(const Mesh* pMesh, const String& filename)
+    {
+        DataStreamPtr stream = _openFileStream(filename, std::ios::binary | std::ios::out);
+
+        exportBakedMesh(pMesh, stream);
+
+        stream->close();
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializer::exportBakedMesh(const Mesh* pMesh, DataStreamPtr stream)
+    {
+        MeshSerializerBakedImpl impl;
+        impl.exportMesh(pMesh, stream);
+    }
+    //---------------------------------------------------------------------
     void MeshSerializer::importMesh(DataStreamPtr& stream, Mesh* pDest)
+    {
+        if (MeshSerializerBakedImpl::isBakedMesh(stream))
+        {
+            MeshSerializerBakedImpl impl;
+            impl.importMesh(stream, pDest, mListener);
+        }
+        else
+        {
+            importClassicMesh(stream, pDest);
+        }
+
+        if(mListener)
+            mListener->processMeshCompleted(pDest);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializer::importClassicMesh(DataStreamPtr& stream, Mesh* pDest)
     {
         determineEndianness(stream);
 
@@ -198,9 +230,6 @@ namespace Ogre {
             LogManager::getSingleton().logWarning(pDest->getName() + " uses an old format " + ver +
                                                   "; upgrade with the OgreMeshUpgrader tool");
         }
-
-        if(mListener)
-            mListener->processMeshCompleted(pDest);
     }
     //---------------------------------------------------------------------
     void MeshSerializer::setListener(Ogre::MeshSerializerListener *listener)
@@ -0,0 +1,860 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreMeshSerializerBaked.h"
+#include "OgreMeshSerializer.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreEdgeListBuilder.h"
+#include "OgreKeyFrame.h"
+#include "OgreLodStrategy.h"
+#include "OgreLodStrategyManager.h"
+#include "OgrePose.h"
+
+namespace Ogre {
+
+    using namespace BakedMeshFormat;
+
+    namespace {
+        const uint32 MAX_FILE_SIZE = 0xFFFFFFFF;
+
+        void checkIndex(uint32 index, size_t count)
+        {
+            if (index >= count)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: index out of range",
+                            "MeshSerializerBakedImpl::importMesh");
+        }
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerBakedImpl::isBakedMesh(const DataStreamPtr& stream)
+    {
+        // compare the bytes, so a baked mesh is also detected on big endian machines
+        char magic[4];
+        size_t actually_read = stream->read(magic, sizeof(magic));
+        stream->skip(0 - (long)actually_read);
+        return actually_read == sizeof(magic) && memcmp(magic, "OGBM", sizeof(magic)) == 0;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerBakedImpl::exportMesh(const Mesh* pMesh, const DataStreamPtr& stream)
+    {
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Baked meshes are only supported on little endian "
+                    "platforms", "MeshSerializerBakedImpl::exportMesh");
+#endif
+        LogManager::getSingleton().logMessage("MeshSerializer writing baked mesh data to stream " +
+                                              stream->getName() + "...");
+
+        // Check that the mesh has it's bounds set
+        if (pMesh->getBounds().isNull() || pMesh->getBoundingSphereRadius() == 0.0f)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "The Mesh you have supplied does not have its"
+                " bounds completely defined. Define them first before exporting.",
+                "MeshSerializerBakedImpl::exportMesh");
+        }
+        if (!stream->isWriteable())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Unable to use stream " + stream->getName() + " for writing",
+                "MeshSerializerBakedImpl::exportMesh");
+        }
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            if (pMesh->getSubMesh(i)->hasTextureAliases())
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Texture aliases are deprecated and can not be "
+                            "baked: " + pMesh->getName(), "MeshSerializerBakedImpl::exportMesh");
+        }
+
+        mBuffer.clear();
+        mIndexBufferIndices.clear();
+        mVertexData.clear();
+        mIndexBuffers.clear();
+        mEdgeLists.clear();
+
+        // filled in last
+        allocate(sizeof(Header), DATA_ALIGNMENT);
+        Header header;
+        memset(&header, 0, sizeof(header));
+        header.magic = MAGIC;
+        header.version = VERSION;
+
+        header.sharedVertexData = NO_INDEX;
+        if (pMesh->sharedVertexData)
+            header.sharedVertexData = writeVertexData(pMesh->sharedVertexData);
+
+        std::vector<BakedMeshFormat::SubMesh> subMeshes(pMesh->getNumSubMeshes());
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            const Ogre::SubMesh* s = pMesh->getSubMesh(i);
+            BakedMeshFormat::SubMesh& dest = subMeshes[i];
+            dest.materialName = writeString(s->getMaterialName());
+            dest.operationType = s->operationType;
+            dest.vertexData = s->useSharedVertices ? NO_INDEX : writeVertexData(s->vertexData);
+            dest.indexData = writeIndexData(s->indexData);
+
+            std::vector<BakedMeshFormat::IndexData> lodIndexData;
+#if !OGRE_NO_MESHLOD
+            for (size_t l = 0; l < s->mLodFaceList.size(); ++l)
+                lodIndexData.push_back(writeIndexData(s->mLodFaceList[l]));
+#endif
+            dest.lodIndexData = writeArray(lodIndexData);
+            dest.boneAssignments = writeBoneAssignments(s->getBoneAssignments());
+
+            std::vector<float> extremityPoints;
+            for (size_t p = 0; p < s->extremityPoints.size(); ++p)
+                extremityPoints.insert(extremityPoints.end(), s->extremityPoints[p].ptr(),
+                                       s->extremityPoints[p].ptr() + 3);
+            dest.extremityPoints = writeArray(extremityPoints);
+            dest.extremityPoints.count /= 3;
+        }
+
+        std::vector<SubMeshName> subMeshNames;
+        const Mesh::SubMeshNameMap& nameMap = pMesh->getSubMeshNameMap();
+        for (Mesh::SubMeshNameMap::const_iterator it = nameMap.begin(); it != nameMap.end(); ++it)
+        {
+            SubMeshName name = {writeString(it->first), it->second};
+            subMeshNames.push_back(name);
+        }
+
+        if (pMesh->hasSkeleton())
+        {
+            header.skeletonName = writeString(pMesh->getSkeletonName());
+            header.boneAssignments = writeBoneAssignments(pMesh->getBoneAssignments());
+        }
+
+        std::vector<BakedMeshFormat::LodLevel> lodLevels;
+        for (unsigned short i = 0; i < pMesh->getNumLodLevels(); ++i)
+        {
+            const MeshLodUsage& usage = pMesh->mMeshLodUsageList[i];
+            BakedMeshFormat::LodLevel level = {static_cast<float>(usage.userValue), NO_INDEX,
+                                               writeString(usage.manualName)};
+            // manual levels get their edge lists from the manual mesh
+            if (pMesh->isEdgeListBuilt() && usage.manualName.empty() && usage.edgeData)
+                level.edgeList = writeEdgeList(usage.edgeData);
+            lodLevels.push_back(level);
+        }
+#if !OGRE_NO_MESHLOD
+        if (pMesh->getNumLodLevels() > 1)
+            header.lodStrategyName = writeString(pMesh->getLodStrategy()->getName());
+#endif
+
+        const Vector3& min = pMesh->getBounds().getMinimum();
+        const Vector3& max = pMesh->getBounds().getMaximum();
+        for (int i = 0; i < 3; ++i)
+        {
+            header.boundsMin[i] = static_cast<float>(min[i]);
+            header.boundsMax[i] = static_cast<float>(max[i]);
+        }
+        header.boundRadius = static_cast<float>(pMesh->getBoundingSphereRadius());
+
+        header.poses = writePoses(pMesh);
+        header.animations = writeAnimations(pMesh);
+        header.vertexData = writeArray(mVertexData);
+        header.indexBuffers = writeArray(mIndexBuffers);
+        header.subMeshes = writeArray(subMeshes);
+        header.subMeshNames = writeArray(subMeshNames);
+        header.lodLevels = writeArray(lodLevels);
+        header.edgeLists = writeArray(mEdgeLists);
+
+        header.fileSize = static_cast<uint32>(mBuffer.size());
+        memcpy(&mBuffer[0], &header, sizeof(header));
+        stream->write(&mBuffer[0], mBuffer.size());
+
+        // release the copy of the mesh
+        std::vector<uchar>().swap(mBuffer);
+
+        LogManager::getSingleton().logMessage("MeshSerializer export successful.");
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerBakedImpl::allocate(size_t bytes, size_t alignment)
+    {
+        size_t offset = (mBuffer.size() + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > MAX_FILE_SIZE)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "The mesh is too large for the baked format",
+                        "MeshSerializerBakedImpl::exportMesh");
+        // zero the padding, so the output only depends on the mesh
+        mBuffer.resize(offset + bytes);
+        return offset;
+    }
+    //---------------------------------------------------------------------
+    template <typename T> BakedMeshFormat::Range MeshSerializerBakedImpl::writeArray(const std::vector<T>& elems)
+    {
+        Range range = {0, static_cast<uint32>(elems.size())};
+        if (!elems.empty())
+        {
+            range.offset = static_cast<uint32>(allocate(elems.size() * sizeof(T), DATA_ALIGNMENT));
+            memcpy(&mBuffer[range.offset], &elems[0], elems.size() * sizeof(T));
+        }
+        return range;
+    }
+    //---------------------------------------------------------------------
+    BakedMeshFormat::Range MeshSerializerBakedImpl::writeString(const String& str)
+    {
+        Range range = {0, static_cast<uint32>(str.size())};
+        if (!str.empty())
+        {
+            range.offset = static_cast<uint32>(allocate(str.size(), 1));
+            memcpy(&mBuffer[range.offset], str.data(), str.size());
+        }
+        return range;
+    }
+    //---------------------------------------------------------------------
+    uint32 MeshSerializerBakedImpl::writeVertexData(const Ogre::VertexData* vertexData)
+    {
+        std::vector<BakedMeshFormat::VertexElement> elements;
+        const VertexDeclaration::VertexElementList& elemList =
+            vertexData->vertexDeclaration->getElements();
+        for (VertexDeclaration::VertexElementList::const_iterator it = elemList.begin();
+             it != elemList.end(); ++it)
+        {
+            BakedMeshFormat::VertexElement elem = {
+                it->getSource(), static_cast<uint16>(it->getType()),
+                static_cast<uint16>(it->getSemantic()), static_cast<uint16>(it->getOffset()),
+                it->getIndex(), 0};
+            elements.push_back(elem);
+        }
+
+        std::vector<VertexBuffer> buffers;
+        const VertexBufferBinding::VertexBufferBindingMap& bindings =
+            vertexData->vertexBufferBinding->getBindings();
+        for (VertexBufferBinding::VertexBufferBindingMap::const_iterator it = bindings.begin();
+             it != bindings.end(); ++it)
+        {
+            const HardwareVertexBufferSharedPtr& vbuf = it->second;
+            // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
+            size_t bytes = vbuf->getVertexSize() * vertexData->vertexCount;
+            VertexBuffer buffer = {it->first, static_cast<uint16>(vbuf->getVertexSize()),
+                                   static_cast<uint32>(allocate(bytes, DATA_ALIGNMENT))};
+            if (bytes > 0)
+                vbuf->readData(0, bytes, &mBuffer[buffer.data]);
+            buffers.push_back(buffer);
+        }
+
+        BakedMeshFormat::VertexData dest = {static_cast<uint32>(vertexData->vertexCount),
+                                            writeArray(elements), writeArray(buffers)};
+        mVertexData.push_back(dest);
+        return static_cast<uint32>(mVertexData.size() - 1);
+    }
+    //---------------------------------------------------------------------
+    uint32 MeshSerializerBakedImpl::writeIndexBuffer(const HardwareIndexBufferSharedPtr& ibuf)
+    {
+        // LOD levels may share their buffers
+        std::map<const HardwareIndexBuffer*, uint32>::iterator it = mIndexBufferIndices.find(ibuf.get());
+        if (it != mIndexBufferIndices.end())
+            return it->second;
+
+        IndexBuffer buffer = {static_cast<uint32>(ibuf->getIndexSize()),
+                              static_cast<uint32>(ibuf->getNumIndexes()),
+                              static_cast<uint32>(allocate(ibuf->getSizeInBytes(), DATA_ALIGNMENT))};
+        if (ibuf->getSizeInBytes() > 0)
+            ibuf->readData(0, ibuf->getSizeInBytes(), &mBuffer[buffer.data]);
+        mIndexBuffers.push_back(buffer);
+
+        uint32 index = static_cast<uint32>(mIndexBuffers.size() - 1);
+        mIndexBufferIndices[ibuf.get()] = index;
+        return index;
+    }
+    //---------------------------------------------------------------------
+    BakedMeshFormat::IndexData MeshSerializerBakedImpl::writeIndexData(const Ogre::IndexData* indexData)
+    {
+        BakedMeshFormat::IndexData dest = {static_cast<uint32>(indexData->indexStart),
+                                           static_cast<uint32>(indexData->indexCount), NO_INDEX};
+        if (indexData->indexBuffer)
+            dest.buffer = writeIndexBuffer(indexData->indexBuffer);
+        return dest;
+    }
+    //---------------------------------------------------------------------
+    BakedMeshFormat::Range MeshSerializerBakedImpl::writeBoneAssignments(
+        const std::multimap<size_t, VertexBoneAssignment>& assignments)
+    {
+        std::vector<BoneAssignment> dest;
+        dest.reserve(assignments.size());
+        for (std::multimap<size_t, VertexBoneAssignment>::const_iterator it = assignments.begin();
+             it != assignments.end(); ++it)
+        {
+            BoneAssignment assign = {it->second.vertexIndex, it->second.boneIndex, 0,
+                                     static_cast<float>(it->second.weight)};
+            dest.push_back(assign);
+        }
+        return writeArray(dest);
+    }
+    //---------------------------------------------------------------------
+    uint32 MeshSerializerBakedImpl::writeEdgeList(const EdgeData* edgeData)
+    {
+        std::vector<EdgeTriangle> triangles(edgeData->triangles.size());
+        std::vector<float> faceNormals(edgeData->triangleFaceNormals.size() * 4);
+        for (size_t t = 0; t < triangles.size(); ++t)
+        {
+            const EdgeData::Triangle& tri = edgeData->triangles[t];
+            triangles[t].indexSet = static_cast<uint32>(tri.indexSet);
+            triangles[t].vertexSet = static_cast<uint32>(tri.vertexSet);
+            for (int i = 0; i < 3; ++i)
+            {
+                triangles[t].vertIndex[i] = static_cast<uint32>(tri.vertIndex[i]);
+                triangles[t].sharedVertIndex[i] = static_cast<uint32>(tri.sharedVertIndex[i]);
+            }
+        }
+        for (size_t t = 0; t < edgeData->triangleFaceNormals.size(); ++t)
+        {
+            for (int i = 0; i < 4; ++i)
+                faceNormals[t * 4 + i] = static_cast<float>(edgeData->triangleFaceNormals[t][i]);
+        }
+
+        std::vector<EdgeGroup> edgeGroups;
+        for (EdgeData::EdgeGroupList::const_iterator gi = edgeData->edgeGroups.begin();
+             gi != edgeData->edgeGroups.end(); ++gi)
+        {
+            std::vector<BakedMeshFormat::Edge> edges(gi->edges.size());
+            for (size_t e = 0; e < edges.size(); ++e)
+            {
+                const EdgeData::Edge& edge = gi->edges[e];
+                for (int i = 0; i < 2; ++i)
+                {
+                    edges[e].triIndex[i] = static_cast<uint32>(edge.triIndex[i]);
+                    edges[e].vertIndex[i] = static_cast<uint32>(edge.vertIndex[i]);
+                    edges[e].sharedVertIndex[i] = static_cast<uint32>(edge.sharedVertIndex[i]);
+                }
+                edges[e].degenerate = edge.degenerate;
+            }
+            EdgeGroup group = {static_cast<uint32>(gi->vertexSet), static_cast<uint32>(gi->triStart),
+                               static_cast<uint32>(gi->triCount), writeArray(edges)};
+            edgeGroups.push_back(group);
+        }
+
+        EdgeList dest = {edgeData->isClosed, writeArray(triangles), writeArray(faceNormals),
+                         writeArray(edgeGroups)};
+        dest.faceNormals.count /= 4;
+        mEdgeLists.push_back(dest);
+        return static_cast<uint32>(mEdgeLists.size() - 1);
+    }
+    //---------------------------------------------------------------------
+    BakedMeshFormat::Range MeshSerializerBakedImpl::writePoses(const Mesh* pMesh)
+    {
+        std::vector<BakedMeshFormat::Pose> poses;
+        const PoseList& poseList = pMesh->getPoseList();
+        for (PoseList::const_iterator it = poseList.begin(); it != poseList.end(); ++it)
+        {
+            const Ogre::Pose* pose = *it;
+            bool includesNormals = !pose->getNormals().empty();
+
+            std::vector<PoseVertex> vertices;
+            Ogre::Pose::NormalsMap::const_iterator nit = pose->getNormals().begin();
+            const Ogre::Pose::VertexOffsetMap& offsets = pose->getVertexOffsets();
+            for (Ogre::Pose::VertexOffsetMap::const_iterator vit = offsets.begin(); vit != offsets.end(); ++vit)
+            {
+                PoseVertex vertex;
+                memset(&vertex, 0, sizeof(vertex));
+                vertex.index = static_cast<uint32>(vit->first);
+                for (int i = 0; i < 3; ++i)
+                    vertex.offset[i] = static_cast<float>(vit->second[i]);
+                if (includesNormals)
+                {
+                    for (int i = 0; i < 3; ++i)
+                        vertex.normal[i] = static_cast<float>(nit->second[i]);
+                    ++nit;
+                }
+                vertices.push_back(vertex);
+            }
+
+            BakedMeshFormat::Pose dest = {writeString(pose->getName()), pose->getTarget(),
+                                          includesNormals, writeArray(vertices)};
+            poses.push_back(dest);
+        }
+        return writeArray(poses);
+    }
+    //---------------------------------------------------------------------
+    BakedMeshFormat::Range MeshSerializerBakedImpl::writeAnimations(const Mesh* pMesh)
+    {
+        std::vector<BakedMeshFormat::Animation> animations;
+        for (unsigned short a = 0; a < pMesh->getNumAnimations(); ++a)
+        {
+            const Ogre::Animation* anim = pMesh->getAnimation(a);
+
+            std::vector<BakedMeshFormat::AnimationTrack> tracks;
+            const Ogre::Animation::VertexTrackList& trackList = anim->_getVertexTrackList();
+            for (Ogre::Animation::VertexTrackList::const_iterator it = trackList.begin();
+                 it != trackList.end(); ++it)
+            {
+                const VertexAnimationTrack* track = it->second;
+
+                std::vector<BakedMeshFormat::KeyFrame> keyFrames;
+                for (unsigned short k = 0; k < track->getNumKeyFrames(); ++k)
+                {
+                    BakedMeshFormat::KeyFrame keyFrame;
+                    memset(&keyFrame, 0, sizeof(keyFrame));
+                    if (track->getAnimationType() == VAT_MORPH)
+                    {
+                        const VertexMorphKeyFrame* kf = track->getVertexMorphKeyFrame(k);
+                        keyFrame.time = static_cast<float>(kf->getTime());
+                        keyFrame.includesNormals = kf->getVertexBuffer()->getVertexSize() > sizeof(float) * 3;
+
+                        // float x,y,z[,nx,ny,nz] by number of vertices in original geometry
+                        size_t count = track->getAssociatedVertexData()->vertexCount *
+                                       (keyFrame.includesNormals ? 6 : 3);
+                        keyFrame.vertices.count = static_cast<uint32>(count);
+                        keyFrame.vertices.offset =
+                            static_cast<uint32>(allocate(count * sizeof(float), DATA_ALIGNMENT));
+                        if (count > 0)
+                            kf->getVertexBuffer()->readData(0, count * sizeof(float),
+                                                            &mBuffer[keyFrame.vertices.offset]);
+                    }
+                    else // VAT_POSE
+                    {
+                        const VertexPoseKeyFrame* kf = track->getVertexPoseKeyFrame(k);
+                        keyFrame.time = static_cast<float>(kf->getTime());
+
+                        std::vector<BakedMeshFormat::PoseRef> poseRefs;
+                        const VertexPoseKeyFrame::PoseRefList& refList = kf->getPoseReferences();
+                        for (size_t r = 0; r < refList.size(); ++r)
+                        {
+                            BakedMeshFormat::PoseRef poseRef = {refList[r].poseIndex, 0,
+                                                                static_cast<float>(refList[r].influence)};
+                            poseRefs.push_back(poseRef);
+                        }
+                        keyFrame.poseRefs = writeArray(poseRefs);
+                    }
+                    keyFrames.push_back(keyFrame);
+                }
+
+                BakedMeshFormat::AnimationTrack dest = {static_cast<uint16>(track->getAnimationType()),
+                                                        track->getHandle(), writeArray(keyFrames)};
+                tracks.push_back(dest);
+            }
+
+            BakedMeshFormat::Animation dest = {
+                writeString(anim->getName()), static_cast<float>(anim->getLength()),
+                anim->getUseBaseKeyFrame(), static_cast<float>(anim->getBaseKeyFrameTime()),
+                writeString(anim->getBaseKeyFrameAnimationName()), writeArray(tracks)};
+            animations.push_back(dest);
+        }
+        return writeArray(animations);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerBakedImpl::importMesh(const DataStreamPtr& stream, Mesh* pMesh,
+                                             MeshSerializerListener* listener)
+    {
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Baked meshes are only supported on little endian "
+                    "platforms", "MeshSerializerBakedImpl::importMesh");
+#endif
+        // use memory (and memory mapped) streams in place, read anything else at once
+        DataStreamPtr memStream = stream;
+        if (!dynamic_cast<MemoryDataStream*>(stream.get()))
+            memStream.reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+        MemoryDataStream* mem = static_cast<MemoryDataStream*>(memStream.get());
+        mData = mem->getCurrentPtr();
+        mSize = mem->size() - mem->tell();
+
+        mHeader = reinterpret_cast<const Header*>(mData);
+        if (mSize < sizeof(Header) || mHeader->magic != MAGIC)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Not a baked mesh: " + stream->getName(),
+                        "MeshSerializerBakedImpl::importMesh");
+        if (mHeader->version != VERSION)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Unsupported baked mesh version " + StringConverter::toString(mHeader->version) +
+                            "; bake " + stream->getName() + " again with the OgreMeshUpgrader tool",
+                        "MeshSerializerBakedImpl::importMesh");
+        if (mHeader->fileSize > mSize)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Truncated baked mesh: " + stream->getName(),
+                        "MeshSerializerBakedImpl::importMesh");
+        mSize = mHeader->fileSize;
+        const Header& header = *mHeader;
+
+        // Never automatically build edge lists, like the classic format
+        pMesh->mAutoBuildEdgeLists = false;
+
+        // Upload the index buffers straight from the file
+        const IndexBuffer* srcIndexBuffers = getArray<IndexBuffer>(header.indexBuffers);
+        std::vector<HardwareIndexBufferSharedPtr> indexBuffers(header.indexBuffers.count);
+        for (uint32 i = 0; i < header.indexBuffers.count; ++i)
+        {
+            const IndexBuffer& src = srcIndexBuffers[i];
+            if (src.indexSize != 2 && src.indexSize != 4)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: invalid index size",
+                            "MeshSerializerBakedImpl::importMesh");
+            indexBuffers[i] = pMesh->getHardwareBufferManager()->createIndexBuffer(
+                src.indexSize == 4 ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+                src.numIndexes, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
+            Range data = {src.data, src.numIndexes * src.indexSize};
+            if (data.count > 0)
+                indexBuffers[i]->writeData(0, data.count, getArray<uchar>(data), true);
+        }
+
+        if (header.sharedVertexData != NO_INDEX)
+            pMesh->sharedVertexData = readVertexData(pMesh, header.sharedVertexData);
+
+        const BakedMeshFormat::SubMesh* subMeshes = getArray<BakedMeshFormat::SubMesh>(header.subMeshes);
+        for (uint32 i = 0; i < header.subMeshes.count; ++i)
+        {
+            const BakedMeshFormat::SubMesh& src = subMeshes[i];
+            Ogre::SubMesh* sm = pMesh->createSubMesh();
+
+            String materialName = getString(src.materialName);
+            if (listener)
+                listener->processMaterialName(pMesh, &materialName);
+            sm->setMaterialName(materialName, pMesh->getGroup());
+
+            sm->operationType = static_cast<RenderOperation::OperationType>(src.operationType);
+            sm->useSharedVertices = src.vertexData == NO_INDEX;
+            if (sm->useSharedVertices && !pMesh->sharedVertexData)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: no shared vertices",
+                            "MeshSerializerBakedImpl::importMesh");
+            if (!sm->useSharedVertices)
+                sm->vertexData = readVertexData(pMesh, src.vertexData);
+            readIndexData(sm->indexData, src.indexData, indexBuffers);
+
+            VertexBoneAssignment assign;
+            const BoneAssignment* assignments = getArray<BoneAssignment>(src.boneAssignments);
+            for (uint32 a = 0; a < src.boneAssignments.count; ++a)
+            {
+                assign.vertexIndex = assignments[a].vertexIndex;
+                assign.boneIndex = assignments[a].boneIndex;
+                assign.weight = assignments[a].weight;
+                sm->addBoneAssignment(assign);
+            }
+
+            const float* points = getArray<float>(Range{src.extremityPoints.offset,
+                                                        src.extremityPoints.count * 3});
+            for (uint32 p = 0; p < src.extremityPoints.count; ++p)
+                sm->extremityPoints.push_back(Vector3(points[p * 3], points[p * 3 + 1], points[p * 3 + 2]));
+        }
+
+        const SubMeshName* subMeshNames = getArray<SubMeshName>(header.subMeshNames);
+        for (uint32 i = 0; i < header.subMeshNames.count; ++i)
+        {
+            checkIndex(subMeshNames[i].subMesh, pMesh->getNumSubMeshes());
+            pMesh->nameSubMesh(getString(subMeshNames[i].name),
+                               static_cast<ushort>(subMeshNames[i].subMesh));
+        }
+
+        if (header.skeletonName.count > 0)
+        {
+            String skelName = getString(header.skeletonName);
+            if (listener)
+                listener->processSkeletonName(pMesh, &skelName);
+            pMesh->setSkeletonName(skelName);
+        }
+
+        VertexBoneAssignment assign;
+        const BoneAssignment* assignments = getArray<BoneAssignment>(header.boneAssignments);
+        for (uint32 a = 0; a < header.boneAssignments.count; ++a)
+        {
+            assign.vertexIndex = assignments[a].vertexIndex;
+            assign.boneIndex = assignments[a].boneIndex;
+            assign.weight = assignments[a].weight;
+            pMesh->addBoneAssignment(assign);
+        }
+
+        pMesh->_setBounds(AxisAlignedBox(Vector3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]),
+                                         Vector3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2])),
+                          false);
+        pMesh->_setBoundingSphereRadius(header.boundRadius);
+
+        const BakedMeshFormat::LodLevel* lodLevels = getArray<BakedMeshFormat::LodLevel>(header.lodLevels);
+#if !OGRE_NO_MESHLOD
+        if (header.lodLevels.count > 1)
+        {
+            LodStrategy* strategy =
+                LodStrategyManager::getSingleton().getStrategy(getString(header.lodStrategyName));
+            // Check that valid strategy name was given, otherwise use default
+            if (strategy == 0)
+                strategy = LodStrategyManager::getSingleton().getDefaultStrategy();
+            pMesh->setLodStrategy(strategy);
+
+            pMesh->mNumLods = static_cast<ushort>(header.lodLevels.count);
+            pMesh->mMeshLodUsageList.resize(pMesh->mNumLods);
+            for (ushort lodID = 1; lodID < pMesh->mNumLods; ++lodID)
+            {
+                MeshLodUsage& usage = pMesh->mMeshLodUsageList[lodID];
+                usage.userValue = lodLevels[lodID].userValue;
+                usage.manualName = getString(lodLevels[lodID].manualName);
+                if (!usage.manualName.empty())
+                    pMesh->mHasManualLodLevel = true;
+                usage.manualMesh.reset(); // will trigger load later with manual Lod
+                usage.edgeData = NULL;
+            }
+
+            for (uint32 i = 0; i < header.subMeshes.count; ++i)
+            {
+                Ogre::SubMesh* sm = pMesh->getSubMesh(i);
+                if (subMeshes[i].lodIndexData.count != header.lodLevels.count - 1)
+                    OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: LOD levels missing",
+                                "MeshSerializerBakedImpl::importMesh");
+                const BakedMeshFormat::IndexData* lodIndexData =
+                    getArray<BakedMeshFormat::IndexData>(subMeshes[i].lodIndexData);
+                sm->mLodFaceList.resize(pMesh->mNumLods - 1);
+                for (ushort lodID = 1; lodID < pMesh->mNumLods; ++lodID)
+                {
+                    sm->mLodFaceList[lodID - 1] = OGRE_NEW Ogre::IndexData();
+                    // manual levels are rendered with the manual mesh
+                    if (pMesh->mMeshLodUsageList[lodID].manualName.empty())
+                        readIndexData(sm->mLodFaceList[lodID - 1], lodIndexData[lodID - 1], indexBuffers);
+                }
+            }
+        }
+#endif
+
+        // Edge lists of the levels we know, others will be connected up by Mesh on demand
+        for (ushort lodID = 0; lodID < std::min<size_t>(header.lodLevels.count, pMesh->mNumLods); ++lodID)
+        {
+            if (lodLevels[lodID].edgeList != NO_INDEX)
+                pMesh->mMeshLodUsageList[lodID].edgeData = readEdgeList(pMesh, lodLevels[lodID].edgeList);
+        }
+        if (header.edgeLists.count > 0)
+            pMesh->mEdgeListsBuilt = true;
+
+        readPoses(pMesh);
+        readAnimations(pMesh);
+
+        mData = NULL;
+        mHeader = NULL;
+    }
+    //---------------------------------------------------------------------
+    template <typename T> const T* MeshSerializerBakedImpl::getArray(const Range& range) const
+    {
+        if (range.count == 0)
+            return NULL;
+        if (range.offset % DATA_ALIGNMENT != 0 || uint64(range.offset) + uint64(range.count) * sizeof(T) > mSize)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: array out of range",
+                        "MeshSerializerBakedImpl::importMesh");
+        return reinterpret_cast<const T*>(mData + range.offset);
+    }
+    //---------------------------------------------------------------------
+    String MeshSerializerBakedImpl::getString(const Range& range) const
+    {
+        if (uint64(range.offset) + range.count > mSize)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: string out of range",
+                        "MeshSerializerBakedImpl::importMesh");
+        return String(reinterpret_cast<const char*>(mData + range.offset), range.count);
+    }
+    //---------------------------------------------------------------------
+    Ogre::VertexData* MeshSerializerBakedImpl::readVertexData(Mesh* pMesh, uint32 index) const
+    {
+        checkIndex(index, mHeader->vertexData.count);
+        const BakedMeshFormat::VertexData& src = getArray<BakedMeshFormat::VertexData>(mHeader->vertexData)[index];
+        const BakedMeshFormat::VertexElement* elements = getArray<BakedMeshFormat::VertexElement>(src.elements);
+        const VertexBuffer* buffers = getArray<VertexBuffer>(src.buffers);
+
+        Ogre::VertexData* dest = OGRE_NEW Ogre::VertexData();
+        dest->vertexStart = 0;
+        dest->vertexCount = src.vertexCount;
+        for (uint32 i = 0; i < src.elements.count; ++i)
+        {
+            const BakedMeshFormat::VertexElement& elem = elements[i];
+            dest->vertexDeclaration->addElement(elem.source, elem.offset,
+                                                static_cast<VertexElementType>(elem.type),
+                                                static_cast<VertexElementSemantic>(elem.semantic), elem.index);
+        }
+
+        for (uint32 i = 0; i < src.buffers.count; ++i)
+        {
+            const VertexBuffer& buffer = buffers[i];
+            // Check that vertex size agrees
+            if (dest->vertexDeclaration->getVertexSize(buffer.bindIndex) != buffer.vertexSize)
+            {
+                OGRE_DELETE dest;
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Buffer vertex size does not agree with vertex declaration",
+                            "MeshSerializerBakedImpl::importMesh");
+            }
+
+            HardwareVertexBufferSharedPtr vbuf = pMesh->getHardwareBufferManager()->createVertexBuffer(
+                buffer.vertexSize, dest->vertexCount, pMesh->mVertexBufferUsage,
+                pMesh->mVertexBufferShadowBuffer);
+            Range data = {buffer.data, static_cast<uint32>(vbuf->getSizeInBytes())};
+            if (data.count > 0)
+                vbuf->writeData(0, data.count, getArray<uchar>(data), true);
+            dest->vertexBufferBinding->setBinding(buffer.bindIndex, vbuf);
+        }
+
+        // Perform any necessary colour conversion for an active rendersystem
+        if (Root::getSingletonPtr() && Root::getSingleton().getRenderSystem())
+        {
+            // We don't know the source type if it's VET_COLOUR, but assume ARGB
+            // since that's the most common. Won't get used unless the mesh is
+            // ambiguous anyway, which will have been warned about in the log
+            dest->convertPackedColour(VET_COLOUR_ARGB, Ogre::VertexElement::getBestColourVertexElementType());
+        }
+        return dest;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerBakedImpl::readIndexData(Ogre::IndexData* dest, const BakedMeshFormat::IndexData& src,
+                                                const std::vector<HardwareIndexBufferSharedPtr>& indexBuffers) const
+    {
+        dest->indexStart = src.indexStart;
+        dest->indexCount = src.indexCount;
+        if (src.buffer != NO_INDEX)
+        {
+            checkIndex(src.buffer, indexBuffers.size());
+            dest->indexBuffer = indexBuffers[src.buffer];
+        }
+    }
+    //---------------------------------------------------------------------
+    EdgeData* MeshSerializerBakedImpl::readEdgeList(Mesh* pMesh, uint32 index) const
+    {
+        checkIndex(index, mHeader->edgeLists.count);
+        const EdgeList& src = getArray<EdgeList>(mHeader->edgeLists)[index];
+        const EdgeTriangle* triangles = getArray<EdgeTriangle>(src.triangles);
+        const float* faceNormals = getArray<float>(Range{src.faceNormals.offset, src.faceNormals.count * 4});
+        const EdgeGroup* edgeGroups = getArray<EdgeGroup>(src.edgeGroups);
+        if (src.faceNormals.count != src.triangles.count)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: face normals missing",
+                        "MeshSerializerBakedImpl::importMesh");
+
+        EdgeData* edgeData = OGRE_NEW EdgeData();
+        edgeData->isClosed = src.isClosed != 0;
+        edgeData->triangles.resize(src.triangles.count);
+        edgeData->triangleFaceNormals.resize(src.triangles.count);
+        edgeData->triangleLightFacings.resize(src.triangles.count);
+        for (uint32 t = 0; t < src.triangles.count; ++t)
+        {
+            EdgeData::Triangle& tri = edgeData->triangles[t];
+            tri.indexSet = triangles[t].indexSet;
+            tri.vertexSet = triangles[t].vertexSet;
+            for (int i = 0; i < 3; ++i)
+            {
+                tri.vertIndex[i] = triangles[t].vertIndex[i];
+                tri.sharedVertIndex[i] = triangles[t].sharedVertIndex[i];
+            }
+            edgeData->triangleFaceNormals[t] = Vector4(faceNormals[t * 4], faceNormals[t * 4 + 1],
+                                                       faceNormals[t * 4 + 2], faceNormals[t * 4 + 3]);
+        }
+
+        edgeData->edgeGroups.resize(src.edgeGroups.count);
+        for (uint32 g = 0; g < src.edgeGroups.count; ++g)
+        {
+            EdgeData::EdgeGroup& edgeGroup = edgeData->edgeGroups[g];
+            edgeGroup.vertexSet = edgeGroups[g].vertexSet;
+            edgeGroup.triStart = edgeGroups[g].triStart;
+            edgeGroup.triCount = edgeGroups[g].triCount;
+
+            const BakedMeshFormat::Edge* edges = getArray<BakedMeshFormat::Edge>(edgeGroups[g].edges);
+            edgeGroup.edges.resize(edgeGroups[g].edges.count);
+            for (uint32 e = 0; e < edgeGroups[g].edges.count; ++e)
+            {
+                EdgeData::Edge& edge = edgeGroup.edges[e];
+                for (int i = 0; i < 2; ++i)
+                {
+                    edge.triIndex[i] = edges[e].triIndex[i];
+                    edge.vertIndex[i] = edges[e].vertIndex[i];
+                    edge.sharedVertIndex[i] = edges[e].sharedVertIndex[i];
+                }
+                edge.degenerate = edges[e].degenerate != 0;
+            }
+
+            // Populate edgeGroup.vertexData pointers
+            // If there is shared vertex data, vertexSet 0 is that,
+            // otherwise 0 is first dedicated
+            size_t subMesh = pMesh->sharedVertexData ? edgeGroup.vertexSet - 1 : edgeGroup.vertexSet;
+            if (pMesh->sharedVertexData && edgeGroup.vertexSet == 0)
+            {
+                edgeGroup.vertexData = pMesh->sharedVertexData;
+            }
+            else
+            {
+                checkIndex(static_cast<uint32>(subMesh), pMesh->getNumSubMeshes());
+                edgeGroup.vertexData = pMesh->getSubMesh(subMesh)->vertexData;
+            }
+        }
+        return edgeData;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerBakedImpl::readPoses(Mesh* pMesh) const
+    {
+        const BakedMeshFormat::Pose* poses = getArray<BakedMeshFormat::Pose>(mHeader->poses);
+        for (uint32 p = 0; p < mHeader->poses.count; ++p)
+        {
+            const BakedMeshFormat::Pose& src = poses[p];
+            Ogre::Pose* pose = pMesh->createPose(src.target, getString(src.name));
+
+            const PoseVertex* vertices = getArray<PoseVertex>(src.vertices);
+            for (uint32 v = 0; v < src.vertices.count; ++v)
+            {
+                const PoseVertex& vertex = vertices[v];
+                Vector3 offset(vertex.offset[0], vertex.offset[1], vertex.offset[2]);
+                if (src.includesNormals)
+                    pose->addVertex(vertex.index, offset,
+                                    Vector3(vertex.normal[0], vertex.normal[1], vertex.normal[2]));
+                else
+                    pose->addVertex(vertex.index, offset);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerBakedImpl::readAnimations(Mesh* pMesh) const
+    {
+        const BakedMeshFormat::Animation* animations = getArray<BakedMeshFormat::Animation>(mHeader->animations);
+        for (uint32 a = 0; a < mHeader->animations.count; ++a)
+        {
+            const BakedMeshFormat::Animation& src = animations[a];
+            Ogre::Animation* anim = pMesh->createAnimation(getString(src.name), src.length);
+            if (src.useBaseKeyFrame)
+                anim->setUseBaseKeyFrame(true, src.baseKeyFrameTime, getString(src.baseAnimationName));
+
+            const BakedMeshFormat::AnimationTrack* tracks = getArray<BakedMeshFormat::AnimationTrack>(src.tracks);
+            for (uint32 t = 0; t < src.tracks.count; ++t)
+            {
+                checkIndex(tracks[t].handle, pMesh->getNumSubMeshes() + 1u);
+                VertexAnimationType animType = static_cast<VertexAnimationType>(tracks[t].type);
+                VertexAnimationTrack* track = anim->createVertexTrack(
+                    tracks[t].handle, pMesh->getVertexDataByTrackHandle(tracks[t].handle), animType);
+                if (!track->getAssociatedVertexData())
+                    OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: invalid track target",
+                                "MeshSerializerBakedImpl::importMesh");
+
+                const BakedMeshFormat::KeyFrame* keyFrames = getArray<BakedMeshFormat::KeyFrame>(tracks[t].keyFrames);
+                for (uint32 k = 0; k < tracks[t].keyFrames.count; ++k)
+                {
+                    const BakedMeshFormat::KeyFrame& keyFrame = keyFrames[k];
+                    if (animType == VAT_MORPH)
+                    {
+                        VertexMorphKeyFrame* kf = track->createVertexMorphKeyFrame(keyFrame.time);
+
+                        // Create buffer, allow read and use shadow buffer
+                        size_t vertexCount = track->getAssociatedVertexData()->vertexCount;
+                        size_t vertexSize = sizeof(float) * (keyFrame.includesNormals ? 6 : 3);
+                        if (keyFrame.vertices.count * sizeof(float) != vertexCount * vertexSize)
+                            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Corrupted baked mesh: keyframe size "
+                                        "does not agree with the vertex count",
+                                        "MeshSerializerBakedImpl::importMesh");
+                        HardwareVertexBufferSharedPtr vbuf = pMesh->getHardwareBufferManager()->createVertexBuffer(
+                            vertexSize, vertexCount, HardwareBuffer::HBU_STATIC, true);
+                        if (keyFrame.vertices.count > 0)
+                            vbuf->writeData(0, vbuf->getSizeInBytes(), getArray<float>(keyFrame.vertices), true);
+                        kf->setVertexBuffer(vbuf);
+                    }
+                    else // VAT_POSE
+                    {
+                        VertexPoseKeyFrame* kf = track->createVertexPoseKeyFrame(keyFrame.time);
+                        const BakedMeshFormat::PoseRef* poseRefs = getArray<BakedMeshFormat::PoseRef>(keyFrame.poseRefs);
+                        for (uint32 r = 0; r < keyFrame.poseRefs.count; ++r)
+                            kf->addPoseReference(poseRefs[r].poseIndex, poseRefs[r].influence);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,303 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __MeshSerializerBaked_H__
+#define __MeshSerializerBaked_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreVertexBoneAssignment.h"
+
+namespace Ogre {
+
+    class MeshSerializerListener;
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+    /** Layout of the baked .mesh container.
+
+    The file is a little endian image of the structures below. The Header is at
+    offset 0, everything else is referenced by a Range holding a byte offset from
+    the start of the file and an element count, so no pointers need to be fixed
+    up after loading. Arrays start at a multiple of DATA_ALIGNMENT, so vertex and
+    index data can be uploaded straight from a memory mapped file.
+    */
+    namespace BakedMeshFormat
+    {
+        /// "OGBM", which never matches the chunk id of the classic format
+        const uint32 MAGIC = 0x4D42474F;
+        /// Increase on every layout change, there is no backwards compatibility
+        const uint32 VERSION = 1;
+        const uint32 NO_INDEX = 0xFFFFFFFF;
+        const size_t DATA_ALIGNMENT = 16;
+
+        /// An array or string in the file
+        struct Range
+        {
+            uint32 offset;
+            uint32 count;
+        };
+
+        struct Header
+        {
+            uint32 magic;
+            uint32 version;
+            uint32 fileSize;
+            /// Index into vertexData, or NO_INDEX
+            uint32 sharedVertexData;
+            float boundsMin[3];
+            float boundsMax[3];
+            float boundRadius;
+            Range skeletonName;
+            Range lodStrategyName;
+            Range vertexData;       ///< VertexData
+            Range indexBuffers;     ///< IndexBuffer
+            Range subMeshes;        ///< SubMesh
+            Range subMeshNames;     ///< SubMeshName
+            Range boneAssignments;  ///< BoneAssignment of the shared vertices
+            Range lodLevels;        ///< LodLevel, including the full detail level
+            Range edgeLists;        ///< EdgeList
+            Range poses;            ///< Pose
+            Range animations;       ///< Animation
+        };
+
+        struct VertexElement
+        {
+            uint16 source;
+            uint16 type;
+            uint16 semantic;
+            uint16 offset;
+            uint16 index;
+            uint16 reserved;
+        };
+
+        /// Holds vertexSize * VertexData::vertexCount bytes
+        struct VertexBuffer
+        {
+            uint16 bindIndex;
+            uint16 vertexSize;
+            uint32 data;
+        };
+
+        struct VertexData
+        {
+            uint32 vertexCount;
+            Range elements;         ///< VertexElement
+            Range buffers;          ///< VertexBuffer
+        };
+
+        struct IndexBuffer
+        {
+            /// 2 or 4 bytes
+            uint32 indexSize;
+            uint32 numIndexes;
+            uint32 data;
+        };
+
+        struct IndexData
+        {
+            uint32 indexStart;
+            uint32 indexCount;
+            /// Index into indexBuffers, or NO_INDEX
+            uint32 buffer;
+        };
+
+        struct BoneAssignment
+        {
+            uint32 vertexIndex;
+            uint16 boneIndex;
+            uint16 reserved;
+            float weight;
+        };
+
+        struct SubMesh
+        {
+            Range materialName;
+            uint32 operationType;
+            /// Index into vertexData, or NO_INDEX to use the shared vertices
+            uint32 vertexData;
+            IndexData indexData;
+            Range lodIndexData;     ///< IndexData for every LOD level but the first
+            Range boneAssignments;  ///< BoneAssignment
+            Range extremityPoints;  ///< float[3]
+        };
+
+        struct SubMeshName
+        {
+            Range name;
+            uint32 subMesh;
+        };
+
+        struct LodLevel
+        {
+            float userValue;
+            /// Index into edgeLists, or NO_INDEX
+            uint32 edgeList;
+            /// Empty for generated levels
+            Range manualName;
+        };
+
+        struct EdgeList
+        {
+            uint32 isClosed;
+            Range triangles;        ///< EdgeTriangle
+            Range faceNormals;      ///< float[4]
+            Range edgeGroups;       ///< EdgeGroup
+        };
+
+        struct EdgeTriangle
+        {
+            uint32 indexSet;
+            uint32 vertexSet;
+            uint32 vertIndex[3];
+            uint32 sharedVertIndex[3];
+        };
+
+        struct EdgeGroup
+        {
+            uint32 vertexSet;
+            uint32 triStart;
+            uint32 triCount;
+            Range edges;            ///< Edge
+        };
+
+        struct Edge
+        {
+            uint32 triIndex[2];
+            uint32 vertIndex[2];
+            uint32 sharedVertIndex[2];
+            uint32 degenerate;
+        };
+
+        struct Pose
+        {
+            Range name;
+            uint16 target;
+            uint16 includesNormals;
+            Range vertices;         ///< PoseVertex
+        };
+
+        struct PoseVertex
+        {
+            uint32 index;
+            float offset[3];
+            /// Only valid if the pose includes normals
+            float normal[3];
+        };
+
+        struct Animation
+        {
+            Range name;
+            float length;
+            uint32 useBaseKeyFrame;
+            float baseKeyFrameTime;
+            Range baseAnimationName;
+            Range tracks;           ///< AnimationTrack
+        };
+
+        struct AnimationTrack
+        {
+            uint16 type;
+            uint16 handle;
+            Range keyFrames;        ///< KeyFrame
+        };
+
+        struct KeyFrame
+        {
+            float time;
+            uint32 includesNormals;
+            Range vertices;         ///< float, 3 or 6 per vertex of morph keyframes
+            Range poseRefs;         ///< PoseRef of pose keyframes
+        };
+
+        struct PoseRef
+        {
+            uint16 poseIndex;
+            uint16 reserved;
+            float influence;
+        };
+    }
+
+    /** Internal implementation of Mesh reading / writing for the baked .mesh container.
+
+    The baked container is meant for shipping meshes that are loaded often. It
+    is read in place from memory (or memory mapped) streams and does not need
+    to be parsed chunk by chunk like the classic format.
+    */
+    class _OgrePrivate MeshSerializerBakedImpl : public SerializerAlloc
+    {
+    public:
+        /// Whether the stream, which must be at its start, holds a baked mesh
+        static bool isBakedMesh(const DataStreamPtr& stream);
+
+        void exportMesh(const Mesh* pMesh, const DataStreamPtr& stream);
+        void importMesh(const DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener* listener);
+
+    private:
+        typedef BakedMeshFormat::Range Range;
+
+        template <typename T> Range writeArray(const std::vector<T>& elems);
+        Range writeString(const String& str);
+        size_t allocate(size_t bytes, size_t alignment);
+        uint32 writeVertexData(const VertexData* vertexData);
+        uint32 writeIndexBuffer(const HardwareIndexBufferSharedPtr& ibuf);
+        BakedMeshFormat::IndexData writeIndexData(const Ogre::IndexData* indexData);
+        Range writeBoneAssignments(const std::multimap<size_t, VertexBoneAssignment>& assignments);
+        uint32 writeEdgeList(const EdgeData* edgeData);
+        Range writePoses(const Mesh* pMesh);
+        Range writeAnimations(const Mesh* pMesh);
+
+        template <typename T> const T* getArray(const Range& range) const;
+        String getString(const Range& range) const;
+        VertexData* readVertexData(Mesh* pMesh, uint32 index) const;
+        void readIndexData(Ogre::IndexData* dest, const BakedMeshFormat::IndexData& src,
+                           const std::vector<HardwareIndexBufferSharedPtr>& indexBuffers) const;
+        EdgeData* readEdgeList(Mesh* pMesh, uint32 index) const;
+        void readPoses(Mesh* pMesh) const;
+        void readAnimations(Mesh* pMesh) const;
+
+        /// The file being written
+        std::vector<uchar> mBuffer;
+        std::map<const HardwareIndexBuffer*, uint32> mIndexBufferIndices;
+        std::vector<BakedMeshFormat::VertexData> mVertexData;
+        std::vector<BakedMeshFormat::IndexBuffer> mIndexBuffers;
+        std::vector<BakedMeshFormat::EdgeList> mEdgeLists;
+
+        /// The file being read
+        const uchar* mData;
+        size_t mSize;
+        const BakedMeshFormat::Header* mHeader;
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -30,6 +30,17 @@ THE SOFTWARE.
 namespace Ogre {
 
     Node::QueuedUpdates Node::msQueuedUpdates;
+
+    namespace
+    {
+        /// Node::_update of this node collects the children to update instead of updating them
+        struct DeferredChildUpdate
+        {
+            const Node* node;
+            Node::PendingUpdateList* children;
+        };
+        thread_local DeferredChildUpdate tlsDeferredChildUpdate = {NULL, NULL};
+    }
     //-----------------------------------------------------------------------
     Node::Node() : Node(BLANKSTRING) {}
     //-----------------------------------------------------------------------
@@ -166,7 +177,23 @@ namespace Ogre {
 
         if(updateChildren)
         {
-            if (mNeedChildUpdate || parentHasChanged)
+            if (tlsDeferredChildUpdate.node == this)
+            {
+                // called from _updateDeferChildren
+                PendingUpdateList& children = *tlsDeferredChildUpdate.children;
+                tlsDeferredChildUpdate.node = NULL;
+                if (mNeedChildUpdate || parentHasChanged)
+                {
+                    for (auto child : mChildren)
+                        children.push_back(std::make_pair(child, true));
+                }
+                else
+                {
+                    for (auto child : mChildrenToUpdate)
+                        children.push_back(std::make_pair(child, false));
+                }
+            }
+            else if (mNeedChildUpdate || parentHasChanged)
             {
                 ChildNodeMap::iterator it, itend;
                 itend = mChildren.end();
@@ -194,6 +221,15 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Node::_updateDeferChildren(bool parentHasChanged, PendingUpdateList& children)
+    {
+        tlsDeferredChildUpdate.node = this;
+        tlsDeferredChildUpdate.children = &children;
+        _update(true, parentHasChanged);
+        // in case an override did not call Node::_update
+        tlsDeferredChildUpdate.node = NULL;
+    }
+    //-----------------------------------------------------------------------
     void Node::_updateFromParent(void) const
     {
         updateFromParentImpl();
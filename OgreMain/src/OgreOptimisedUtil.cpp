@@ -315,12 +315,76 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* boxes,
+            size_t stride,
+            size_t numBoxes,
+            uint32* visibility)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                boxes,
+                stride,
+                numBoxes,
+                visibility);
+            profile.end();
+
+            LogManager::getSingleton().logMessage(StringUtil::format(
+                "OptimisedUtilProfiler: %s - impl %zu = %u avg ticks\n", __FUNCTION__, index, profile.mAvgTicks));
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        virtual void adjustParticleColours(
+            Particle* const* particles,
+            size_t numParticles,
+            const ColourValue& adjust)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->adjustParticleColours(
+                particles,
+                numParticles,
+                adjust);
+            profile.end();
+
+            LogManager::getSingleton().logMessage(StringUtil::format(
+                "OptimisedUtilProfiler: %s - impl %zu = %u avg ticks\n", __FUNCTION__, index, profile.mAvgTicks));
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
     //---------------------------------------------------------------------
     OptimisedUtil* OptimisedUtil::msImplementation = OptimisedUtil::_detectImplementation();
 
+    //---------------------------------------------------------------------
+    OptimisedUtil* OptimisedUtil::getGeneralImplementation(void)
+    {
+        return _getOptimisedUtilGeneral();
+    }
+
     //---------------------------------------------------------------------
     OptimisedUtil* OptimisedUtil::_detectImplementation(void)
     {
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 #include "OgreOptimisedUtil.h"
+#include "OgreParticle.h"
 
 namespace Ogre {
 
@@ -91,6 +92,21 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* boxes,
+            size_t stride,
+            size_t numBoxes,
+            uint32* visibility);
+
+        /// @copydoc OptimisedUtil::adjustParticleColours
+        virtual void adjustParticleColours(
+            Particle* const* particles,
+            size_t numParticles,
+            const ColourValue& adjust);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +380,51 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoxVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* boxes,
+        size_t stride,
+        size_t numBoxes,
+        uint32* visibility)
+    {
+        memset(visibility, 0, (numBoxes + 31) / 32 * sizeof(uint32));
+
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(boxes[i], boxes[stride + i], boxes[2 * stride + i]);
+            Vector3 halfSize(boxes[3 * stride + i], boxes[4 * stride + i], boxes[5 * stride + i]);
+
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                // like Plane::getSide, without Math::Abs on the half size, so that
+                // negative ones (null boxes) are always culled
+                Real dist = planes[p].getDistance(centre);
+                Real maxAbsDist = Math::Abs(planes[p].normal.x) * halfSize.x +
+                                  Math::Abs(planes[p].normal.y) * halfSize.y +
+                                  Math::Abs(planes[p].normal.z) * halfSize.z;
+                visible = !(dist < -maxAbsDist);
+            }
+
+            if (visible)
+                visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::adjustParticleColours(
+        Particle* const* particles,
+        size_t numParticles,
+        const ColourValue& adjust)
+    {
+        for (size_t i = 0; i < numParticles; ++i)
+        {
+            ColourValue& colour = particles[i]->mColour;
+            for (int c = 0; c < 4; ++c)
+                colour[c] = Math::saturate(colour[c] + adjust[c]);
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreParticle.h"
 
 
 #if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
@@ -129,6 +130,21 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* boxes,
+            size_t stride,
+            size_t numBoxes,
+            uint32* visibility);
+
+        /// @copydoc OptimisedUtil::adjustParticleColours
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE adjustParticleColours(
+            Particle* const* particles,
+            size_t numParticles,
+            const ColourValue& adjust);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -268,6 +284,40 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::calculateBoxVisibility
+        virtual void calculateBoxVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* boxes,
+            size_t stride,
+            size_t numBoxes,
+            uint32* visibility)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoxVisibility(
+                planes,
+                numPlanes,
+                boxes,
+                stride,
+                numBoxes,
+                visibility);
+        }
+
+        /// @copydoc OptimisedUtil::adjustParticleColours
+        virtual void adjustParticleColours(
+            Particle* const* particles,
+            size_t numParticles,
+            const ColourValue& adjust)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->adjustParticleColours(
+                particles,
+                numParticles,
+                adjust);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -2132,6 +2182,104 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoxVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* boxes,
+        size_t stride,
+        size_t numBoxes,
+        uint32* visibility)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        memset(visibility, 0, (numBoxes + 31) / 32 * sizeof(uint32));
+
+        const float* cx = boxes;
+        const float* cy = boxes + stride;
+        const float* cz = boxes + 2 * stride;
+        const float* hx = boxes + 3 * stride;
+        const float* hy = boxes + 4 * stride;
+        const float* hz = boxes + 5 * stride;
+
+        size_t numIterations = numBoxes / 4;
+
+        // Four boxes per-iteration, against all planes
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            size_t base = i * 4;
+            __m128 centreX = _mm_loadu_ps(cx + base);
+            __m128 centreY = _mm_loadu_ps(cy + base);
+            __m128 centreZ = _mm_loadu_ps(cz + base);
+            __m128 halfX = _mm_loadu_ps(hx + base);
+            __m128 halfY = _mm_loadu_ps(hy + base);
+            __m128 halfZ = _mm_loadu_ps(hz + base);
+
+            __m128 culled = _mm_setzero_ps();
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                __m128 nx = _mm_set1_ps(planes[p].normal.x);
+                __m128 ny = _mm_set1_ps(planes[p].normal.y);
+                __m128 nz = _mm_set1_ps(planes[p].normal.z);
+
+                // Same order of operations as Plane::getSide(centre, halfSize)
+                __m128 dist = _mm_add_ps(
+                    __MM_DOT3x3_PS(nx, ny, nz, centreX, centreY, centreZ),
+                    _mm_set1_ps(planes[p].d));
+                __m128 maxAbsDist = __MM_DOT3x3_PS(
+                    _mm_set1_ps(Math::Abs(planes[p].normal.x)),
+                    _mm_set1_ps(Math::Abs(planes[p].normal.y)),
+                    _mm_set1_ps(Math::Abs(planes[p].normal.z)),
+                    halfX, halfY, halfZ);
+
+                // dist < -maxAbsDist
+                culled = _mm_or_ps(culled,
+                    _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), maxAbsDist)));
+
+                if (_mm_movemask_ps(culled) == 0xF)
+                    break;
+            }
+
+            uint32 bits = uint32(~_mm_movemask_ps(culled) & 0xF);
+            visibility[base / 32] |= bits << (base % 32);
+        }
+
+        // Dealing with remaining boxes
+        for (size_t i = numIterations * 4; i < numBoxes; ++i)
+        {
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes && visible; ++p)
+            {
+                const Vector3& n = planes[p].normal;
+                Real dist = n.x * cx[i] + n.y * cy[i] + n.z * cz[i] + planes[p].d;
+                Real maxAbsDist = Math::Abs(n.x) * hx[i] + Math::Abs(n.y) * hy[i] + Math::Abs(n.z) * hz[i];
+                visible = !(dist < -maxAbsDist);
+            }
+
+            if (visible)
+                visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::adjustParticleColours(
+        Particle* const* particles,
+        size_t numParticles,
+        const ColourValue& adjust)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        // ColourValue is four packed floats, so all channels are clamped at once
+        const __m128 adj = _mm_loadu_ps(adjust.ptr());
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        for (size_t i = 0; i < numParticles; ++i)
+        {
+            float* colour = particles[i]->mColour.ptr();
+            __m128 v = _mm_add_ps(SSEMemoryAccessor<false>::load(colour), adj);
+            SSEMemoryAccessor<false>::store(colour, _mm_min_ps(_mm_max_ps(v, zero), one));
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
@@ -155,10 +155,10 @@ namespace Ogre {
         // Deallocate all particles
         destroyVisualParticles(0, mParticlePool.size());
         // Free pool items
-        ParticlePool::iterator i;
-        for (i = mParticlePool.begin(); i != mParticlePool.end(); ++i)
+        ParticleBlockList::iterator i;
+        for (i = mParticleBlocks.begin(); i != mParticleBlocks.end(); ++i)
         {
-            OGRE_DELETE *i;
+            OGRE_DELETE [] *i;
         }
 
         if (mRenderer)
@@ -436,13 +436,14 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ParticleSystem::_expire(Real timeElapsed)
     {
-        ActiveParticleList::iterator i, itEnd;
+        ActiveParticleList::iterator i, itEnd, itOut;
         Particle* pParticle;
         ParticleEmitter* pParticleEmitter;
 
         itEnd = mActiveParticles.end();
 
-        for (i = mActiveParticles.begin(); i != itEnd; )
+        // Compact the survivors in place, keeping their relative order
+        for (i = itOut = mActiveParticles.begin(); i != itEnd; ++i)
         {
             pParticle = static_cast<Particle*>(*i);
             if (pParticle->mTimeToLive < timeElapsed)
@@ -454,7 +455,7 @@ namespace Ogre {
                 if (pParticle->mParticleType == Particle::Visual)
                 {
                     // Destroy this one
-                    mFreeParticles.splice(mFreeParticles.end(), mActiveParticles, i++);
+                    mFreeParticles.push_back(pParticle);
                 }
                 else
                 {
@@ -465,19 +466,18 @@ namespace Ogre {
 
                     // Also erase from mActiveEmittedEmitters
                     removeFromActiveEmittedEmitters (pParticleEmitter);
-
-                    // And erase from mActiveParticles
-                    i = mActiveParticles.erase( i );
                 }
             }
             else
             {
                 // Decrement TTL
                 pParticle->mTimeToLive -= timeElapsed;
-                ++i;
+                *itOut++ = pParticle;
             }
 
         }
+
+        mActiveParticles.erase(itOut, itEnd);
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_triggerEmitters(Real timeElapsed)
@@ -655,15 +655,20 @@ namespace Ogre {
     void ParticleSystem::increasePool(size_t size)
     {
         size_t oldSize = mParticlePool.size();
+        if (size <= oldSize)
+            return;
 
         // Increase size
-        mParticlePool.reserve(size);
         mParticlePool.resize(size);
+        mActiveParticles.reserve(size);
+        mFreeParticles.reserve(size);
 
-        // Create new particles
+        // Create new particles in one contiguous block
+        Particle* block = OGRE_NEW Particle[size - oldSize];
+        mParticleBlocks.push_back(block);
         for( size_t i = oldSize; i < size; i++ )
         {
-            mParticlePool[i] = OGRE_NEW Particle();
+            mParticlePool[i] = block++;
         }
 
         if (mIsRendererConfigured)
@@ -672,19 +677,24 @@ namespace Ogre {
         }
 
 
+    }
+    //-----------------------------------------------------------------------
+    const std::list<Particle*>& ParticleSystem::_getActiveParticles()
+    {
+        mActiveParticleListCopy.assign(mActiveParticles.begin(), mActiveParticles.end());
+        return mActiveParticleListCopy;
     }
     //-----------------------------------------------------------------------
     ParticleIterator ParticleSystem::_getIterator(void)
     {
-        return ParticleIterator(mActiveParticles.begin(), mActiveParticles.end());
+        mActiveParticleListCopy.assign(mActiveParticles.begin(), mActiveParticles.end());
+        return ParticleIterator(mActiveParticleListCopy.begin(), mActiveParticleListCopy.end());
     }
     //-----------------------------------------------------------------------
     Particle* ParticleSystem::getParticle(size_t index) 
     {
         assert (index < mActiveParticles.size() && "Index out of bounds!");
-        ActiveParticleList::iterator i = mActiveParticles.begin();
-        std::advance(i, index);
-        return *i;
+        return mActiveParticles[index];
     }
     //-----------------------------------------------------------------------
     Particle* ParticleSystem::createParticle(void)
@@ -693,8 +703,9 @@ namespace Ogre {
         if (!mFreeParticles.empty())
         {
             // Fast creation (don't use superclass since emitter will init)
-            p = mFreeParticles.front();
-            mActiveParticles.splice(mActiveParticles.end(), mFreeParticles, mFreeParticles.begin());
+            p = mFreeParticles.back();
+            mFreeParticles.pop_back();
+            mActiveParticles.push_back(p);
 
             p->_notifyOwner(this);
         }
@@ -1039,8 +1050,13 @@ namespace Ogre {
             mRenderer->_notifyParticleCleared(mActiveParticles);
         }
 
-        // Move actives to free list
-        mFreeParticles.splice(mFreeParticles.end(), mActiveParticles);
+        // Move visual actives to free list, emitted emitters are returned below
+        for (ActiveParticleList::reverse_iterator i = mActiveParticles.rbegin(); i != mActiveParticles.rend(); ++i)
+        {
+            if ((*i)->mParticleType == Particle::Visual)
+                mFreeParticles.push_back(*i);
+        }
+        mActiveParticles.clear();
 
         // Add active emitted emitters to free list
         addActiveEmittedEmittersToFreeList();
@@ -1078,10 +1094,11 @@ namespace Ogre {
         {
             this->increasePool(size);
 
-            for( size_t i = currSize; i < size; ++i )
+            // Add new items to the stack, lowest address on top so that
+            // particles are handed out in memory order
+            for( size_t i = size; i > currSize; --i )
             {
-                // Add new items to the queue
-                mFreeParticles.push_back( mParticlePool[i] );
+                mFreeParticles.push_back( mParticlePool[i - 1] );
             }
 
             // Tell the renderer, if already configured
@@ -41,12 +41,116 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 
 #include "OgreTimer.h"
 
+#include <chrono>
+
 #ifdef USE_REMOTERY
 #include "Remotery.h"
 static Remotery* rmt;
 #endif
 
 namespace Ogre {
+    namespace
+    {
+        /// events per thread, must be a power of two
+        const uint64 TRACE_BUFFER_SIZE = 1 << 16;
+
+        std::atomic<uint32> gTraceSerial(0);
+
+        /// the trace buffer of the calling thread and the Profiler it belongs to
+        struct ThreadTraceCache
+        {
+            uint32 serial;
+            void* buffer;
+
+            ~ThreadTraceCache()
+            {
+                // the thread ends, so its buffer is no longer written
+                Profiler* profiler = Profiler::getSingletonPtr();
+                if (buffer && profiler)
+                    profiler->_releaseThreadTraceBuffer(serial, buffer);
+            }
+        };
+        thread_local ThreadTraceCache tlsTraceCache = {0, NULL};
+
+        void writeTraceTime(std::ostream& stream, uint64 nanoseconds)
+        {
+            // trace_event timestamps are in microseconds
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%llu.%03u", (unsigned long long)(nanoseconds / 1000),
+                     unsigned(nanoseconds % 1000));
+            stream << buf;
+        }
+
+        void writeTraceString(std::ostream& stream, const char* str)
+        {
+            stream << '"';
+            for (; *str; ++str)
+            {
+                if (*str == '"' || *str == '\\')
+                    stream << '\\' << *str;
+                else if ((unsigned char)*str < 0x20)
+                    stream << ' ';
+                else
+                    stream << *str;
+            }
+            stream << '"';
+        }
+
+        const char* getTraceCategory(uint32 groupID)
+        {
+            if (groupID & OGREPROF_CULLING)
+                return "culling";
+            if (groupID & OGREPROF_RENDERING)
+                return "rendering";
+            if (groupID & OGREPROF_GENERAL)
+                return "general";
+            return "user";
+        }
+    }
+
+    struct Profiler::TraceBuffer
+    {
+        struct Event
+        {
+            const ProfileMarker* marker;
+            uint64 begin;
+            uint64 end;
+        };
+
+        /// an Event in the ring buffer, which other threads may read while it is overwritten
+        struct EventSlot
+        {
+            std::atomic<const ProfileMarker*> marker;
+            std::atomic<uint64> begin;
+            std::atomic<uint64> end;
+
+            void store(const ProfileMarker* m, uint64 b, uint64 e)
+            {
+                marker.store(m, std::memory_order_relaxed);
+                begin.store(b, std::memory_order_relaxed);
+                end.store(e, std::memory_order_relaxed);
+            }
+            Event load() const
+            {
+                Event event = {marker.load(std::memory_order_relaxed), begin.load(std::memory_order_relaxed),
+                               end.load(std::memory_order_relaxed)};
+                return event;
+            }
+        };
+
+        /// ring buffer, only written by the owning thread
+        std::vector<EventSlot> events;
+        /// number of events ever recorded
+        std::atomic<uint64> written;
+        uint32 threadIndex;
+        /// whether the owning thread ended
+        bool released;
+
+        explicit TraceBuffer(uint32 index)
+            : events(TRACE_BUFFER_SIZE), written(0), threadIndex(index), released(false)
+        {
+        }
+    };
     //-----------------------------------------------------------------------
     // PROFILE DEFINITIONS
     //-----------------------------------------------------------------------
@@ -78,6 +182,11 @@ namespace Ogre {
         , mMaxTotalFrameTime(0)
         , mAverageFrameTime(0)
         , mResetExtents(false)
+        , mNextTraceThreadIndex(1)
+        , mTraceFrameCount(10)
+        , mTraceEpoch(getTraceTimestamp())
+        , mTraceSerial(++gTraceSerial)
+        , mTraceEnabled(false)
     {
         mRoot.hierarchicalLvl = 0 - 1;
 
@@ -622,4 +731,156 @@ namespace Ogre {
             mListeners.erase(i);
     }
     //-----------------------------------------------------------------------
+    void Profiler::setTraceEnabled(bool enabled)
+    {
+        mTraceEnabled.store(enabled);
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::setTraceFrameCount(size_t frames)
+    {
+        std::lock_guard<std::mutex> lock(mTraceMutex);
+        mTraceFrameCount = std::max<size_t>(frames, 1);
+        while (mTraceFrames.size() > mTraceFrameCount)
+            mTraceFrames.pop_front();
+    }
+    //-----------------------------------------------------------------------
+    uint64 Profiler::getTraceTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    //-----------------------------------------------------------------------
+    Profiler::TraceBuffer* Profiler::getThreadTraceBuffer()
+    {
+        if (tlsTraceCache.serial == mTraceSerial)
+            return static_cast<TraceBuffer*>(tlsTraceCache.buffer);
+
+        std::lock_guard<std::mutex> lock(mTraceMutex);
+        mTraceBuffers.emplace_back(new TraceBuffer(mNextTraceThreadIndex++));
+        tlsTraceCache.serial = mTraceSerial;
+        tlsTraceCache.buffer = mTraceBuffers.back().get();
+        return mTraceBuffers.back().get();
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::_recordTraceEvent(const ProfileMarker* marker, uint64 begin, uint64 end)
+    {
+        TraceBuffer* buffer = getThreadTraceBuffer();
+        uint64 index = buffer->written.load(std::memory_order_relaxed);
+
+        // readers seeing any of the new values also see the slot was reused, see writeChromeTrace
+        std::atomic_thread_fence(std::memory_order_release);
+        buffer->events[index & (TRACE_BUFFER_SIZE - 1)].store(marker, begin, end);
+
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::_markTraceFrame()
+    {
+        if (!getTraceEnabled())
+            return;
+
+        uint64 now = getTraceTimestamp();
+        std::lock_guard<std::mutex> lock(mTraceMutex);
+        mTraceFrames.push_back(now);
+        while (mTraceFrames.size() > mTraceFrameCount)
+            mTraceFrames.pop_front();
+        pruneTraceBuffers();
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::_releaseThreadTraceBuffer(uint32 serial, void* buffer)
+    {
+        if (serial != mTraceSerial)
+            return;
+
+        std::lock_guard<std::mutex> lock(mTraceMutex);
+        static_cast<TraceBuffer*>(buffer)->released = true;
+        pruneTraceBuffers();
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::pruneTraceBuffers()
+    {
+        uint64 windowBegin = mTraceFrames.empty() ? 0 : mTraceFrames.front();
+        TraceBufferList::iterator end =
+            std::remove_if(mTraceBuffers.begin(), mTraceBuffers.end(),
+                           [windowBegin](const std::unique_ptr<TraceBuffer>& buffer) {
+                               if (!buffer->released)
+                                   return false;
+                               uint64 written = buffer->written.load(std::memory_order_relaxed);
+                               return written == 0 ||
+                                      buffer->events[(written - 1) & (TRACE_BUFFER_SIZE - 1)].load().end <= windowBegin;
+                           });
+        mTraceBuffers.erase(end, mTraceBuffers.end());
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::writeChromeTrace(std::ostream& stream) const
+    {
+        std::lock_guard<std::mutex> lock(mTraceMutex);
+        uint64 now = getTraceTimestamp();
+        uint64 windowBegin = mTraceFrames.empty() ? 0 : mTraceFrames.front();
+
+        stream << "{\"traceEvents\":[\n";
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                  "\"args\":{\"name\":\"Frames\"}}";
+
+        for (size_t i = 0; i < mTraceFrames.size(); ++i)
+        {
+            uint64 begin = mTraceFrames[i];
+            uint64 end = i + 1 < mTraceFrames.size() ? mTraceFrames[i + 1] : now;
+            stream << ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":";
+            writeTraceTime(stream, begin - mTraceEpoch);
+            stream << ",\"dur\":";
+            writeTraceTime(stream, end - begin);
+            stream << "}";
+        }
+
+        std::vector<TraceBuffer::Event> events;
+        for (const auto& buffer : mTraceBuffers)
+        {
+            stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                   << buffer->threadIndex << ",\"args\":{\"name\":\"Thread "
+                   << buffer->threadIndex << "\"}}";
+
+            // the owning thread may keep recording while we copy
+            uint64 written = buffer->written.load(std::memory_order_acquire);
+            uint64 first = written > TRACE_BUFFER_SIZE ? written - TRACE_BUFFER_SIZE : 0;
+            events.clear();
+            for (uint64 i = first; i < written; ++i)
+                events.push_back(buffer->events[i & (TRACE_BUFFER_SIZE - 1)].load());
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // drop the events whose slots were reused meanwhile
+            uint64 current = buffer->written.load(std::memory_order_relaxed);
+            uint64 valid = current >= TRACE_BUFFER_SIZE ? current - TRACE_BUFFER_SIZE + 1 : 0;
+
+            for (uint64 i = std::max(first, valid); i < written; ++i)
+            {
+                const TraceBuffer::Event& event = events[i - first];
+                if (event.end <= windowBegin)
+                    continue;
+
+                stream << ",\n{\"name\":";
+                writeTraceString(stream, event.marker->name);
+                stream << ",\"cat\":\"" << getTraceCategory(event.marker->groupID)
+                       << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadIndex << ",\"ts\":";
+                writeTraceTime(stream, event.begin - mTraceEpoch);
+                stream << ",\"dur\":";
+                writeTraceTime(stream, event.end - event.begin);
+                stream << "}";
+            }
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+    //-----------------------------------------------------------------------
+    void Profiler::saveChromeTrace(const String& filename) const
+    {
+        std::ofstream file(filename.c_str());
+        if (!file)
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE, "Cannot open file: " + filename,
+                        "Profiler::saveChromeTrace");
+        }
+        writeChromeTrace(file);
+    }
+    //-----------------------------------------------------------------------
 }
@@ -39,6 +39,7 @@ namespace Ogre {
         : mSplitPassesByLightingType(false)
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
+        , mSortKeysEnabled(false)
         , mRenderableListener(0)
     {
         // Create the 'main' queue up-front since we'll always need that
@@ -165,6 +166,8 @@ namespace Ogre {
             mGroups[groupID].reset(new RenderQueueGroup(this, mSplitPassesByLightingType,
                                                         mSplitNoShadowPasses,
                                                         mShadowCastersCannotBeReceivers));
+            if (mSortKeysEnabled)
+                mGroups[groupID]->setSortKeysEnabled(true);
         }
 
         return mGroups[groupID].get();
@@ -219,6 +222,17 @@ namespace Ogre {
         return mShadowCastersCannotBeReceivers;
     }
     //-----------------------------------------------------------------------
+    void RenderQueue::setSortKeysEnabled(bool enabled)
+    {
+        mSortKeysEnabled = enabled;
+
+        for (size_t i = 0; i < RENDER_QUEUE_COUNT; ++i)
+        {
+            if(mGroups[i])
+                mGroups[i]->setSortKeysEnabled(enabled);
+        }
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::merge( const RenderQueue* rhs )
     {
         for (size_t i = 0; i < RENDER_QUEUE_COUNT; ++i)
@@ -34,6 +34,8 @@ namespace Ogre {
         RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
     RadixSort<QueuedRenderableCollection::RenderablePassList,
         RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
+    RadixSort<QueuedRenderableCollection::RenderablePassList,
+        RenderablePass, uint64> QueuedRenderableCollection::msRadixSorterKeys;
 
 
     //-----------------------------------------------------------------------
@@ -251,8 +253,19 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void RenderPriorityGroup::setSortKeysEnabled(bool enabled)
+    {
+        mSolidsBasic.setSortKeysEnabled(enabled);
+        mSolidsDiffuseSpecular.setSortKeysEnabled(enabled);
+        mSolidsDecal.setSortKeysEnabled(enabled);
+        mSolidsNoShadowReceive.setSortKeysEnabled(enabled);
+        mTransparentsUnsorted.setSortKeysEnabled(enabled);
+        mTransparents.setSortKeysEnabled(enabled);
+    }
+    //-----------------------------------------------------------------------
     void RenderPriorityGroup::sort(const Camera* cam)
     {
+        OgreProfileTrace("RenderPriorityGroup::sort", OGREPROF_RENDERING);
         mSolidsBasic.sort(cam);
         mSolidsDecal.sort(cam);
         mSolidsDiffuseSpecular.sort(cam);
@@ -272,9 +285,17 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
-        :mOrganisationMode(0)
+        :mOrganisationMode(0), mSortKeysEnabled(false)
     {
     }
+    //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::setSortKeysEnabled(bool enabled)
+    {
+        mSortKeysEnabled = enabled;
+        // the pass groups are only needed without sort keys
+        mGrouped.clear();
+        mSortedByPass.clear();
+    }
 
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::clear(void)
@@ -287,8 +308,9 @@ namespace Ogre {
             i->second.clear();
         }
 
-        // Clear sorted list
+        // Clear sorted lists
         mSortedDescending.clear();
+        mSortedByPass.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -305,6 +327,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::sort(const Camera* cam)
     {
+        if (mSortKeysEnabled)
+        {
+            // a single radix sort on packed keys, which computes every key once
+            if (mOrganisationMode & OM_PASS_GROUP)
+                msRadixSorterKeys.sort(mSortedByPass, RadixSortFunctorPassKey());
+            if (mOrganisationMode & OM_SORT_DESCENDING)
+                msRadixSorterKeys.sort(mSortedDescending, RadixSortFunctorDepthKey(cam));
+            return;
+        }
+
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
         // acceptVisitor method, where we iterate in reverse in ascending mode
@@ -349,7 +381,11 @@ namespace Ogre {
             mSortedDescending.push_back(RenderablePass(rend, pass));
         }
 
-        if (mOrganisationMode & OM_PASS_GROUP)
+        if ((mOrganisationMode & OM_PASS_GROUP) && mSortKeysEnabled)
+        {
+            mSortedByPass.push_back(RenderablePass(rend, pass));
+        }
+        else if (mOrganisationMode & OM_PASS_GROUP)
         {
             // Optionally create new pass entry, build a new list
             // Note that this pass and list are never destroyed until the
@@ -386,7 +422,10 @@ namespace Ogre {
         switch(om)
         {
         case OM_PASS_GROUP:
-            acceptVisitorGrouped(visitor);
+            if (mSortKeysEnabled)
+                acceptVisitorSortedByPass(visitor);
+            else
+                acceptVisitorGrouped(visitor);
             break;
         case OM_SORT_DESCENDING:
             acceptVisitorDescending(visitor);
@@ -413,6 +452,23 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::acceptVisitorSortedByPass(
+        QueuedRenderableVisitor* visitor) const
+    {
+        // equal passes are adjacent after sorting, visit them as a group
+        RenderablePassList::const_iterator i, iend;
+        iend = mSortedByPass.end();
+        for (i = mSortedByPass.begin(); i != iend;)
+        {
+            Pass* pass = i->pass;
+            mVisitedGroup.clear();
+            for (; i != iend && i->pass == pass; ++i)
+                mVisitedGroup.push_back(i->renderable);
+
+            visitor->visit(pass, mVisitedGroup);
+        }
+    }
+    //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitorDescending(
         QueuedRenderableVisitor* visitor) const
     {
@@ -443,6 +499,7 @@ namespace Ogre {
     void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
     {
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
+        mSortedByPass.insert( mSortedByPass.end(), rhs.mSortedByPass.begin(), rhs.mSortedByPass.end() );
 
         PassGroupRenderableMap::const_iterator srcGroup;
         for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
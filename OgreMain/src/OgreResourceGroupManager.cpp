@@ -55,7 +55,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mCurrentGroup(0), mParallelPrepare(false)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -264,6 +264,10 @@ namespace Ogre {
                 "ResourceGroupManager::loadResourceGroup");
         }
 
+        // must be done before locking, as the worker threads need to open resources
+        if (loadMainResources && mParallelPrepare)
+            prepareResourcesParallel(grp);
+
         OGRE_LOCK_AUTO_MUTEX;
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
         // Set current group
@@ -347,6 +351,42 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::prepareResourcesParallel(ResourceGroup* grp)
+    {
+        Root* root = Root::getSingletonPtr();
+        if (!root || !root->getWorkQueue())
+            return;
+
+        // take a snapshot, as preparing may change the group ownership
+        std::vector<std::vector<ResourcePtr> > resourcesByOrder;
+        {
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+            for (const auto& o : grp->loadResourceOrderMap)
+                resourcesByOrder.emplace_back(o.second.begin(), o.second.end());
+        }
+
+        // one load order after the other, so dependencies are prepared first
+        for (const auto& resources : resourcesByOrder)
+        {
+            root->getWorkQueue()->parallelFor(resources.size(), [&resources](size_t i) {
+                const ResourcePtr& res = resources[i];
+                // manual loaders are not necessarily thread safe
+                if (res->isManuallyLoaded() || !res->getCreator()->isParallelPrepareSafe())
+                    return;
+
+                try
+                {
+                    res->prepare(true);
+                }
+                catch (Exception&)
+                {
+                    // meshes and textures only keep the prepared data once complete, so loading
+                    // prepares it again on the calling thread and reports the error in order
+                }
+            });
+        }
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
         LogManager::getSingleton().logMessage("Unloading resource group " + name);
@@ -51,6 +51,7 @@ THE SOFTWARE.
 #include "OgreLodStrategyManager.h"
 #include "OgreFileSystemLayer.h"
 #include "OgreSceneLoaderManager.h"
+#include "OgreWorkStealingWorkQueue.h"
 
 #if OGRE_NO_DDS_CODEC == 0
 #include "OgreDDSCodec.h"
@@ -96,7 +97,7 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------
     Root::Root(const String& pluginFileName, const String& configFileName,
-        const String& logFileName)
+        const String& logFileName, bool workStealingQueue)
       : mQueuedEnd(false)
       , mNextFrame(0)
       , mFrameSmoothingTime(0.0f)
@@ -141,7 +142,11 @@ namespace Ogre {
         mResourceGroupManager.reset(new ResourceGroupManager());
 
         // WorkQueue (note: users can replace this if they want)
-        DefaultWorkQueue* defaultQ = OGRE_NEW DefaultWorkQueue("Root");
+        DefaultWorkQueueBase* defaultQ;
+        if (workStealingQueue)
+            defaultQ = OGRE_NEW WorkStealingWorkQueue("Root");
+        else
+            defaultQ = OGRE_NEW DefaultWorkQueue("Root");
         // never process responses in main thread for longer than 10ms by default
         defaultQ->setResponseProcessingTimeLimit(10);
         // match threads to hardware
@@ -716,6 +721,7 @@ namespace Ogre {
     bool Root::_fireFrameStarted(FrameEvent& evt)
     {
         OgreProfileBeginGroup("Frame", OGREPROF_GENERAL);
+        OgreProfileMarkFrame();
         _syncAddedRemovedFrameListeners();
 
         // Tell all listeners
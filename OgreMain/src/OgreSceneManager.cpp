@@ -84,6 +84,8 @@ mIlluminationStage(IRS_NONE),
 mLightClippingInfoMapFrameNumber(999),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mParallelSceneGraphUpdate(false),
+mParallelVisibilityCulling(false),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
@@ -335,12 +337,104 @@ bool SceneManager::lightLess::operator()(const Light* a, const Light* b) const
     return a->tempSquareDist < b->tempSquareDist;
 }
 //-----------------------------------------------------------------------
+void SceneManager::LightGrid::build(const LightList& lights)
+{
+    lightCount = lights.size();
+    enabled = lights.size() >= MIN_LIGHTS;
+    cells.clear();
+    unbounded.clear();
+    if (!enabled)
+        return;
+
+    // cells of twice the typical light range, so most lights overlap 8 cells or less
+    std::vector<Real> ranges;
+    ranges.reserve(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i)
+    {
+        if (lights[i]->getType() != Light::LT_DIRECTIONAL)
+            ranges.push_back(lights[i]->getAttenuationRange());
+    }
+    if (!ranges.empty())
+    {
+        std::nth_element(ranges.begin(), ranges.begin() + ranges.size() / 2, ranges.end());
+        cellSize = 2 * ranges[ranges.size() / 2];
+    }
+    if (!(cellSize > 0))
+        cellSize = 1;
+
+    for (size_t i = 0; i < lights.size(); ++i)
+    {
+        Light* lt = lights[i];
+        // a little larger, so rounding never loses a light touching the query sphere
+        Real range = lt->getAttenuationRange() * 1.001f;
+        int64 minCell[3], maxCell[3];
+        if (lt->getType() == Light::LT_DIRECTIONAL ||
+            !getCellRange(lt->getDerivedPosition(), range, minCell, maxCell))
+        {
+            unbounded.push_back(uint32(i));
+            continue;
+        }
+
+        for (int64 z = minCell[2]; z <= maxCell[2]; ++z)
+            for (int64 y = minCell[1]; y <= maxCell[1]; ++y)
+                for (int64 x = minCell[0]; x <= maxCell[0]; ++x)
+                    cells.push_back(std::make_pair(uint64(x | (y << 21) | (z << 42)), uint32(i)));
+    }
+    std::sort(cells.begin(), cells.end());
+}
+//-----------------------------------------------------------------------
+bool SceneManager::LightGrid::getCellRange(const Vector3& position, Real radius, int64* minCell,
+                                           int64* maxCell) const
+{
+    // 21 bits per axis, biased to be positive
+    const Real maxCoord = Real(1 << 20) - 1;
+    size_t count = 1;
+    for (int a = 0; a < 3; ++a)
+    {
+        Real lo = Math::Clamp(std::floor((position[a] - radius) / cellSize), -maxCoord, maxCoord);
+        Real hi = Math::Clamp(std::floor((position[a] + radius) / cellSize), -maxCoord, maxCoord);
+        if (!(lo <= hi))
+            return false; // NaN
+        minCell[a] = int64(lo) + (1 << 20);
+        maxCell[a] = int64(hi) + (1 << 20);
+        count *= size_t(maxCell[a] - minCell[a] + 1);
+        if (count > MAX_CELLS)
+            return false;
+    }
+    return true;
+}
+//-----------------------------------------------------------------------
+bool SceneManager::LightGrid::query(const Vector3& position, Real radius)
+{
+    int64 minCell[3], maxCell[3];
+    if (!enabled || !getCellRange(position, radius, minCell, maxCell))
+        return false;
+
+    found = unbounded;
+    for (int64 z = minCell[2]; z <= maxCell[2]; ++z)
+    {
+        for (int64 y = minCell[1]; y <= maxCell[1]; ++y)
+        {
+            for (int64 x = minCell[0]; x <= maxCell[0]; ++x)
+            {
+                uint64 key = uint64(x | (y << 21) | (z << 42));
+                std::vector<std::pair<uint64, uint32> >::const_iterator it =
+                    std::lower_bound(cells.begin(), cells.end(), std::make_pair(key, uint32(0)));
+                for (; it != cells.end() && it->first == key; ++it)
+                    found.push_back(it->second);
+            }
+        }
+    }
+
+    // lights overlapping several cells are found several times
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return true;
+}
+//-----------------------------------------------------------------------
 void SceneManager::_populateLightList(const Vector3& position, Real radius, 
                                       LightList& destList, uint32 lightMask)
 {
-    // Really basic trawl of the lights, then sort
-    // Subclasses could do something smarter
-
     // Pick up the lights that affecting frustum only, which should has been
     // cached, so better than take all lights in the scene into account.
     const LightList& candidateLights = _getLightsAffectingFrustum();
@@ -349,10 +443,21 @@ void SceneManager::_populateLightList(const Vector3& position, Real radius,
     destList.clear();
     destList.reserve(candidateLights.size());
 
-    LightList::const_iterator it;
-    for (it = candidateLights.begin(); it != candidateLights.end(); ++it)
+    // With many lights, only test those in the grid cells around the position.
+    // They are tested in the order of the candidate list, so the result is the
+    // same as testing all lights.
+    if (mLightGrid.dirtyCounter != mLightsDirtyCounter ||
+        mLightGrid.lightCount != candidateLights.size())
     {
-        Light* lt = *it;
+        mLightGrid.build(candidateLights);
+        mLightGrid.dirtyCounter = mLightsDirtyCounter;
+    }
+    bool useGrid = mLightGrid.query(position, radius);
+    size_t count = useGrid ? mLightGrid.found.size() : candidateLights.size();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Light* lt = candidateLights[useGrid ? mLightGrid.found[i] : i];
         // check whether or not this light is suppose to be taken into consideration for the current light mask set for this operation
         if(!(lt->getLightMask() & lightMask))
             continue; //skip this light
@@ -1595,6 +1700,7 @@ void SceneManager::_setSkyDome(bool enable, const String& materialName, Real cur
 //-----------------------------------------------------------------------
 void SceneManager::_updateSceneGraph(Camera* cam)
 {
+    OgreProfileTrace("SceneManager::_updateSceneGraph", OGREPROF_GENERAL);
     firePreUpdateSceneGraph(cam);
 
     // Process queued needUpdate calls 
@@ -1604,22 +1710,161 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    if (mParallelSceneGraphUpdate && supportsParallelSceneGraphUpdate())
+        _updateSceneGraphParallel(getRootSceneNode());
+    else
+        getRootSceneNode()->_update(true, false);
 
     firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+void SceneManager::_updateSceneGraphParallel(SceneNode* node)
+{
+    WorkQueue* queue = Root::getSingleton().getWorkQueue();
+
+    // aim for a few subtrees per thread so uneven subtrees still balance out
+    size_t targetSubtrees = 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+
+    // Expand the top of the graph breadth first until there are enough
+    // independent subtrees. Parents are always updated before their children.
+    std::vector<SceneNode*> expanded;
+    Node::PendingUpdateList frontier(1, std::make_pair(static_cast<Node*>(node), false));
+    Node::PendingUpdateList next;
+    while (!frontier.empty() && frontier.size() < targetSubtrees)
+    {
+        next.clear();
+        for (auto& p : frontier)
+        {
+            p.first->_updateDeferChildren(p.second, next);
+            expanded.push_back(static_cast<SceneNode*>(p.first));
+        }
+        frontier.swap(next);
+    }
+
+    if (!frontier.empty())
+    {
+        // contiguous ranges of subtrees per work item
+        size_t numItems = std::min(frontier.size(), targetSubtrees);
+        queue->parallelFor(numItems, [&frontier, numItems](size_t item) {
+            OgreProfileTrace("SceneNode::_update", OGREPROF_GENERAL);
+            size_t begin = frontier.size() * item / numItems;
+            size_t end = frontier.size() * (item + 1) / numItems;
+            for (size_t i = begin; i < end; ++i)
+                frontier[i].first->_update(true, frontier[i].second);
+        });
+    }
+
+    // merge bounds bottom up in child order, exactly like the serial update
+    for (auto it = expanded.rbegin(); it != expanded.rend(); ++it)
+        (*it)->_updateBounds();
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    OgreProfileTrace("SceneManager::_findVisibleObjects", OGREPROF_CULLING);
     // Tell nodes to find, cascade down all nodes
-    getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
-        mDisplayNodes, onlyShadowCasters);
+    if (mParallelVisibilityCulling)
+        _findVisibleObjectsParallel(getRootSceneNode(), cam, visibleBounds, onlyShadowCasters);
+    else
+        getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true,
+            mDisplayNodes, onlyShadowCasters);
+
+}
+//-----------------------------------------------------------------------
+namespace
+{
+    /// Culls the nodes above the given depth, recording a null entry for each subtree left below it
+    void findVisibleTopNodes(SceneNode* node, Camera* cam, size_t depth, SceneNode::VisibleNodeList& nodes,
+                             std::vector<SceneNode*>& subtrees)
+    {
+        if (depth == 0)
+        {
+            subtrees.push_back(node);
+            nodes.push_back(std::make_pair((SceneNode*)NULL, false));
+            return;
+        }
+
+        if (!cam->isVisible(node->_getWorldAABB()))
+            return;
+
+        nodes.push_back(std::make_pair(node, false));
+        for (auto child : node->getChildren())
+            findVisibleTopNodes(static_cast<SceneNode*>(child), cam, depth - 1, nodes, subtrees);
+        nodes.push_back(std::make_pair(node, true));
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::_findVisibleObjectsParallel(SceneNode* node, Camera* cam,
+                                               VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+    // aim for a few subtrees per thread so uneven subtrees still balance out
+    size_t targetSubtrees = 4 * std::max<size_t>(1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+
+    // find the shallowest depth with enough nodes to split the work
+    size_t splitDepth = 0;
+    std::vector<Node*> level(1, node), nextLevel;
+    while (!level.empty() && level.size() < targetSubtrees)
+    {
+        nextLevel.clear();
+        for (auto n : level)
+            nextLevel.insert(nextLevel.end(), n->getChildren().begin(), n->getChildren().end());
+        level.swap(nextLevel);
+        ++splitDepth;
+    }
+
+    if (level.empty())
+    {
+        // too small to be worth it
+        node->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, mDisplayNodes,
+                                  onlyShadowCasters);
+        return;
+    }
 
+    // The frustum planes are updated lazily, so do it now before sharing the camera.
+    // Afterwards Camera::isVisible only reads.
+    cam->getFrustumPlane(FRUSTUM_PLANE_NEAR);
+
+    SceneNode::VisibleNodeList topNodes;
+    std::vector<SceneNode*> subtrees;
+    findVisibleTopNodes(node, cam, splitDepth, topNodes, subtrees);
+
+    std::vector<SceneNode::VisibleNodeList> subtreeNodes(subtrees.size());
+    if (!subtrees.empty())
+    {
+        // contiguous ranges of subtrees per work item
+        size_t numItems = std::min(subtrees.size(), targetSubtrees);
+        Root::getSingleton().getWorkQueue()->parallelFor(
+            numItems, [&subtrees, &subtreeNodes, cam, numItems](size_t item) {
+                OgreProfileTrace("SceneNode::_findVisibleNodes", OGREPROF_CULLING);
+                size_t begin = subtrees.size() * item / numItems;
+                size_t end = subtrees.size() * (item + 1) / numItems;
+                for (size_t i = begin; i < end; ++i)
+                    subtrees[i]->_findVisibleNodes(cam, subtreeNodes[i]);
+            });
+    }
+
+    // queue everything on this thread, in the order of the serial traversal
+    RenderQueue* queue = getRenderQueue();
+    auto nextSubtree = subtreeNodes.begin();
+    for (auto& n : topNodes)
+    {
+        if (n.first)
+        {
+            n.first->_addToRenderQueue(cam, queue, visibleBounds, n.second, mDisplayNodes,
+                                       onlyShadowCasters);
+            continue;
+        }
+
+        for (auto& sn : *nextSubtree++)
+            sn.first->_addToRenderQueue(cam, queue, visibleBounds, sn.second, mDisplayNodes,
+                                        onlyShadowCasters);
+    }
 }
 //-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
+    OgreProfileTrace("SceneManager::_renderVisibleObjects", OGREPROF_RENDERING);
     RenderQueueInvocationSequence* invocationSequence = 
         mCurrentViewport->_getRenderQueueInvocationSequence();
     // Use custom sequence only if we're not doing the texture shadow render
@@ -254,6 +254,55 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    namespace
+    {
+        /// Calls func for each child of node which is visible to the camera, culling them in batches
+        template <typename F> void forEachVisibleChild(SceneNode* node, Camera* cam, const F& func)
+        {
+            const Node::ChildNodeMap& children = node->getChildren();
+            for (size_t begin = 0; begin < children.size(); begin += AxisAlignedBoxBatch::CAPACITY)
+            {
+                size_t count = std::min<size_t>(children.size() - begin, AxisAlignedBoxBatch::CAPACITY);
+
+                AxisAlignedBoxBatch batch;
+                for (size_t i = 0; i < count; ++i)
+                    batch.add(static_cast<SceneNode*>(children[begin + i])->_getWorldAABB());
+                uint32 visible = cam->isVisible(batch);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (visible & (1u << i))
+                        func(static_cast<SceneNode*>(children[begin + i]));
+                }
+            }
+        }
+
+        /// _findVisibleObjects for a node already known to be visible
+        void addVisibleSubtree(SceneNode* node, Camera* cam, RenderQueue* queue,
+            VisibleObjectsBoundsInfo* visibleBounds, bool displayNodes, bool onlyShadowCasters)
+        {
+            node->_addToRenderQueue(cam, queue, visibleBounds, false, displayNodes, onlyShadowCasters);
+
+            forEachVisibleChild(node, cam, [=](SceneNode* child) {
+                addVisibleSubtree(child, cam, queue, visibleBounds, displayNodes, onlyShadowCasters);
+            });
+
+            node->_addToRenderQueue(cam, queue, visibleBounds, true, displayNodes, onlyShadowCasters);
+        }
+
+        /// _findVisibleNodes for a node already known to be visible
+        void findVisibleSubtree(SceneNode* node, Camera* cam, SceneNode::VisibleNodeList& nodes)
+        {
+            nodes.push_back(std::make_pair(node, false));
+
+            forEachVisibleChild(node, cam, [cam, &nodes](SceneNode* child) {
+                findVisibleSubtree(child, cam, nodes);
+            });
+
+            nodes.push_back(std::make_pair(node, true));
+        }
+    }
+    //-----------------------------------------------------------------------
     void SceneNode::_findVisibleObjects(Camera* cam, RenderQueue* queue, 
         VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren, 
         bool displayNodes, bool onlyShadowCasters)
@@ -262,24 +311,35 @@ namespace Ogre {
         if (!cam->isVisible(mWorldAABB))
             return;
 
-        // Add all entities
-        ObjectMap::iterator iobj;
-        ObjectMap::iterator iobjend = mObjectsByName.end();
-        for (iobj = mObjectsByName.begin(); iobj != iobjend; ++iobj)
+        if (includeChildren)
         {
-            MovableObject* mo = *iobj;
-
-            queue->processVisibleObject(mo, cam, onlyShadowCasters, visibleBounds);
+            // children are culled in batches from here on
+            addVisibleSubtree(this, cam, queue, visibleBounds, displayNodes, onlyShadowCasters);
+            return;
         }
 
-        if (includeChildren)
+        _addToRenderQueue(cam, queue, visibleBounds, false, displayNodes, onlyShadowCasters);
+        _addToRenderQueue(cam, queue, visibleBounds, true, displayNodes, onlyShadowCasters);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_findVisibleNodes(Camera* cam, VisibleNodeList& nodes)
+    {
+        if (!cam->isVisible(mWorldAABB))
+            return;
+
+        findVisibleSubtree(this, cam, nodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_addToRenderQueue(Camera* cam, RenderQueue* queue, VisibleObjectsBoundsInfo* visibleBounds,
+        bool leaving, bool displayNodes, bool onlyShadowCasters)
+    {
+        if (!leaving)
         {
-            for (auto child : getChildren())
+            for (auto mo : mObjectsByName)
             {
-                SceneNode* sceneChild = static_cast<SceneNode*>(child);
-                sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
-                    displayNodes, onlyShadowCasters);
+                queue->processVisibleObject(mo, cam, onlyShadowCasters, visibleBounds);
             }
+            return;
         }
 
         if (displayNodes)
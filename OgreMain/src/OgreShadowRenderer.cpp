@@ -781,6 +781,7 @@ void SceneManager::ShadowRenderer::destroyShadowTextures(void)
 //---------------------------------------------------------------------
 void SceneManager::ShadowRenderer::prepareShadowTextures(Camera* cam, Viewport* vp, const LightList* lightList)
 {
+    OgreProfileTrace("ShadowRenderer::prepareShadowTextures", OGREPROF_GENERAL);
     // create shadow textures if needed
     ensureShadowTexturesCreated();
 
@@ -897,6 +898,7 @@ void SceneManager::ShadowRenderer::prepareShadowTextures(Camera* cam, Viewport*
 void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* light,
     const Camera* camera, bool calcScissor)
 {
+    OgreProfileTrace("ShadowRenderer::renderShadowVolumesToStencil", OGREPROF_RENDERING);
     // Get the shadow caster list
     const ShadowCasterList& casters = findShadowCastersForLight(light, camera);
     // Check there are some shadow casters to render
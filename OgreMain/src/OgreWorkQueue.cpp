@@ -29,7 +29,71 @@ THE SOFTWARE.
 #include "OgreWorkQueue.h"
 #include "OgreTimer.h"
 
+#include <thread>
+
 namespace Ogre {
+    namespace
+    {
+        /// Shared between the caller of parallelFor and the helper tasks it spawns
+        struct ParallelForState
+        {
+            const std::function<void(size_t)>& func;
+            size_t count;
+            std::atomic<size_t> next;
+            std::atomic<size_t> done;
+            std::atomic<bool> failed;
+            std::exception_ptr error; // written once by whoever sets failed
+
+            ParallelForState(size_t n, const std::function<void(size_t)>& f)
+                : func(f), count(n), next(0), done(0), failed(false)
+            {
+            }
+
+            void run()
+            {
+                // func is only touched while items are left, i.e. while the caller still waits
+                for (size_t i = next++; i < count; i = next++)
+                {
+                    if (!failed)
+                    {
+                        try
+                        {
+                            func(i);
+                        }
+                        catch (...)
+                        {
+                            bool expected = false;
+                            if (failed.compare_exchange_strong(expected, true))
+                                error = std::current_exception();
+                        }
+                    }
+                    ++done;
+                }
+            }
+        };
+    }
+    //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        if (count == 0)
+            return;
+
+        auto state = std::make_shared<ParallelForState>(count, func);
+
+        // helpers finding no work left just drop their reference to the state
+        size_t helpers = std::min<size_t>(count - 1, OGRE_THREAD_HARDWARE_CONCURRENCY);
+        for (size_t i = 0; i < helpers; ++i)
+            addTask([state]() { state->run(); });
+
+        state->run();
+
+        while (state->done < count)
+            std::this_thread::yield();
+
+        if (state->failed)
+            std::rethrow_exception(state->error);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     uint16 WorkQueue::getChannel(const String& channelName)
     {
@@ -237,6 +301,43 @@ namespace Ogre {
 
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::addTask(std::function<void()> task)
+    {
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            if (mIsRunning && !mShuttingDown && mWorkerThreadCount)
+            {
+                mTaskQueue.push_back(std::move(task));
+                notifyWorkers();
+                return;
+            }
+        }
+#endif
+        task();
+    }
+    //---------------------------------------------------------------------
+    bool DefaultWorkQueueBase::processNextTask()
+    {
+        std::function<void()> task;
+        {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            if (mTaskQueue.empty())
+                return false;
+            task = std::move(mTaskQueue.front());
+            mTaskQueue.pop_front();
+        }
+        task();
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::processRemainingTasks()
+    {
+        // other threads may still wait for these, e.g. in parallelFor
+        while (processNextTask())
+            ;
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestWithRID(WorkQueue::RequestID rid, uint16 channel, 
         uint16 requestType, const Any& rData, uint8 retryCount)
     {
@@ -496,6 +597,10 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void DefaultWorkQueueBase::_processNextRequest()
     {
+        if(processNextTask()){
+            // Tasks take priority over requests.
+            return;
+        }
         if(processIdleRequests()){
             // Found idle requests.
             return;
@@ -543,6 +648,11 @@ namespace Ogre {
         {
             mIdleProcessed = 0;
         }
+        dispatchResponse(r, response, synchronous);
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::dispatchResponse(Request* r, Response* response, bool synchronous)
+    {
         if (response)
         {
             if (!response->succeeded())
@@ -0,0 +1,551 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkStealingWorkQueue.h"
+
+namespace Ogre {
+    namespace
+    {
+        /// The queue and slot the current thread is a worker of
+        thread_local const WorkQueue* tlsQueue = NULL;
+        thread_local size_t tlsSlot = 0;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::Slot::drainInbox()
+    {
+        Job* head = inbox.exchange(NULL, std::memory_order_acquire);
+
+        // the inbox is a stack, so restore the order of submission
+        Job* reversed = NULL;
+        while (head)
+        {
+            Job* next = head->next;
+            head->next = reversed;
+            reversed = head;
+            head = next;
+        }
+
+        for (; reversed; reversed = reversed->next)
+        {
+            if (reversed->request)
+                requests.push_back(reversed);
+            else
+                tasks.push_back(reversed);
+        }
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::WorkStealingWorkQueue(const String& name)
+        : DefaultWorkQueueBase(name)
+        , mNextRequestID(0)
+        , mNextSubmitSlot(0)
+        , mNextWorkerSlot(1)
+        , mPendingTasks(0)
+        , mPendingRequests(0)
+        , mPausedRequests(false)
+        , mResizingSlots(false)
+        , mSleepingWorkers(0)
+        , mNumThreadsRegisteredWithRS(0)
+    {
+        // the shared slot always exists, so requests can be queued before startup
+        mSlots.push_back(OGRE_NEW_T(Slot, MEMCATEGORY_GENERAL)());
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::~WorkStealingWorkQueue()
+    {
+        shutdown();
+
+        for (Slot* slot : mSlots)
+        {
+            slot->drainInbox();
+            for (Job* job : slot->requests)
+            {
+                OGRE_DELETE job->request;
+                OGRE_DELETE_T(job, Job, MEMCATEGORY_GENERAL);
+            }
+            for (Job* job : slot->tasks)
+                OGRE_DELETE_T(job, Job, MEMCATEGORY_GENERAL);
+            OGRE_DELETE_T(slot, Slot, MEMCATEGORY_GENERAL);
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::startup(bool forceRestart)
+    {
+        if (mIsRunning)
+        {
+            if (forceRestart)
+                shutdown();
+            else
+                return;
+        }
+
+        mShuttingDown = false;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') initialising on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+#if OGRE_WORK_STEALING_THREADS
+        mResizingSlots = true;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+            mSlots.push_back(OGRE_NEW_T(Slot, MEMCATEGORY_GENERAL)());
+        mResizingSlots = false;
+
+        if (mWorkerRenderSystemAccess)
+            Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
+
+        mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
+        mNextWorkerSlot = 1;
+        mNumThreadsRegisteredWithRS = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+        {
+            OGRE_THREAD_CREATE(t, *mWorkerFunc);
+            mWorkers.push_back(t);
+        }
+
+        if (mWorkerRenderSystemAccess)
+        {
+            // have to wait until all threads are registered with the render system
+            OGRE_WQ_LOCK_MUTEX_NAMED(mWakeMutex, lock);
+            while (mNumThreadsRegisteredWithRS < mWorkerThreadCount)
+                OGRE_THREAD_WAIT(mWakeCondition, mWakeMutex, lock);
+
+            Root::getSingleton().getRenderSystem()->postExtraThreadsStarted();
+        }
+#endif
+
+        mIsRunning = true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::shutdown()
+    {
+        if (!mIsRunning)
+            return;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') shutting down on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+        {
+            // set under the lock, so no worker misses the wake up
+            OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+            mShuttingDown = true;
+        }
+        abortAllRequests();
+
+#if OGRE_WORK_STEALING_THREADS
+        OGRE_THREAD_NOTIFY_ALL(mWakeCondition);
+        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
+        {
+            (*i)->join();
+            OGRE_THREAD_DESTROY(*i);
+        }
+        mWorkers.clear();
+
+        OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
+        mWorkerFunc = 0;
+
+        // keep what is left in the shared slot, like DefaultWorkQueue keeps its queue
+        mResizingSlots = true;
+        Slot* shared = mSlots[0];
+        shared->drainInbox();
+        for (size_t i = 1; i < mSlots.size(); ++i)
+        {
+            Slot* slot = mSlots[i];
+            slot->drainInbox();
+            shared->tasks.insert(shared->tasks.end(), slot->tasks.begin(), slot->tasks.end());
+            shared->requests.insert(shared->requests.end(), slot->requests.begin(), slot->requests.end());
+            OGRE_DELETE_T(slot, Slot, MEMCATEGORY_GENERAL);
+        }
+        mSlots.resize(1);
+        mResizingSlots = false;
+#endif
+
+        mIsRunning = false;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_threadMain()
+    {
+#if OGRE_WORK_STEALING_THREADS
+        tlsQueue = this;
+        tlsSlot = mNextWorkerSlot++;
+
+        LogManager::getSingleton().stream() << 
+            "WorkStealingWorkQueue('" << getName() << "') - thread " 
+            << OGRE_THREAD_CURRENT_ID << " starting.";
+
+        // Initialise the thread for RS if necessary
+        if (mWorkerRenderSystemAccess)
+        {
+            Root::getSingleton().getRenderSystem()->registerThread();
+
+            OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+            ++mNumThreadsRegisteredWithRS;
+            OGRE_THREAD_NOTIFY_ALL(mWakeCondition);
+        }
+
+        while (!isShuttingDown())
+        {
+            if (!processNextJob())
+                waitForWork();
+        }
+
+        LogManager::getSingleton().stream() << 
+            "WorkStealingWorkQueue('" << getName() << "') - thread " 
+            << OGRE_THREAD_CURRENT_ID << " stopped.";
+
+        tlsQueue = NULL;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_processNextRequest()
+    {
+        processNextJob();
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::processNextJob()
+    {
+        size_t slot = getCurrentSlot();
+
+        // Tasks take priority over requests.
+        Job* job = takeJob(slot, true);
+        if (!job && !mPausedRequests)
+            job = takeJob(slot, false);
+
+        if (job)
+        {
+            processJob(slot, job);
+            return true;
+        }
+
+        // only process idle requests if there is nothing else to do
+        return processIdleRequests();
+    }
+    //---------------------------------------------------------------------
+    size_t WorkStealingWorkQueue::getCurrentSlot() const
+    {
+        return tlsQueue == this ? tlsSlot : 0;
+    }
+    //---------------------------------------------------------------------
+    size_t WorkStealingWorkQueue::getSubmitSlot()
+    {
+        size_t slot = getCurrentSlot();
+        // spread the jobs of other threads over the workers
+        if (slot == 0 && mSlots.size() > 1)
+            slot = 1 + mNextSubmitSlot++ % (mSlots.size() - 1);
+        return slot;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::pushJob(size_t slot, Job* job)
+    {
+        OgreAssertDbg(!mResizingSlots, "jobs must not be added during startup or shutdown");
+        std::atomic<Job*>& inbox = mSlots[slot]->inbox;
+        job->next = inbox.load(std::memory_order_relaxed);
+        while (!inbox.compare_exchange_weak(job->next, job, std::memory_order_release,
+                                            std::memory_order_relaxed))
+            ;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::queueRequest(Request* r)
+    {
+        Job* job = OGRE_NEW_T(Job, MEMCATEGORY_GENERAL)();
+        job->request = r;
+
+        // count before publishing, so hasWork never misses a job
+        ++mPendingRequests;
+        pushJob(getSubmitSlot(), job);
+
+        if (!mPausedRequests)
+            wakeWorkers(false);
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::Job* WorkStealingWorkQueue::takeJob(size_t slot, bool task)
+    {
+        if ((task ? mPendingTasks : mPendingRequests) == 0)
+            return NULL;
+
+        // try our own queue first, then steal the oldest job from the others
+        for (size_t i = 0; i < mSlots.size(); ++i)
+        {
+            size_t v = (slot + i) % mSlots.size();
+            Slot* victim = mSlots[v];
+
+            // always lock in slot order, so workers stealing from each other do not deadlock
+            OGRE_WQ_LOCK_MUTEX(mSlots[std::min(slot, v)]->mutex);
+            OGRE_WQ_LOCK_MUTEX(mSlots[std::max(slot, v)]->mutex);
+
+            victim->drainInbox();
+            std::deque<Job*>& jobs = task ? victim->tasks : victim->requests;
+            if (jobs.empty())
+                continue;
+
+            Job* job = jobs.front();
+            jobs.pop_front();
+            if (task)
+            {
+                --mPendingTasks;
+            }
+            else
+            {
+                // while both slots are locked, so aborting sees the request in either
+                --mPendingRequests;
+                mSlots[slot]->processing.push_back(job->request);
+            }
+            return job;
+        }
+        return NULL;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processJob(size_t slot, Job* job)
+    {
+        if (!job->request)
+        {
+            job->task();
+            OGRE_DELETE_T(job, Job, MEMCATEGORY_GENERAL);
+            return;
+        }
+
+        Request* r = job->request;
+        OGRE_DELETE_T(job, Job, MEMCATEGORY_GENERAL);
+
+        Response* response = processRequest(r);
+
+        Slot* own = mSlots[slot];
+        OGRE_WQ_LOCK_MUTEX(own->mutex);
+        own->processing.erase(std::find(own->processing.begin(), own->processing.end(), r));
+        dispatchResponse(r, response, false);
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::hasWork()
+    {
+        if (mShuttingDown || mPendingTasks || (mPendingRequests && !mPausedRequests))
+            return true;
+
+        OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+        return !mIdleRequestQueue.empty() && !mIdleThreadRunning;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::waitForWork()
+    {
+#if OGRE_WORK_STEALING_THREADS
+        OGRE_WQ_LOCK_MUTEX_NAMED(mWakeMutex, lock);
+        // announce ourselves before checking, so submitters either see a
+        // sleeper or we see their job
+        ++mSleepingWorkers;
+        if (!hasWork())
+            OGRE_THREAD_WAIT(mWakeCondition, mWakeMutex, lock);
+        --mSleepingWorkers;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::wakeWorkers(bool all)
+    {
+        // only take the lock if somebody is actually sleeping
+        if (mSleepingWorkers == 0)
+            return;
+
+        OGRE_WQ_LOCK_MUTEX(mWakeMutex);
+        if (all)
+            OGRE_THREAD_NOTIFY_ALL(mWakeCondition);
+        else
+            OGRE_THREAD_NOTIFY_ONE(mWakeCondition);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyWorkers()
+    {
+        wakeWorkers(false);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID WorkStealingWorkQueue::addRequest(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+    {
+        if (!mAcceptRequests || mShuttingDown)
+            return 0;
+
+        RequestID rid = ++mNextRequestID;
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+
+        LogManager::getSingleton().stream(LML_TRIVIAL) << 
+            "WorkStealingWorkQueue('" << mName << "') - QUEUED(thread:" <<
+            OGRE_THREAD_CURRENT_ID
+            << "): ID=" << rid
+            << " channel=" << channel << " requestType=" << requestType;
+
+#if OGRE_WORK_STEALING_THREADS
+        if (!forceSynchronous && !idleThread)
+        {
+            queueRequest(req);
+            return rid;
+        }
+
+        if (idleThread)
+        {
+            bool wake;
+            {
+                OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                mIdleRequestQueue.push_back(req);
+                wake = !mIdleThreadRunning;
+            }
+            // outside of mIdleMutex, as hasWork locks it while holding mWakeMutex
+            if (wake)
+                notifyWorkers();
+            return rid;
+        }
+#endif
+        processRequestResponse(req, true);
+        return rid;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::addRequestWithRID(WorkQueue::RequestID rid, uint16 channel, 
+        uint16 requestType, const Any& rData, uint8 retryCount)
+    {
+        if (mShuttingDown)
+            return;
+
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+
+        LogManager::getSingleton().stream(LML_TRIVIAL) << 
+            "WorkStealingWorkQueue('" << mName << "') - REQUEUED(thread:" <<
+            OGRE_THREAD_CURRENT_ID
+            << "): ID=" << rid
+            << " channel=" << channel << " requestType=" << requestType;
+#if OGRE_WORK_STEALING_THREADS
+        queueRequest(req);
+#else
+        processRequestResponse(req, true);
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::addTask(std::function<void()> task)
+    {
+#if OGRE_WORK_STEALING_THREADS
+        if (mIsRunning && !mShuttingDown && !mWorkers.empty())
+        {
+            Job* job = OGRE_NEW_T(Job, MEMCATEGORY_GENERAL)();
+            job->request = NULL;
+            job->task = std::move(task);
+
+            ++mPendingTasks;
+            pushJob(getSubmitSlot(), job);
+            wakeWorkers(false);
+            return;
+        }
+#endif
+        task();
+    }
+    //---------------------------------------------------------------------
+    template<typename P>
+    bool WorkStealingWorkQueue::abortInSlots(const P& pred, bool pendingOnly, bool firstOnly,
+                                             size_t lockedSlots)
+    {
+        // hold the locks of all slots in slot order like takeJob, so no request
+        // moves between them while they are searched
+        if (lockedSlots < mSlots.size())
+        {
+            OGRE_WQ_LOCK_MUTEX(mSlots[lockedSlots]->mutex);
+            mSlots[lockedSlots]->drainInbox();
+            return abortInSlots(pred, pendingOnly, firstOnly, lockedSlots + 1);
+        }
+
+        bool found = false;
+        for (Slot* slot : mSlots)
+        {
+            for (Job* job : slot->requests)
+            {
+                if (pred(job->request))
+                {
+                    job->request->abortRequest();
+                    if (firstOnly)
+                        return true;
+                    found = true;
+                }
+            }
+
+            if (pendingOnly)
+                continue;
+
+            for (Request* r : slot->processing)
+            {
+                if (pred(r))
+                {
+                    r->abortRequest();
+                    if (firstOnly)
+                        return true;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequest(RequestID id)
+    {
+        abortInSlots([id](const Request* r) { return r->getID() == id; }, false, true);
+        // idle requests and responses
+        DefaultWorkQueueBase::abortRequest(id);
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::abortPendingRequest(RequestID id)
+    {
+        if (abortInSlots([id](const Request* r) { return r->getID() == id; }, true, true))
+            return true;
+        return DefaultWorkQueueBase::abortPendingRequest(id);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequestsByChannel(uint16 channel)
+    {
+        abortInSlots([channel](const Request* r) { return r->getChannel() == channel; }, false, false);
+        DefaultWorkQueueBase::abortRequestsByChannel(channel);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortPendingRequestsByChannel(uint16 channel)
+    {
+        abortInSlots([channel](const Request* r) { return r->getChannel() == channel; }, true, false);
+        DefaultWorkQueueBase::abortPendingRequestsByChannel(channel);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortAllRequests()
+    {
+        abortInSlots([](const Request*) { return true; }, false, false);
+        DefaultWorkQueueBase::abortAllRequests();
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::setPaused(bool pause)
+    {
+        DefaultWorkQueueBase::setPaused(pause);
+        mPausedRequests = pause;
+        if (!pause)
+            wakeWorkers(true);
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::isPaused() const
+    {
+        return mPausedRequests;
+    }
+}
@@ -35,6 +35,7 @@ THE SOFTWARE.
 
 #include <zzip/zzip.h>
 #include <zzip/plugin.h>
+#include <zlib.h>
 
 #ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
 #   define WIN32_LEAN_AND_MEAN
@@ -96,6 +97,77 @@ namespace {
         time_t getModifiedTime(const String& filename) const;
     };
 
+    /** Zip archive reading straight from a memory mapping of the file.
+    @remarks
+        The central directory is parsed once on load into a hash index. As the
+        archive is immutable afterwards, entries can be opened and inflated by
+        several threads at once without locking. Stored entries are returned
+        without copying, as streams referencing the mapping.
+    */
+    class MappedZipArchive : public Archive
+    {
+        struct Entry
+        {
+            String name;
+            uint64 localHeaderOffset;
+            size_t compressedSize;
+            size_t uncompressedSize;
+            uint16 method;
+            uint16 flags;
+        };
+
+        /// The whole zip file, see MappedFileDataStream
+        MemoryDataStreamPtr mMapping;
+        /// File list in order of the central directory
+        FileInfoList mFileList;
+        /// Entries of mFileList, which are files
+        std::vector<Entry> mEntries;
+        /// Entry index by full name, lower case if not case sensitive
+        std::unordered_map<String, size_t> mIndex;
+#if !OGRE_RESOURCEMANAGER_STRICT
+        /// Entry index by basename, or SIZE_MAX if the basename is ambiguous
+        std::unordered_map<String, size_t> mBasenameIndex;
+#endif
+
+        void parseCentralDirectory();
+        const Entry* findEntry(const String& filename) const;
+    public:
+        MappedZipArchive(const String& name, const String& archType)
+            : Archive(name, archType) {}
+        ~MappedZipArchive() { unload(); }
+
+        bool isCaseSensitive(void) const { return OGRE_RESOURCEMANAGER_STRICT != 0; }
+
+        void load();
+        void unload();
+
+        DataStreamPtr open(const String& filename, bool readOnly = true) const;
+        DataStreamPtr create(const String& filename);
+        void remove(const String& filename);
+
+        StringVectorPtr list(bool recursive = true, bool dirs = false) const;
+        FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false) const;
+        StringVectorPtr find(const String& pattern, bool recursive = true,
+            bool dirs = false) const;
+        FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+            bool dirs = false) const;
+
+        bool exists(const String& filename) const;
+        time_t getModifiedTime(const String& filename) const;
+    };
+
+    /// Stored zip entry, reading directly from the archive mapping
+    class MappedZipDataStream : public MemoryDataStream
+    {
+        /// keeps the mapping alive while the stream is, even if the archive is unloaded
+        MemoryDataStreamPtr mMapping;
+    public:
+        MappedZipDataStream(const String& name, const uchar* data, size_t size, const MemoryDataStreamPtr& mapping)
+            : MemoryDataStream(name, const_cast<uchar*>(data), size, false, true), mMapping(mapping)
+        {
+        }
+    };
+
     /** Specialisation of DataStream to handle streaming data from zip archives. */
     class ZipDataStream : public DataStream
     {
@@ -164,40 +236,6 @@ namespace {
 
         return StringUtil::format("%s '%s'", errorMsg, file.c_str());
     }
-
-#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
-    int wopen_wrapper(const char* filename, int oflag, ...)
-    {
-        int utf16Length = ::MultiByteToWideChar(CP_UTF8, 0, filename, (int)strlen(filename), NULL, 0);
-        if (utf16Length > 0)
-        {
-            std::wstring wt;
-            wt.resize(utf16Length);
-            if (0 != ::MultiByteToWideChar(CP_UTF8, 0, filename, (int)strlen(filename), &wt[0],
-                                           (int)wt.size()))
-                return _wopen(wt.c_str(), oflag);
-        }
-
-        return -1;
-    }
-#endif
-
-    const zzip_plugin_io_handlers* getDefaultIO()
-    {
-        static zzip_plugin_io_handlers defaultIO;
-        static bool isInit = false;
-
-        if (!isInit)
-        {
-            zzip_init_io(&defaultIO, 1);
-#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
-            defaultIO.fd.open = wopen_wrapper;
-#endif
-            isInit = true;
-        }
-
-        return &defaultIO;
-    }
 }
     //-----------------------------------------------------------------------
     ZipArchive::ZipArchive(const String& name, const String& archType, const zzip_plugin_io_handlers* pluginIo)
@@ -525,6 +563,369 @@ namespace {
         mCache.clear();
     }
     //-----------------------------------------------------------------------
+    //  MappedZipArchive
+    //-----------------------------------------------------------------------
+    namespace
+    {
+        // zip records are little endian and unaligned
+        uint16 readUInt16(const uchar* p) { return uint16(p[0] | (p[1] << 8)); }
+        uint32 readUInt32(const uchar* p) { return uint32(readUInt16(p)) | (uint32(readUInt16(p + 2)) << 16); }
+        uint64 readUInt64(const uchar* p) { return uint64(readUInt32(p)) | (uint64(readUInt32(p + 4)) << 32); }
+
+        const uint32 ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+        const uint32 ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+        const uint32 ZIP_END_SIGNATURE = 0x06054b50;
+        const uint32 ZIP64_END_SIGNATURE = 0x06064b50;
+        const uint32 ZIP64_END_LOCATOR_SIGNATURE = 0x07064b50;
+        const size_t ZIP_LOCAL_HEADER_SIZE = 30;
+        const size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+        const size_t ZIP_END_SIZE = 22;
+        const size_t ZIP64_END_LOCATOR_SIZE = 20;
+        const size_t ZIP64_END_SIZE = 56;
+
+        String getIndexKey(const String& name)
+        {
+#if OGRE_RESOURCEMANAGER_STRICT
+            return name;
+#else
+            String key = name;
+            StringUtil::toLowerCase(key);
+            return key;
+#endif
+        }
+    }
+    //-----------------------------------------------------------------------
+    void MappedZipArchive::load()
+    {
+        if (mMapping)
+            return;
+
+#if defined(_OGRE_FILESYSTEM_ARCHIVE_UNICODE) && OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        // the archive path is UTF-8
+        std::wstring path;
+        int utf16Length = ::MultiByteToWideChar(CP_UTF8, 0, mName.c_str(), (int)mName.size(), NULL, 0);
+        if (utf16Length > 0)
+        {
+            path.resize(utf16Length);
+            ::MultiByteToWideChar(CP_UTF8, 0, mName.c_str(), (int)mName.size(), &path[0], (int)path.size());
+        }
+        mMapping.reset(OGRE_NEW MappedFileDataStream(mName, path));
+#else
+        mMapping.reset(OGRE_NEW MappedFileDataStream(mName, mName));
+#endif
+        try
+        {
+            parseCentralDirectory();
+        }
+        catch (...)
+        {
+            unload();
+            throw;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void MappedZipArchive::parseCentralDirectory()
+    {
+        const uchar* data = mMapping->getPtr();
+        const size_t size = mMapping->size();
+
+        if (size < ZIP_END_SIZE)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Zip file is too short '" + mName + "'");
+
+        // the end record is followed by a comment of up to 64k
+        size_t endOffset = size - ZIP_END_SIZE;
+        size_t searchLimit = endOffset > 0xFFFF ? endOffset - 0xFFFF : 0;
+        while (readUInt32(data + endOffset) != ZIP_END_SIGNATURE)
+        {
+            if (endOffset == searchLimit)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                            "Zip-file's central directory record missing. Is this a 7z file '" + mName + "'");
+            --endOffset;
+        }
+
+        uint64 numEntries = readUInt16(data + endOffset + 10);
+        uint64 directorySize = readUInt32(data + endOffset + 12);
+        uint64 directoryOffset = readUInt32(data + endOffset + 16);
+
+        if (endOffset >= ZIP64_END_LOCATOR_SIZE &&
+            readUInt32(data + endOffset - ZIP64_END_LOCATOR_SIZE) == ZIP64_END_LOCATOR_SIGNATURE)
+        {
+            uint64 zip64EndOffset = readUInt64(data + endOffset - ZIP64_END_LOCATOR_SIZE + 8);
+            if (zip64EndOffset > size - ZIP64_END_SIZE ||
+                readUInt32(data + zip64EndOffset) != ZIP64_END_SIGNATURE)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+            numEntries = readUInt64(data + zip64EndOffset + 32);
+            directorySize = readUInt64(data + zip64EndOffset + 40);
+            directoryOffset = readUInt64(data + zip64EndOffset + 48);
+        }
+
+        if (directoryOffset > size || directorySize > size - directoryOffset)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+
+        const uchar* p = data + directoryOffset;
+        const uchar* directoryEnd = p + directorySize;
+        mFileList.reserve(numEntries);
+        mEntries.reserve(numEntries);
+        mIndex.reserve(numEntries);
+        for (uint64 i = 0; i < numEntries; ++i)
+        {
+            if (size_t(directoryEnd - p) < ZIP_CENTRAL_HEADER_SIZE ||
+                readUInt32(p) != ZIP_CENTRAL_HEADER_SIGNATURE)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+
+            uint16 nameLength = readUInt16(p + 28);
+            uint16 extraLength = readUInt16(p + 30);
+            uint16 commentLength = readUInt16(p + 32);
+            const uchar* name = p + ZIP_CENTRAL_HEADER_SIZE;
+            const uchar* extra = name + nameLength;
+            const uchar* next = extra + extraLength + commentLength;
+            if (next > directoryEnd)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+
+            uint64 compressedSize = readUInt32(p + 20);
+            uint64 uncompressedSize = readUInt32(p + 24);
+            uint64 localHeaderOffset = readUInt32(p + 42);
+
+            // sizes and offset which do not fit are moved to the zip64 extra field, in this order
+            for (const uchar* e = extra; e + 4 <= extra + extraLength; e += 4 + readUInt16(e + 2))
+            {
+                if (readUInt16(e) != 0x0001)
+                    continue;
+                const uchar* value = e + 4;
+                const uchar* valueEnd = value + readUInt16(e + 2);
+                if (uncompressedSize == 0xFFFFFFFF && value + 8 <= valueEnd)
+                {
+                    uncompressedSize = readUInt64(value);
+                    value += 8;
+                }
+                if (compressedSize == 0xFFFFFFFF && value + 8 <= valueEnd)
+                {
+                    compressedSize = readUInt64(value);
+                    value += 8;
+                }
+                if (localHeaderOffset == 0xFFFFFFFF && value + 8 <= valueEnd)
+                    localHeaderOffset = readUInt64(value);
+                break;
+            }
+
+            FileInfo info;
+            info.archive = this;
+            info.filename.assign(reinterpret_cast<const char*>(name), nameLength);
+            StringUtil::splitFilename(info.filename, info.basename, info.path);
+            info.compressedSize = static_cast<size_t>(compressedSize);
+            info.uncompressedSize = static_cast<size_t>(uncompressedSize);
+            // folder entries
+            if (info.basename.empty())
+            {
+                info.filename = info.filename.substr (0, info.filename.length () - 1);
+                StringUtil::splitFilename(info.filename, info.basename, info.path);
+                // Set compressed size to -1 for folders; anyway nobody will check
+                // the compressed size of a folder, and if he does, its useless anyway
+                info.compressedSize = size_t (-1);
+            }
+            else
+            {
+                Entry entry;
+                entry.name = info.filename;
+                entry.localHeaderOffset = localHeaderOffset;
+                entry.compressedSize = info.compressedSize;
+                entry.uncompressedSize = info.uncompressedSize;
+                entry.method = readUInt16(p + 10);
+                entry.flags = readUInt16(p + 8);
+
+                mIndex.emplace(getIndexKey(entry.name), mEntries.size());
+#if !OGRE_RESOURCEMANAGER_STRICT
+                auto inserted = mBasenameIndex.emplace(getIndexKey(info.basename), mEntries.size());
+                if (!inserted.second)
+                    inserted.first->second = SIZE_MAX;
+                info.filename = info.basename;
+#endif
+                mEntries.push_back(entry);
+            }
+            mFileList.push_back(info);
+
+            p = next;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void MappedZipArchive::unload()
+    {
+        // streams still open keep their own reference to the mapping
+        mMapping.reset();
+        mFileList.clear();
+        mEntries.clear();
+        mIndex.clear();
+#if !OGRE_RESOURCEMANAGER_STRICT
+        mBasenameIndex.clear();
+#endif
+    }
+    //-----------------------------------------------------------------------
+    const MappedZipArchive::Entry* MappedZipArchive::findEntry(const String& filename) const
+    {
+        auto it = mIndex.find(getIndexKey(filename));
+        if (it != mIndex.end())
+            return &mEntries[it->second];
+
+#if !OGRE_RESOURCEMANAGER_STRICT
+        // Try if we find the file; if there are more files with the same name do not open any
+        String basename, path;
+        StringUtil::splitFilename(filename, basename, path);
+        it = mBasenameIndex.find(getIndexKey(basename));
+        if (it != mBasenameIndex.end() && it->second != SIZE_MAX)
+            return &mEntries[it->second];
+#endif
+        return NULL;
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr MappedZipArchive::open(const String& filename, bool readOnly) const
+    {
+        // no locking needed, as nothing is modified after load
+        const Entry* entry = findEntry(filename);
+        if (!entry)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "File not in archive '" + mName + "'");
+
+        const uchar* data = mMapping->getPtr();
+        const size_t size = mMapping->size();
+
+        if (entry->localHeaderOffset > size - ZIP_LOCAL_HEADER_SIZE ||
+            readUInt32(data + entry->localHeaderOffset) != ZIP_LOCAL_HEADER_SIGNATURE)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+
+        // name and extra field lengths of the local header may differ from the central directory
+        const uchar* header = data + entry->localHeaderOffset;
+        size_t dataOffset = size_t(entry->localHeaderOffset) + ZIP_LOCAL_HEADER_SIZE +
+                            readUInt16(header + 26) + readUInt16(header + 28);
+        if (dataOffset > size || entry->compressedSize > size - dataOffset)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted archive '" + mName + "'");
+
+        // bit 0 flags encryption
+        if (entry->flags & 0x1)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Unsupported compression format '" + mName + "'");
+
+        if (entry->method == 0)
+        {
+            // stored, so just reference the mapping
+            return DataStreamPtr(OGRE_NEW MappedZipDataStream(entry->name, data + dataOffset,
+                                                              entry->uncompressedSize, mMapping));
+        }
+
+        if (entry->method != Z_DEFLATED || entry->compressedSize > UINT_MAX ||
+            entry->uncompressedSize > UINT_MAX)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Unsupported compression format '" + mName + "'");
+
+        MemoryDataStream* stream = OGRE_NEW MemoryDataStream(entry->name, entry->uncompressedSize, true, true);
+        DataStreamPtr ret(stream);
+
+        z_stream zs = {};
+        zs.next_in = const_cast<Bytef*>(data + dataOffset);
+        zs.avail_in = static_cast<uInt>(entry->compressedSize);
+        zs.next_out = stream->getPtr();
+        zs.avail_out = static_cast<uInt>(entry->uncompressedSize);
+
+        // zip entries are raw deflate streams without zlib header
+        int result = inflateInit2(&zs, -MAX_WBITS);
+        if (result == Z_OK)
+        {
+            result = inflate(&zs, Z_FINISH);
+            inflateEnd(&zs);
+        }
+        if (result != Z_STREAM_END || zs.total_out != entry->uncompressedSize)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                        mName + " - error inflating '" + entry->name + "'");
+
+        return ret;
+    }
+    //---------------------------------------------------------------------
+    DataStreamPtr MappedZipArchive::create(const String& filename)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, 
+            "Modification of zipped archives is not supported", 
+            "MappedZipArchive::create");
+    }
+    //---------------------------------------------------------------------
+    void MappedZipArchive::remove(const String& filename)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, 
+            "Modification of zipped archives is not supported", 
+            "MappedZipArchive::remove");
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr MappedZipArchive::list(bool recursive, bool dirs) const
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+        for (const FileInfo& fi : mFileList)
+            if ((dirs == (fi.compressedSize == size_t (-1))) &&
+                (recursive || fi.path.empty()))
+                ret->push_back(fi.filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr MappedZipArchive::listFileInfo(bool recursive, bool dirs) const
+    {
+        FileInfoList* fil = OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)();
+
+        for (const FileInfo& fi : mFileList)
+            if ((dirs == (fi.compressedSize == size_t (-1))) &&
+                (recursive || fi.path.empty()))
+                fil->push_back(fi);
+
+        return FileInfoListPtr(fil, SPFM_DELETE_T);
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr MappedZipArchive::find(const String& pattern, bool recursive, bool dirs) const
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        FileInfoListPtr infos = findFileInfo(pattern, recursive, dirs);
+        for (const FileInfo& fi : *infos)
+            ret->push_back(fi.filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr MappedZipArchive::findFileInfo(const String& pattern, 
+        bool recursive, bool dirs) const
+    {
+        FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+        bool wildCard = pattern.find('*') != String::npos;
+
+        for (const FileInfo& fi : mFileList)
+            if ((dirs == (fi.compressedSize == size_t (-1))) &&
+                (recursive || full_match || wildCard))
+                // Check name matches pattern (zip is case insensitive)
+                if (StringUtil::match(full_match ? fi.filename : fi.basename, pattern, false))
+                    ret->push_back(fi);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    bool MappedZipArchive::exists(const String& filename) const
+    {
+        // same lookup as open, so ambiguous basenames do not exist
+        return findEntry(filename) != NULL;
+    }
+    //---------------------------------------------------------------------
+    time_t MappedZipArchive::getModifiedTime(const String& filename) const
+    {
+        // modification times of individual entries are not tracked, so
+        // just check the mod time of the zip itself
+        struct stat tagStat;
+        bool ret = (stat(mName.c_str(), &tagStat) == 0);
+
+        if (ret)
+        {
+            return tagStat.st_mtime;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    //-----------------------------------------------------------------------
     //  ZipArchiveFactory
     //-----------------------------------------------------------------------
     Archive *ZipArchiveFactory::createInstance( const String& name, bool readOnly )
@@ -532,7 +933,7 @@ namespace {
         if(!readOnly)
             return NULL;
 
-        return OGRE_NEW ZipArchive(name, getType(), getDefaultIO());
+        return OGRE_NEW MappedZipArchive(name, getType());
     }
     //-----------------------------------------------------------------------
     const String& ZipArchiveFactory::getType(void) const
@@ -120,6 +120,7 @@ namespace Ogre
         }
         mWorkers.clear();
 #endif
+        processRemainingTasks();
 
         OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
         mWorkerFunc = 0;
@@ -139,7 +140,7 @@ namespace Ogre
 #if OGRE_THREAD_SUPPORT
         // Lock; note that OGRE_THREAD_WAIT will free the lock
             OGRE_WQ_LOCK_MUTEX_NAMED(mRequestMutex, queueLock);
-        if (mRequestQueue.empty())
+        if (mRequestQueue.empty() && mTaskQueue.empty())
         {
             // frees lock and suspends the thread
             OGRE_THREAD_WAIT(mRequestCondition, mRequestMutex, queueLock);
@@ -123,6 +123,8 @@ namespace Ogre
 
         // wait until all tasks have finished.
         mTaskGroup.wait();
+        // the tasks whose TBB task was cancelled
+        processRemainingTasks();
 
 #if OGRE_NO_TBB_SCHEDULER == 0
         if (mTaskScheduler.is_active())
@@ -148,7 +150,8 @@ namespace Ogre
         //  _notifyThreadRegistered();
         //}
 
-        // Task main function. Process a single request.
+        // Task main function. Every addTask and addRequest spawns one TBB task,
+        // which processes a single task or, if there is none, a single request.
 
         _processNextRequest();
     }
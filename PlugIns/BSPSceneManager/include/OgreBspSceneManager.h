@@ -154,6 +154,9 @@ namespace Ogre {
         /** Creates a specialized BspSceneNode */
         SceneNode * createSceneNodeImpl ( const String &name );
 
+        /** BSP nodes tag the level with their objects while being updated */
+        bool supportsParallelSceneGraphUpdate(void) const { return false; }
+
         /** Internal method for tagging BspNodes with objects which intersect them. */
         void _notifyObjectMoved(const MovableObject* mov, const Vector3& pos);
         /** Internal method for notifying the level that an object has been detached from a node */
@@ -102,6 +102,8 @@ public:
 
     /** Does nothing more */
     virtual void _updateSceneGraph( Camera * cam );
+    /** Octree nodes relocate themselves in the octree while being updated */
+    bool supportsParallelSceneGraphUpdate(void) const { return false; }
     /** Recurses through the octree determining which nodes are visible. */
     virtual void _findVisibleObjects ( Camera * cam, 
         VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
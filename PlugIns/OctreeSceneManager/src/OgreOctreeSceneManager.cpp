@@ -609,20 +609,33 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
             mBoxes.push_back( octant->getWireBoundingBox() );
         }
 
-        bool vis = true;
+        OctreeNode* batchNodes[ AxisAlignedBoxBatch::CAPACITY ];
+        AxisAlignedBoxBatch batch;
+        uint32 visible = ~0u;
 
         while ( it != octant -> mNodes.end() )
         {
-            OctreeNode * sn = *it;
-
             // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
+            // scene nodes attached directly to this level, a batch at a time.
+            size_t count = 0;
+            batch.clear();
+            while ( it != octant -> mNodes.end() && count < AxisAlignedBoxBatch::CAPACITY )
+            {
+                batchNodes[ count++ ] = *it;
+                if ( v == OctreeCamera::PARTIAL )
+                    batch.add( ( *it ) -> _getWorldAABB() );
+                ++it;
+            }
 
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                visible = static_cast< Camera* >( camera ) -> isVisible( batch );
 
-            if ( vis )
+            for ( size_t i = 0; i < count; ++i )
             {
+                if ( !( visible & ( 1u << i ) ) )
+                    continue;
+
+                OctreeNode * sn = batchNodes[ i ];
 
                 mNumObjects++;
                 sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
@@ -636,8 +649,6 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
                 if (sn->getShowBoundingBox() || mShowBoundingBoxes)
                     sn->_addBoundingBoxToQueue(queue);
             }
-
-            ++it;
         }
 
         Octree* child;
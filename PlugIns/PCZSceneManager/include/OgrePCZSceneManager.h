@@ -142,6 +142,8 @@ namespace Ogre
 
         /** Update Scene Graph (does several things now) */
         virtual void _updateSceneGraph( Camera * cam );
+        /** PCZ nodes track their zone membership while being updated */
+        bool supportsParallelSceneGraphUpdate(void) const { return false; }
 
         /** Recurses through the PCZTree determining which nodes are visible. */
         virtual void _findVisibleObjects ( Camera * cam, 
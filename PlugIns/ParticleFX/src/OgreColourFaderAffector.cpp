@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgreOptimisedUtil.h"
 
 
 namespace Ogre {
@@ -77,14 +78,12 @@ namespace Ogre {
         db = mBlueAdj * timeElapsed;
         da = mAlphaAdj * timeElapsed;
 
-        for (auto p : pSystem->_getActiveParticles())
+        const std::vector<Particle*>& particles = pSystem->_getActiveParticleVector();
+        if (!particles.empty())
         {
-            applyAdjustWithClamp(&p->mColour.r, dr);
-            applyAdjustWithClamp(&p->mColour.g, dg);
-            applyAdjustWithClamp(&p->mColour.b, db);
-            applyAdjustWithClamp(&p->mColour.a, da);
+            OptimisedUtil::getImplementation()->adjustParticleColours(
+                &particles[0], particles.size(), ColourValue(dr, dg, db, da));
         }
-
     }
     //-----------------------------------------------------------------------
     void ColourFaderAffector::setAdjust(float red, float green, float blue, float alpha)
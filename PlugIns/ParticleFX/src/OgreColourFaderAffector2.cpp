@@ -115,7 +115,7 @@ namespace Ogre {
         db2 = mBlueAdj2  * timeElapsed;
         da2 = mAlphaAdj2 * timeElapsed;
 
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             if( p->mTimeToLive > StateChangeVal )
             {
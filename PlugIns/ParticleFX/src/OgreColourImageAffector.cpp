@@ -72,7 +72,7 @@ namespace Ogre {
 
         int                width            = (int)mColourImage.getWidth()  - 1;
         
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             const Real      life_time       = p->mTotalTimeToLive;
             Real            particle_time   = 1.0f - (p->mTimeToLive / life_time);
@@ -76,7 +76,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void ColourInterpolatorAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             const Real      life_time       = p->mTotalTimeToLive;
             Real            particle_time   = 1.0f - (p->mTimeToLive / life_time);
@@ -68,7 +68,7 @@ namespace Ogre {
         Real planeDistance = - mPlaneNormal.dotProduct(mPlanePoint) / Math::Sqrt(mPlaneNormal.dotProduct(mPlaneNormal));
         Vector3 directionPart;
 
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             Vector3 direction(p->mDirection * timeElapsed);
             if (mPlaneNormal.dotProduct(p->mPosition + direction) + planeDistance <= 0.0)
@@ -71,7 +71,7 @@ namespace Ogre {
     {
         Real length = 0;
 
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             if (mScope > Math::UnitRandom())
             {
@@ -68,24 +68,24 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void LinearForceAffector::_affectParticles(ParticleSystem* pSystem, Real timeElapsed)
     {
-        Vector3 scaledVector = Vector3::ZERO;
-
-        // Precalc scaled force for optimisation
+        // Branch once per system rather than once per particle
         if (mForceApplication == FA_ADD)
         {
-            // Scale force by time
-            scaledVector = mForceVector * timeElapsed;
-        }
+            // Precalc scaled force for optimisation
+            Vector3 scaledVector = mForceVector * timeElapsed;
 
-        for (auto p : pSystem->_getActiveParticles())
-        {
-            if (mForceApplication == FA_ADD)
+            for (auto p : pSystem->_getActiveParticleVector())
             {
                 p->mDirection += scaledVector;
             }
-            else // FA_AVERAGE
+        }
+        else // FA_AVERAGE
+        {
+            Vector3 halfForce = mForceVector * 0.5f;
+
+            for (auto p : pSystem->_getActiveParticleVector())
             {
-                p->mDirection = (p->mDirection + mForceVector) / 2;
+                p->mDirection = p->mDirection * 0.5f + halfForce;
             }
         }
         
@@ -95,7 +95,7 @@ namespace Ogre {
 
         Radian NewRotation;
 
-        for (auto p : pSystem->_getActiveParticles())
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             NewRotation = p->mRotation + (ds * p->mRotationSpeed);
             p->setRotation( NewRotation );
@@ -63,23 +63,22 @@ namespace Ogre {
 
         Real NewWide, NewHigh;
 
-        for (auto p : pSystem->_getActiveParticles())
+        // Same for every particle without own dimensions
+        Real defaultWide = std::max<Real>(pSystem->getDefaultWidth() + ds, 0);
+        Real defaultHigh = std::max<Real>(pSystem->getDefaultHeight() + ds, 0);
+
+        for (auto p : pSystem->_getActiveParticleVector())
         {
             if( p->hasOwnDimensions() == false )
             {
-                NewWide = pSystem->getDefaultWidth() + ds;
-                NewHigh = pSystem->getDefaultHeight() + ds;
-
+                NewWide = defaultWide;
+                NewHigh = defaultHigh;
             }
             else
             {
-                NewWide = p->getOwnWidth()  + ds;
-                NewHigh = p->getOwnHeight() + ds;
+                NewWide = std::max<Real>(p->getOwnWidth()  + ds, 0);
+                NewHigh = std::max<Real>(p->getOwnHeight() + ds, 0);
             }
-            if (NewWide < 0)
-                NewWide = 0;
-            if (NewHigh < 0)
-                NewHigh = 0;
             p->setDimensions( NewWide, NewHigh ); 
         }
 
@@ -445,7 +445,7 @@ protected:
     void processParticles()
     {
         static int pindex = 0 ;
-        for (auto particle : particleSystem->_getActiveParticles())
+        for (auto particle : particleSystem->_getActiveParticleVector())
         {
             Vector3 ppos = particle->mPosition;
             if (ppos.y<=0 && particle->mTimeToLive>0) { // hits the water!
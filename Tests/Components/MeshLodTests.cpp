@@ -202,3 +202,79 @@ void MeshLodTests::setTestLodConfig(LodConfig& config)
     config.advanced.useBackgroundQueue = false;
 }
 //--------------------------------------------------------------------------
+namespace
+{
+/// the index data of all generated Lod levels
+std::vector<uchar> getLodIndexData(const MeshPtr& mesh)
+{
+    std::vector<uchar> ret;
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        const SubMesh::LODFaceList& lods = mesh->getSubMesh(i)->mLodFaceList;
+        for (size_t l = 0; l < lods.size(); l++)
+        {
+            const HardwareIndexBufferSharedPtr& buf = lods[l]->indexBuffer;
+            size_t indexSize = buf->getIndexSize();
+            const uchar* data = static_cast<const uchar*>(buf->lock(HardwareBuffer::HBL_READ_ONLY));
+            data += lods[l]->indexStart * indexSize;
+            ret.insert(ret.end(), data, data + lods[l]->indexCount * indexSize);
+            buf->unlock();
+        }
+    }
+    return ret;
+}
+
+struct BatchProgress : public LodBatchListener
+{
+    std::vector<size_t> finished;
+    void lodLevelsGenerated(LodConfig& lodConfig, size_t finishedCount, size_t totalCount)
+    {
+        EXPECT_EQ(lodConfig.mesh->getNumLodLevels(), 4);
+        EXPECT_EQ(totalCount, 6u);
+        finished.push_back(finishedCount);
+    }
+};
+}
+
+typedef RootWithoutRenderSystemFixture MeshLodBatchTests;
+TEST_F(MeshLodBatchTests, BatchMatchesSerial)
+{
+    new MeshLodGenerator;
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    mRoot->getWorkQueue()->startup();
+
+    const char* meshNames[] = {"athene.mesh", "knot.mesh", "ogrehead.mesh", "razor.mesh", "RZR-002.mesh",
+                               "tudorhouse.mesh"};
+    std::vector<LodConfig> configs;
+    for (const char* meshName : meshNames)
+    {
+        MeshPtr mesh = MeshManager::getSingleton().load(meshName, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        configs.push_back(LodConfig(mesh));
+        configs.back().createGeneratedLodLevel(10, 0.25);
+        configs.back().createGeneratedLodLevel(20, 0.5);
+        configs.back().createGeneratedLodLevel(30, 0.75);
+        configs.back().advanced.useBackgroundQueue = false;
+    }
+
+    // one mesh after the other
+    std::vector<std::vector<uchar> > serial;
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        gen.generateLodLevels(configs[i]);
+        serial.push_back(getLodIndexData(configs[i].mesh));
+    }
+
+    BatchProgress progress;
+    gen.generateLodLevelsBatch(configs, &progress);
+
+    ASSERT_EQ(progress.finished.size(), configs.size());
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        EXPECT_EQ(progress.finished[i], i + 1);
+        EXPECT_EQ(getLodIndexData(configs[i].mesh), serial[i]) << meshNames[i];
+        configs[i].mesh->unload();
+    }
+
+    OGRE_DELETE MeshLodGenerator::getSingletonPtr();
+}
+//--------------------------------------------------------------------------
@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "OgreShaderFFPColour.h"
 
 #include "OgreShaderFunctionAtom.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreWorkQueue.h"
 
 using namespace Ogre;
 
@@ -55,6 +57,54 @@ struct RTShaderSystem : public RootWithoutRenderSystemFixture
         gpuProgMgr.reset();
         RootWithoutRenderSystemFixture::TearDown();
     }
+
+    /// materials with a few different lighting setups, no textures
+    void createMaterials(int count)
+    {
+        auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+        for (int i = 0; i < count; ++i)
+        {
+            auto mat = static_pointer_cast<Material>(MaterialManager::getSingleton().createOrRetrieve(
+                "TestMat" + StringConverter::toString(i), RGN_DEFAULT).first);
+            auto pass = mat->getTechniques()[0]->getPasses()[0];
+            pass->setLightingEnabled(i % 3 != 0);
+            pass->setFog(i % 5 == 0, FOG_LINEAR);
+            pass->setVertexColourTracking(i % 7 == 0 ? TVC_DIFFUSE : TVC_NONE);
+            shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme");
+        }
+    }
+
+    void validateMaterials(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            RTShader::ShaderGenerator::getSingleton().validateMaterial(
+                "MyScheme", "TestMat" + StringConverter::toString(i), RGN_DEFAULT);
+    }
+
+    /// a new shader generator, as after a restart
+    void restartShaderGenerator(const String& cachePath)
+    {
+        RTShader::ShaderGenerator::destroy();
+        RTShader::ShaderGenerator::initialize();
+        RTShader::ShaderGenerator::getSingleton().setTargetLanguage("glsl");
+        RTShader::ShaderGenerator::getSingleton().setShaderCachePath(cachePath);
+    }
+
+    void removeCache(const String& cachePath)
+    {
+        Archive* arch = ArchiveManager::getSingleton().load(cachePath, "FileSystem", true);
+        StringVectorPtr files = arch->list(false);
+        for (const auto& file : *files)
+            FileSystemLayer::removeFile(cachePath + file);
+        ArchiveManager::getSingleton().unload(arch);
+        FileSystemLayer::removeDirectory(cachePath);
+    }
+
+    const GpuProgramPtr& getGeneratedProgram(int material, GpuProgramType type)
+    {
+        auto mat = MaterialManager::getSingleton().getByName("TestMat" + StringConverter::toString(material));
+        return mat->getTechniques()[1]->getPasses()[0]->getGpuProgram(type);
+    }
 };
 
 TEST_F(RTShaderSystem, createShaderBasedTechnique)
@@ -131,3 +181,67 @@ TEST_F(RTShaderSystem, FunctionInvocationOrder)
     EXPECT_TRUE(c == a);
     EXPECT_FALSE(c < a);
 }
+
+TEST_F(RTShaderSystem, ProgramCache)
+{
+    const String cachePath = "./RTShaderCacheTest/";
+    FileSystemLayer::createDirectory(cachePath);
+    RTShader::ShaderGenerator::getSingleton().setShaderCachePath(cachePath);
+
+    createMaterials(6);
+    validateMaterials(6);
+
+    // equal programs are shared, different ones are not
+    EXPECT_EQ(getGeneratedProgram(1, GPT_VERTEX_PROGRAM), getGeneratedProgram(2, GPT_VERTEX_PROGRAM));
+    EXPECT_NE(getGeneratedProgram(0, GPT_VERTEX_PROGRAM), getGeneratedProgram(1, GPT_VERTEX_PROGRAM));
+    EXPECT_NE(getGeneratedProgram(1, GPT_VERTEX_PROGRAM), getGeneratedProgram(5, GPT_VERTEX_PROGRAM));
+
+    String name = getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getName();
+    String source = getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getSource();
+    String fileName = cachePath + name + ".glsl";
+    ASSERT_TRUE(FileSystemLayer::fileExists(fileName));
+
+    // a restart names the programs alike and reads them from the cache
+    std::ofstream(fileName.c_str(), std::ios::app) << "// cached";
+    restartShaderGenerator(cachePath);
+    createMaterials(6);
+    validateMaterials(6);
+    EXPECT_EQ(getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getName(), name);
+    EXPECT_EQ(getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getSource(), source + "// cached");
+
+    // without a cache the program is written again
+    restartShaderGenerator("");
+    createMaterials(6);
+    validateMaterials(6);
+    EXPECT_EQ(getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getName(), name);
+    EXPECT_EQ(getGeneratedProgram(1, GPT_VERTEX_PROGRAM)->getSource(), source);
+
+    removeCache(cachePath);
+}
+
+TEST_F(RTShaderSystem, ParallelSynthesis)
+{
+    const int count = 60;
+    std::vector<String> names[2];
+    mRoot->getWorkQueue()->startup();
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+        restartShaderGenerator("");
+        RTShader::ShaderGenerator::getSingleton().setParallelSynthesis(parallel != 0);
+        createMaterials(count);
+        RTShader::ShaderGenerator::getSingleton().validateScheme("MyScheme");
+
+        for (int i = 0; i < count; ++i)
+        {
+            for (auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+            {
+                ASSERT_TRUE(getGeneratedProgram(i, type));
+                names[parallel].push_back(getGeneratedProgram(i, type)->getName());
+            }
+        }
+    }
+    mRoot->getWorkQueue()->shutdown();
+
+    // the same programs in either case
+    EXPECT_EQ(names[0], names[1]);
+}
@@ -122,3 +122,110 @@ TEST_F(TerrainTests, create)
     OGRE_DELETE t;
 }
 //--------------------------------------------------------------------------
+TEST_F(TerrainTests, LightmapEditMatchesFull)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 100;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+
+    uint16 size = t->getSize();
+    uint16 lightmapSize = mTerrainOpts->getLightMapSize();
+
+    Rect fullRect;
+    PixelBox* full = t->calculateLightmap(Rect(0, 0, size, size), Rect(), fullRect);
+    ASSERT_EQ(fullRect, Rect(0, 0, lightmapSize, lightmapSize));
+
+    // an edit in the middle, which also affects the texels in its shadow
+    Rect editRect;
+    PixelBox* edit = t->calculateLightmap(Rect(240, 240, 272, 272), Rect(), editRect);
+
+    // the texels do not depend on the rect they were baked in
+    const uint8* fullData = static_cast<const uint8*>(full->data);
+    const uint8* editData = static_cast<const uint8*>(edit->data);
+    for (long y = editRect.top; y < editRect.bottom; ++y)
+    {
+        for (long x = editRect.left; x < editRect.right; ++x)
+        {
+            ASSERT_EQ(editData[(editRect.bottom - y - 1) * editRect.width() + x - editRect.left],
+                      fullData[(lightmapSize - y - 1) * lightmapSize + x]);
+        }
+    }
+
+    OGRE_FREE(full->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE full;
+    OGRE_FREE(edit->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE edit;
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, DerivedDataMatchesImport)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.terrainSize = 513;
+    imp.worldSize = 1000;
+    imp.inputScale = 100;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+
+    uint16 size = t->getSize();
+    Rect rect(0, 0, size, size);
+
+    // the deltas of the import, which are recalculated below
+    std::vector<float> deltas(t->getDeltaData(), t->getDeltaData() + size * size);
+
+    t->calculateHeightDeltas(rect);
+    ASSERT_EQ(0, memcmp(deltas.data(), t->getDeltaData(), deltas.size() * sizeof(float)));
+
+    // inner vertices removed at the first LOD sit on an edge between their neighbours
+    for (long y = 0; y < size - 1; y += 2)
+    {
+        for (long x = 1; x < size - 1; x += 2)
+        {
+            float interp = (*t->getHeightData(x - 1, y) + *t->getHeightData(x + 1, y)) / 2;
+            ASSERT_NEAR(*t->getDeltaData(x, y), interp - *t->getHeightData(x, y), 1e-3f) << x << ", " << y;
+        }
+    }
+
+    Rect fullRect;
+    PixelBox* full = t->calculateNormals(rect, fullRect);
+    ASSERT_EQ(fullRect, rect);
+
+    // the normals do not depend on the rect they were calculated in
+    Rect editRect;
+    PixelBox* edit = t->calculateNormals(Rect(240, 240, 270, 280), editRect);
+    const uint8* fullData = static_cast<const uint8*>(full->data);
+    const uint8* editData = static_cast<const uint8*>(edit->data);
+    for (long y = editRect.top; y < editRect.bottom; ++y)
+    {
+        for (long x = editRect.left; x < editRect.right; ++x)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                ASSERT_EQ(editData[((editRect.bottom - y - 1) * editRect.width() + x - editRect.left) * 3 + c],
+                          fullData[((size - y - 1) * size + x) * 3 + c]);
+            }
+        }
+    }
+
+    OGRE_FREE(full->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE full;
+    OGRE_FREE(edit->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE edit;
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
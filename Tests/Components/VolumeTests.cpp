@@ -0,0 +1,254 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeChunk.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeMeshBuilder.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+//--------------------------------------------------------------------------
+namespace
+{
+    /// A source counting how often it is sampled.
+    class CountingSource : public CSGSphereSource
+    {
+    public:
+        mutable std::atomic<size_t> samples;
+
+        CountingSource() : CSGSphereSource(5, Vector3(8, 8, 8)), samples(0) {}
+
+        virtual Vector4 getValueAndGradient(const Vector3 &position) const
+        {
+            ++samples;
+            return CSGSphereSource::getValueAndGradient(position);
+        }
+    };
+
+    /// Collects the vertex and index counts of the meshed chunks.
+    class ChunkCounter : public MeshBuilderCallback
+    {
+    public:
+        std::vector<std::pair<size_t, size_t> > meshes;
+
+        virtual void ready(const SimpleRenderable *simpleRenderable, const VecVertex &vertices,
+                           const VecIndices &indices, size_t level, int inProcess)
+        {
+            meshes.push_back(std::make_pair(vertices.size(), indices.size()));
+        }
+    };
+
+    Vector3 latticePosition(size_t i)
+    {
+        return Vector3(Real(i % 16), Real(i / 16 % 16), Real(i / 256));
+    }
+}
+//--------------------------------------------------------------------------
+TEST(VolumeTests, CacheSourceMatchesSource)
+{
+    CountingSource src;
+    CacheSource cache(&src);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < 4096; ++i)
+        {
+            Vector3 position = latticePosition(i);
+            EXPECT_EQ(src.CSGSphereSource::getValueAndGradient(position),
+                      cache.getValueAndGradient(position));
+            EXPECT_EQ(src.CSGSphereSource::getValue(position), cache.getValue(position));
+        }
+    }
+
+    // every position was only sampled once
+    EXPECT_EQ(4096u, src.samples);
+    EXPECT_EQ(4096u, cache.getCachedSampleCount());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getCachedSampleCount());
+}
+//--------------------------------------------------------------------------
+TEST(VolumeTests, CacheSourceMemoryBudget)
+{
+    CountingSource src;
+    CacheSource cache(&src, 1024 * CacheSource::BYTES_PER_SAMPLE);
+    for (size_t i = 0; i < 4096; ++i)
+    {
+        cache.getValueAndGradient(latticePosition(i));
+        ASSERT_LE(cache.getCachedSampleCount(), 1024u);
+    }
+
+    // the recently used samples are still cached
+    src.samples = 0;
+    cache.getValueAndGradient(latticePosition(4095));
+    EXPECT_EQ(0u, src.samples);
+
+    cache.setMemoryBudget(16 * CacheSource::BYTES_PER_SAMPLE);
+    EXPECT_LE(cache.getCachedSampleCount(), 16u);
+    EXPECT_EQ(16 * CacheSource::BYTES_PER_SAMPLE, cache.getMemoryBudget());
+}
+//--------------------------------------------------------------------------
+TEST(VolumeTests, CacheSourceThreadSafe)
+{
+    CountingSource src;
+    CacheSource cache(&src, 2048 * CacheSource::BYTES_PER_SAMPLE);
+
+    std::atomic<bool> mismatch(false);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = 0; i < 20000; ++i)
+            {
+                Vector3 position = latticePosition((i * 7 + t * 1000) % 4096);
+                if (cache.getValueAndGradient(position) != src.CSGSphereSource::getValueAndGradient(position))
+                    mismatch = true;
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    EXPECT_FALSE(mismatch);
+    EXPECT_LE(cache.getCachedSampleCount(), 2048u);
+}
+//--------------------------------------------------------------------------
+TEST(VolumeTests, BatchedSamplingMatchesSingle)
+{
+    CSGSphereSource sphere(5, Vector3(8, 8, 8));
+    CSGPlaneSource plane(6, Vector3(0.2f, 1, 0.1f));
+    CSGCubeSource cube(Vector3(2, 2, 2), Vector3(9, 7, 12));
+    CSGUnionSource unionSrc(&sphere, &cube);
+    CSGDifferenceSource difference(&unionSrc, &plane);
+    CSGScaleSource scale(&difference, 1.5f);
+    Real frequencies[] = {0.25f, 1.5f};
+    Real amplitudes[] = {2, 0.3f};
+    CSGNoiseSource noise(&scale, frequencies, amplitudes, 2, 42);
+    CSGNegateSource negate(&noise);
+    CSGIntersectionSource intersection(&negate, &sphere);
+    CacheSource cache(&intersection);
+
+    // more positions than the operations process at once
+    std::vector<Vector3> positions;
+    for (size_t i = 0; i < 4096; i += 13)
+        positions.push_back(latticePosition(i) * 1.1f);
+
+    const Source* sources[] = {&sphere, &plane, &cube, &unionSrc, &difference, &scale, &noise, &negate,
+                               &intersection, &cache};
+    for (const Source* src : sources)
+    {
+        std::vector<Real> values(positions.size());
+        std::vector<Vector4> valuesAndGradients(positions.size());
+        src->getValues(positions.data(), positions.size(), values.data());
+        src->getValuesAndGradients(positions.data(), positions.size(), valuesAndGradients.data());
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            ASSERT_EQ(src->getValue(positions[i]), values[i]) << i;
+            ASSERT_EQ(src->getValueAndGradient(positions[i]), valuesAndGradients[i]) << i;
+        }
+    }
+}
+
+/// a sphere with its density shifted
+struct ShiftedSphereSource : public CSGSphereSource
+{
+    ShiftedSphereSource() : CSGSphereSource(5, Vector3(8, 8, 8)) {}
+    Real getValue(const Vector3 &position) const override { return CSGSphereSource::getValue(position) + 1; }
+};
+
+TEST(VolumeTests, BatchedSamplingOfSubclass)
+{
+    ShiftedSphereSource sphere;
+    CSGUnionSource unionSrc(&sphere, &sphere);
+
+    Vector3 positions[] = {Vector3(0, 0, 0), Vector3(8, 8, 8), Vector3(3, 9, 8)};
+    Real values[3];
+    sphere.getValues(positions, 3, values);
+    for (size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(values[i], sphere.getValue(positions[i]));
+
+    // also through the operations forwarding batches
+    unionSrc.getValues(positions, 3, values);
+    for (size_t i = 0; i < 3; ++i)
+        EXPECT_EQ(values[i], sphere.getValue(positions[i]));
+}
+//--------------------------------------------------------------------------
+struct VolumeChunkTests : public RootWithoutRenderSystemFixture
+{
+    /// load a chunk tree serially and in parallel and compare the resulting meshes
+    void loadChunks(Real size, size_t level);
+};
+
+void VolumeChunkTests::loadChunks(Real size, size_t level)
+{
+    // a noisy ground with a sphere on top
+    CSGPlaneSource plane(10, Vector3::UNIT_Y);
+    Real frequencies[] = {0.05f, 0.21f};
+    Real amplitudes[] = {6, 1.5f};
+    CSGNoiseSource noise(&plane, frequencies, amplitudes, 2, 4711);
+    CSGSphereSource sphere(12, Vector3(32, 18, 32));
+    CSGUnionSource volume(&noise, &sphere);
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+
+    ChunkCounter counters[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        // the WorkQueue only uses its threads once it is started
+        if (i == 1)
+            mRoot->getWorkQueue()->startup();
+
+        ChunkParameters parameters;
+        parameters.sceneManager = sceneMgr;
+        parameters.src = &volume;
+        parameters.baseError = 0.75f;
+        parameters.lodCallback = &counters[i];
+
+        Chunk* chunk = OGRE_NEW Chunk();
+        chunk->load(sceneMgr->getRootSceneNode()->createChildSceneNode(), Vector3::ZERO, Vector3(size),
+                    level, &parameters);
+        OGRE_DELETE chunk;
+    }
+
+    ASSERT_FALSE(counters[0].meshes.empty());
+    EXPECT_EQ(counters[0].meshes, counters[1].meshes);
+}
+
+TEST_F(VolumeChunkTests, ParallelMatchesSerial)
+{
+    loadChunks(31, 3);
+}
+//--------------------------------------------------------------------------
@@ -29,6 +29,9 @@ THE SOFTWARE.
 #include "OgreDefaultHardwareBufferManager.h"
 #include "OgreVertexIndexData.h"
 #include "OgreEdgeListBuilder.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
+#include "RootWithoutRenderSystemFixture.h"
 
 
 // Register the test suite
@@ -283,3 +286,140 @@ TEST_F(EdgeBuilderTests,MultiIndexBufMultiVertexBuf)
     delete edgeData;
 }
 //--------------------------------------------------------------------------
+namespace
+{
+/// a torus grid, with duplicated vertices along the seams
+HardwareVertexBufferSharedPtr createTorusVertices(VertexData& vd, size_t rings, size_t segments)
+{
+    vd.vertexCount = (rings + 1) * (segments + 1);
+    vd.vertexStart = 0;
+    vd.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float) * 3, vd.vertexCount, HardwareBuffer::HBU_STATIC, true);
+    vd.vertexBufferBinding->setBinding(0, vbuf);
+    float* pFloat = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t r = 0; r <= rings; ++r)
+    {
+        // compute the angles from the wrapped index, so the seams get exactly the same positions
+        Radian u(Math::TWO_PI * Real(r % rings) / Real(rings));
+        for (size_t s = 0; s <= segments; ++s)
+        {
+            Radian v(Math::TWO_PI * Real(s % segments) / Real(segments));
+            *pFloat++ = (2 + Math::Cos(v)) * Math::Cos(u);
+            *pFloat++ = (2 + Math::Cos(v)) * Math::Sin(u);
+            *pFloat++ = Math::Sin(v);
+        }
+    }
+    vbuf->unlock();
+    return vbuf;
+}
+
+/// the triangles of the rings [ringStart, ringEnd) of the torus
+void createTorusIndices(IndexData& id, size_t ringStart, size_t ringEnd, size_t segments)
+{
+    id.indexCount = (ringEnd - ringStart) * segments * 6;
+    id.indexStart = 0;
+    id.indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_32BIT, id.indexCount, HardwareBuffer::HBU_STATIC, true);
+    uint32* pIdx = static_cast<uint32*>(id.indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t r = ringStart; r < ringEnd; ++r)
+    {
+        for (size_t s = 0; s < segments; ++s)
+        {
+            uint32 i0 = uint32(r * (segments + 1) + s);
+            uint32 i1 = uint32(i0 + segments + 1);
+            *pIdx++ = i0; *pIdx++ = i1; *pIdx++ = i0 + 1;
+            *pIdx++ = i0 + 1; *pIdx++ = i1; *pIdx++ = i1 + 1;
+        }
+    }
+    id.indexBuffer->unlock();
+}
+
+void expectEqualEdges(const EdgeData& a, const EdgeData& b)
+{
+    EXPECT_EQ(a.isClosed, b.isClosed);
+    ASSERT_EQ(a.triangles.size(), b.triangles.size());
+    for (size_t t = 0; t < a.triangles.size(); ++t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_EQ(a.triangles[t].vertIndex[i], b.triangles[t].vertIndex[i]);
+            ASSERT_EQ(a.triangles[t].sharedVertIndex[i], b.triangles[t].sharedVertIndex[i]);
+        }
+    }
+    ASSERT_EQ(a.edgeGroups.size(), b.edgeGroups.size());
+    for (size_t g = 0; g < a.edgeGroups.size(); ++g)
+    {
+        const EdgeData::EdgeList& ea = a.edgeGroups[g].edges;
+        const EdgeData::EdgeList& eb = b.edgeGroups[g].edges;
+        ASSERT_EQ(ea.size(), eb.size());
+        for (size_t e = 0; e < ea.size(); ++e)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                ASSERT_EQ(ea[e].triIndex[i], eb[e].triIndex[i]) << g << ", " << e;
+                ASSERT_EQ(ea[e].vertIndex[i], eb[e].vertIndex[i]) << g << ", " << e;
+                ASSERT_EQ(ea[e].sharedVertIndex[i], eb[e].sharedVertIndex[i]) << g << ", " << e;
+            }
+            ASSERT_EQ(ea[e].degenerate, eb[e].degenerate) << g << ", " << e;
+        }
+    }
+}
+}
+
+struct EdgeBuilderParallelTests : public RootWithoutRenderSystemFixture
+{
+    /// build the edge list of a torus in parallel and serially and compare the results
+    void buildTorus(size_t rings, size_t segments);
+};
+
+void EdgeBuilderParallelTests::buildTorus(size_t rings, size_t segments)
+{
+    // the torus split over two vertex sets, so edges connect across them
+    VertexData vd[2];
+    createTorusVertices(vd[0], rings, segments);
+    createTorusVertices(vd[1], rings, segments);
+    IndexData id[3];
+    createTorusIndices(id[0], 0, rings / 2, segments);
+    createTorusIndices(id[1], rings / 2, rings, segments);
+    // some triangles twice, so some edges have more than two triangles
+    createTorusIndices(id[2], 0, 4, segments);
+
+    EdgeData* edgeData[2];
+    mRoot->getWorkQueue()->startup();
+    for (int i = 0; i < 2; ++i)
+    {
+        if (i == 1)
+        {
+            // without Root, everything is done on the calling thread
+            delete mRoot;
+            mRoot = NULL;
+        }
+
+        EdgeListBuilder edgeBuilder;
+        edgeBuilder.addVertexData(&vd[0]);
+        edgeBuilder.addVertexData(&vd[1]);
+        edgeBuilder.addIndexData(&id[0], 0);
+        edgeBuilder.addIndexData(&id[1], 1);
+        edgeBuilder.addIndexData(&id[2], 0);
+        edgeData[i] = edgeBuilder.build();
+    }
+
+    EXPECT_EQ(edgeData[0]->triangles.size(), 2 * (rings + 4) * segments);
+    // every edge of the torus is shared by two of its triangles. The duplicates form a
+    // separate tube, which is open on one side.
+    EXPECT_FALSE(edgeData[0]->isClosed);
+    size_t edgeCount = edgeData[0]->edgeGroups[0].edges.size() + edgeData[0]->edgeGroups[1].edges.size();
+    EXPECT_EQ(edgeCount, 3 * rings * segments + 3 * 4 * segments + segments);
+    expectEqualEdges(*edgeData[0], *edgeData[1]);
+
+    delete edgeData[0];
+    delete edgeData[1];
+}
+
+TEST_F(EdgeBuilderParallelTests, ParallelMatchesSerial)
+{
+    // big enough to connect the edges in parallel
+    buildTorus(128, 128);
+}
+//--------------------------------------------------------------------------
@@ -311,3 +311,19 @@ TEST_F(FileSystemArchiveTests,CreateAndRemoveFile)
     EXPECT_TRUE(!mArch->exists(fileName));
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,MemoryMappedRead)
+{
+    size_t threshold = FileSystemArchiveFactory::getMemoryMapThreshold();
+    FileSystemArchiveFactory::setMemoryMapThreshold(0);
+    DataStreamPtr mapped = mArch->open("rootfile.txt");
+    FileSystemArchiveFactory::setMemoryMapThreshold(threshold);
+
+    EXPECT_TRUE(dynamic_cast<MemoryDataStream*>(mapped.get()));
+    EXPECT_FALSE(mapped->isWriteable());
+    EXPECT_EQ(mFileSizeRoot1, mapped->size());
+    EXPECT_EQ(mArch->open("rootfile.txt")->getAsString(), mapped->getAsString());
+
+    mapped->seek(0);
+    EXPECT_EQ(String("this is line 1 in file 1"), mapped->getLine());
+}
+//--------------------------------------------------------------------------
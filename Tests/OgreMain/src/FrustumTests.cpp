@@ -0,0 +1,139 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+
+#include "OgreCamera.h"
+#include "OgreFrustum.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+std::vector<AxisAlignedBox> createBoxes(size_t count)
+{
+    // we want cross platform consistent sequence
+    std::minstd_rand rng;
+    auto rand = [&rng](Real scale) { return scale * (Real(rng()) / rng.max() - 0.5f); };
+
+    std::vector<AxisAlignedBox> boxes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % 97 == 0)
+        {
+            boxes.push_back(AxisAlignedBox::BOX_NULL);
+            continue;
+        }
+        if (i % 101 == 0)
+        {
+            boxes.push_back(AxisAlignedBox::BOX_INFINITE);
+            continue;
+        }
+
+        Vector3 centre(rand(400), rand(400), rand(400));
+        Vector3 halfSize(std::abs(rand(20)), std::abs(rand(20)), std::abs(rand(20)));
+        boxes.push_back(AxisAlignedBox(centre - halfSize, centre + halfSize));
+    }
+    return boxes;
+}
+
+uint32 batchVisibility(const Frustum& frustum, const AxisAlignedBox* boxes, size_t count)
+{
+    AxisAlignedBoxBatch batch;
+    for (size_t i = 0; i < count; ++i)
+        batch.add(boxes[i]);
+    return frustum.isVisible(batch);
+}
+}
+
+typedef RootWithoutRenderSystemFixture FrustumTests;
+TEST_F(FrustumTests, BatchVisibilityMatchesSingle)
+{
+    std::vector<AxisAlignedBox> boxes = createBoxes(100000);
+
+    // Camera tests the batches with SIMD instructions
+    Camera camera("cam", NULL);
+    camera.setNearClipDistance(1);
+    camera.setFarClipDistance(150);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        size_t numVisible = 0;
+        for (size_t begin = 0; begin < boxes.size(); begin += AxisAlignedBoxBatch::CAPACITY)
+        {
+            size_t count = std::min<size_t>(boxes.size() - begin, AxisAlignedBoxBatch::CAPACITY);
+            uint32 visible = batchVisibility(camera, &boxes[begin], count);
+
+            for (size_t i = 0; i < AxisAlignedBoxBatch::CAPACITY; ++i)
+            {
+                bool expected = i < count && camera.isVisible(boxes[begin + i]);
+                ASSERT_EQ(expected, (visible & (1u << i)) != 0) << "box " << begin + i;
+                numVisible += expected;
+            }
+        }
+
+        // something got culled, but not everything
+        EXPECT_GT(numVisible, 0u);
+        EXPECT_LT(numVisible, boxes.size());
+
+        // infinite far plane in the second pass
+        camera.setFarClipDistance(0);
+    }
+}
+
+/// culls the boxes on the negative x side only
+struct HalfSpaceFrustum : public Frustum
+{
+    using Frustum::isVisible;
+    bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const override
+    {
+        return !bound.isNull() && bound.getMaximum().x >= 0;
+    }
+};
+
+TEST_F(FrustumTests, BatchVisibilityOfSubclass)
+{
+    std::vector<AxisAlignedBox> boxes = createBoxes(AxisAlignedBoxBatch::CAPACITY);
+    HalfSpaceFrustum frustum;
+    Camera camera("cam", NULL);
+
+    uint32 expected = 0;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        if (frustum.isVisible(boxes[i]))
+            expected |= 1u << i;
+    }
+    EXPECT_EQ(batchVisibility(frustum, &boxes[0], boxes.size()), expected);
+
+    // also as the culling frustum of a camera
+    camera.setCullingFrustum(&frustum);
+    EXPECT_EQ(batchVisibility(camera, &boxes[0], boxes.size()), expected);
+}
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "OgreTextureManager.h"
 #include "OgreFileSystem.h"
 #include "OgreArchiveManager.h"
+#include "OgreWorkQueue.h"
 
 #include <random>
 using std::minstd_rand;
@@ -320,6 +321,124 @@ TEST_F(ResourceLoading, CollsionDeleteExisting)
     EXPECT_TRUE(mat->clone("Collision"));
 }
 
+TEST_F(ResourceLoading, ParallelPrepare)
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    String modelsPath;
+    StringVectorPtr locations = rgm.listResourceLocations(RGN_DEFAULT);
+    for (const String& location : *locations)
+        if (StringUtil::endsWith(location, "models"))
+            modelsPath = location;
+
+    const char* meshes[] = {"athene.mesh", "knot.mesh", "ogrehead.mesh", "penguin.mesh", "cube.mesh"};
+    const char* groups[] = {"SerialPrepare", "ParallelPrepare"};
+    for (const char* group : groups)
+    {
+        rgm.createResourceGroup(group, false);
+        rgm.addResourceLocation(modelsPath, "FileSystem", group);
+        for (const char* mesh : meshes)
+            rgm.declareResource(mesh, "Mesh", group);
+        rgm.initialiseResourceGroup(group);
+    }
+
+    rgm.loadResourceGroup(groups[0]);
+
+    mRoot->getWorkQueue()->startup();
+    rgm.setParallelPrepare(true);
+    rgm.loadResourceGroup(groups[1]);
+    rgm.setParallelPrepare(false);
+    mRoot->getWorkQueue()->shutdown();
+
+    for (const char* name : meshes)
+    {
+        MeshPtr serial = MeshManager::getSingleton().getByName(name, groups[0]);
+        MeshPtr parallel = MeshManager::getSingleton().getByName(name, groups[1]);
+        ASSERT_TRUE(parallel);
+        EXPECT_TRUE(parallel->isLoaded());
+        EXPECT_EQ(serial->getNumSubMeshes(), parallel->getNumSubMeshes());
+        EXPECT_EQ(serial->getBounds(), parallel->getBounds());
+        EXPECT_EQ(serial->getSkeletonName(), parallel->getSkeletonName());
+    }
+}
+
+/// reads the image file on prepare, as the usual textures need a render system
+struct StreamTextureManager : public DefaultTextureManager
+{
+    class StreamTexture : public Texture
+    {
+        DataStreamPtr mData;
+    public:
+        StreamTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                      const String& group)
+            : Texture(creator, name, handle, group)
+        {
+        }
+        const HardwarePixelBufferSharedPtr& getBuffer(size_t, size_t) override
+        {
+            static HardwarePixelBufferSharedPtr nullBuffer;
+            return nullBuffer;
+        }
+        size_t getDataSize() const { return mData ? mData->size() : 0; }
+
+    protected:
+        void prepareImpl() override
+        {
+            mData = ResourceGroupManager::getSingleton().openResource(mName, mGroup, this);
+        }
+        void unprepareImpl() override {}
+        void createInternalResourcesImpl() override {}
+        void freeInternalResourcesImpl() override {}
+        void loadImpl() override {}
+    };
+
+    Resource* createImpl(const String& name, ResourceHandle handle, const String& group, bool,
+                         ManualResourceLoader*, const NameValuePairList*) override
+    {
+        return new StreamTexture(this, name, handle, group);
+    }
+};
+
+TEST_F(ResourceLoading, ParallelPrepareMaterials)
+{
+    StreamTextureManager texMgr;
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    String texturesPath;
+    StringVectorPtr locations = rgm.listResourceLocations(RGN_DEFAULT);
+    for (const String& location : *locations)
+        if (StringUtil::endsWith(location, "materials/textures"))
+            texturesPath = location;
+
+    const char* group = "ParallelPrepareMaterials";
+    const char* textures[] = {"ogrelogo.png", "rockwall.tga", "flare.png"};
+    rgm.createResourceGroup(group, false);
+    rgm.addResourceLocation(texturesPath, "FileSystem", group);
+    rgm.initialiseResourceGroup(group);
+
+    // materials sharing their textures, which they prepare on the calling thread
+    std::vector<MaterialPtr> materials;
+    for (int i = 0; i < 12; ++i)
+    {
+        materials.push_back(MaterialManager::getSingleton().create(StringConverter::toString(i), group));
+        materials.back()->getTechnique(0)->getPass(0)->createTextureUnitState(textures[i % 3]);
+    }
+
+    mRoot->getWorkQueue()->startup();
+    rgm.setParallelPrepare(true);
+    rgm.loadResourceGroup(group);
+    rgm.setParallelPrepare(false);
+    mRoot->getWorkQueue()->shutdown();
+
+    for (const MaterialPtr& mat : materials)
+        EXPECT_TRUE(mat->isLoaded());
+    for (const char* name : textures)
+    {
+        auto tex = static_pointer_cast<StreamTextureManager::StreamTexture>(texMgr.getByName(name, group));
+        ASSERT_TRUE(tex);
+        EXPECT_TRUE(tex->isLoaded());
+        EXPECT_EQ(tex->getDataSize(), rgm.openResource(name, group)->size());
+    }
+}
+
 typedef RootWithoutRenderSystemFixture TextureTests;
 TEST_F(TextureTests, Blank)
 {
@@ -0,0 +1,240 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+#include "OgreAutoParamDataSource.h"
+#include "OgreCamera.h"
+#include "OgreGpuProgramParams.h"
+#include "OgreMaterialManager.h"
+#include "OgreSceneManager.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+namespace
+{
+/// a renderable at a fixed position
+class TestRenderable : public Renderable
+{
+    Matrix4 mTransform;
+    LightList mLights;
+
+public:
+    TestRenderable(const Vector3& pos) : mTransform(Affine3::getTrans(pos)) {}
+    const MaterialPtr& getMaterial(void) const { return MaterialManager::getSingleton().getDefaultMaterial(); }
+    void getRenderOperation(RenderOperation& op) {}
+    void getWorldTransforms(Matrix4* xform) const { *xform = mTransform; }
+    Real getSquaredViewDepth(const Camera* cam) const { return 0; }
+    const LightList& getLights(void) const { return mLights; }
+};
+
+struct GpuProgramParamsTests : public RootWithoutRenderSystemFixture
+{
+    SceneManager* mSceneMgr;
+    Camera* mCamera;
+
+    void SetUp()
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        mSceneMgr = mRoot->createSceneManager();
+        mCamera = mSceneMgr->createCamera("cam");
+    }
+
+    GpuProgramParametersSharedPtr createParams()
+    {
+        GpuProgramParametersSharedPtr params(new GpuProgramParameters);
+        params->_setLogicalIndexes(std::make_shared<GpuLogicalBufferStruct>(),
+                                   std::make_shared<GpuLogicalBufferStruct>(),
+                                   std::make_shared<GpuLogicalBufferStruct>());
+        // physical indices 0, 4 and 20
+        params->setAutoConstant(0, GpuProgramParameters::ACT_PASS_NUMBER);
+        params->setAutoConstant(1, GpuProgramParameters::ACT_WORLD_MATRIX);
+        params->setAutoConstant(5, GpuProgramParameters::ACT_VIEWPROJ_MATRIX);
+        return params;
+    }
+};
+
+Matrix4 translation(Real x, Real y, Real z)
+{
+    Matrix4 m = Matrix4::IDENTITY;
+    m.makeTrans(x, y, z);
+    return m;
+}
+
+Matrix4 readMatrix(const GpuProgramParametersSharedPtr& params, size_t physicalIndex)
+{
+    const float* f = params->getFloatPointer(physicalIndex);
+    return Matrix4(f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7], f[8], f[9], f[10], f[11], f[12],
+                   f[13], f[14], f[15]);
+}
+}
+
+TEST_F(GpuProgramParamsTests, UpdatesChangedAutos)
+{
+    TestRenderable rend1(Vector3(1, 2, 3)), rend2(Vector3(4, 5, 6));
+    AutoParamDataSource source;
+    source.setCurrentCamera(mCamera, false);
+    source.setCurrentRenderable(&rend1);
+
+    GpuProgramParametersSharedPtr params = createParams();
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(36)));
+    EXPECT_EQ(readMatrix(params, 4), translation(1, 2, 3));
+    EXPECT_EQ(readMatrix(params, 20), source.getViewProjectionMatrix());
+
+    // nothing changed, only the pass number is written again
+    params->_clearDirtyFloatRange();
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(1)));
+
+    // the pass is not tracked
+    source.setPassNumber(3);
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params->getFloatPointer(0), 3);
+
+    // a new object leaves the view projection matrix
+    source.setCurrentRenderable(&rend2);
+    params->_clearDirtyFloatRange();
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(20)));
+    EXPECT_EQ(readMatrix(params, 4), translation(4, 5, 6));
+
+    // the mask still limits the update
+    source.setCurrentRenderable(&rend1);
+    params->_updateAutoParams(&source, GPV_GLOBAL);
+    EXPECT_EQ(readMatrix(params, 4), translation(4, 5, 6));
+    params->_updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(readMatrix(params, 4), translation(1, 2, 3));
+
+    // the camera changes everything
+    mCamera->setFOVy(Degree(30));
+    source.setCurrentCamera(mCamera, false);
+    params->_clearDirtyFloatRange();
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(36)));
+    EXPECT_EQ(readMatrix(params, 20), source.getViewProjectionMatrix());
+}
+
+TEST_F(GpuProgramParamsTests, TracksEachSource)
+{
+    TestRenderable rend1(Vector3(1, 2, 3)), rend2(Vector3(4, 5, 6));
+    AutoParamDataSource source1, source2;
+    source1.setCurrentCamera(mCamera, false);
+    source1.setCurrentRenderable(&rend1);
+    source2.setCurrentCamera(mCamera, false);
+    source2.setCurrentRenderable(&rend2);
+
+    // alternating objects keep their own state
+    GpuProgramParametersSharedPtr params1 = createParams();
+    GpuProgramParametersSharedPtr params2 = createParams();
+    params1->_updateAutoParams(&source1, GPV_ALL);
+    params2->_updateAutoParams(&source1, GPV_ALL);
+    params1->_clearDirtyFloatRange();
+    params1->_updateAutoParams(&source1, GPV_ALL);
+    EXPECT_EQ(params1->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(1)));
+
+    // equal generations of another source do not count
+    params1->_clearDirtyFloatRange();
+    params1->_updateAutoParams(&source2, GPV_ALL);
+    EXPECT_EQ(params1->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(36)));
+    EXPECT_EQ(readMatrix(params1, 4), translation(4, 5, 6));
+
+    // copies are written again
+    *params2 = *params1;
+    params2->_clearDirtyFloatRange();
+    params2->_updateAutoParams(&source2, GPV_ALL);
+    EXPECT_EQ(params2->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(36)));
+
+    // so are replaced autos
+    params1->setAutoConstant(1, GpuProgramParameters::ACT_INVERSE_WORLD_MATRIX);
+    params1->_clearDirtyFloatRange();
+    params1->_updateAutoParams(&source2, GPV_ALL);
+    EXPECT_EQ(params1->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(20)));
+    EXPECT_EQ(readMatrix(params1, 4), translation(-4, -5, -6));
+}
+
+TEST_F(GpuProgramParamsTests, KeepsWritesDirty)
+{
+    AutoParamDataSource source;
+    source.setCurrentCamera(mCamera, false);
+    TestRenderable rend(Vector3(1, 2, 3));
+    source.setCurrentRenderable(&rend);
+
+    GpuProgramParametersSharedPtr params = createParams();
+    params->_updateAutoParams(&source, GPV_ALL);
+    params->_clearDirtyFloatRange();
+
+    // constants set between the updates are still to be uploaded
+    params->setConstant(9, Vector4(1, 2, 3, 4));
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(40)));
+
+    // until the render system clears them
+    params->_clearDirtyFloatRange();
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(0)));
+    params->_updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(params->getDirtyFloatRange(), std::make_pair(size_t(0), size_t(1)));
+}
+
+TEST_F(GpuProgramParamsTests, UpdatesIdentityViewProj)
+{
+    TestRenderable rend(Vector3(1, 2, 3)), overlay(Vector3(4, 5, 6));
+    overlay.setUseIdentityView(true);
+    mCamera->setPosition(Vector3(0, 0, 10));
+    AutoParamDataSource source;
+    source.setCurrentCamera(mCamera, false);
+
+    GpuProgramParametersSharedPtr params = createParams();
+    params->setAutoConstant(9, GpuProgramParameters::ACT_VIEW_MATRIX);
+
+    // the global view matrices are replaced for renderables using an identity view
+    for (int i = 0; i < 2; ++i)
+    {
+        source.setCurrentRenderable(&rend);
+        params->_updateAutoParams(&source, GPV_ALL);
+        EXPECT_EQ(readMatrix(params, 36), Matrix4(mCamera->getViewMatrix()));
+        EXPECT_EQ(readMatrix(params, 20), mCamera->getProjectionMatrixWithRSDepth() * mCamera->getViewMatrix());
+
+        source.setCurrentRenderable(&overlay);
+        params->_updateAutoParams(&source, GPV_ALL);
+        EXPECT_EQ(readMatrix(params, 36), Matrix4::IDENTITY);
+        EXPECT_EQ(readMatrix(params, 20), mCamera->getProjectionMatrixWithRSDepth());
+    }
+
+    // the identity projection needs a render system, so only check the global values get updated
+    overlay.setUseIdentityView(false);
+    overlay.setUseIdentityProjection(true);
+    uint32 generation = source.getGeneration(GPV_GLOBAL);
+    source.setCurrentRenderable(&overlay);
+    EXPECT_NE(source.getGeneration(GPV_GLOBAL), generation);
+    generation = source.getGeneration(GPV_GLOBAL);
+    source.setCurrentRenderable(&overlay);
+    EXPECT_EQ(source.getGeneration(GPV_GLOBAL), generation);
+    source.setCurrentRenderable(&rend);
+    EXPECT_NE(source.getGeneration(GPV_GLOBAL), generation);
+}
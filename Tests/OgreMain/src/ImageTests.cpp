@@ -0,0 +1,190 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+#include "OgreImage.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+namespace
+{
+void allocateImage(Image& img, uint32 width, uint32 height, PixelFormat format)
+{
+    uchar* data = OGRE_ALLOC_T(uchar, PixelUtil::getMemorySize(width, height, 1, format),
+                               MEMCATEGORY_GENERAL);
+    img.loadDynamicImage(data, width, height, 1, format, true);
+}
+
+/// an image with a smooth gradient and some noise in every channel
+void createImage(Image& img, uint32 width, uint32 height, PixelFormat format)
+{
+    allocateImage(img, width, height, format);
+    uint32 seed = 12345;
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            seed = seed * 1664525 + 1013904223;
+            float noise = (seed >> 24) / 1024.0f;
+            img.setColourAt(ColourValue(float(x) / width, float(y) / height, noise,
+                                        0.5f + noise), x, y, 0);
+        }
+    }
+}
+
+/// the scaled pixels, which may have been computed on several threads
+std::vector<uchar> scaleImage(const Image& src, uint32 width, uint32 height, PixelFormat format,
+                              Image::Filter filter)
+{
+    std::vector<uchar> data(PixelUtil::getMemorySize(width, height, 1, format));
+    Image::scale(src.getPixelBox(), PixelBox(width, height, 1, format, data.data()), filter);
+    return data;
+}
+}
+
+TEST(ImageTests, ByteFiltersMatchFloat)
+{
+    Image src;
+    createImage(src, 67, 45, PF_A8B8G8R8);
+
+    Image::Filter filters[] = {Image::FILTER_BILINEAR, Image::FILTER_BOX, Image::FILTER_LANCZOS};
+    for (Image::Filter filter : filters)
+    {
+        // byte math without conversion, compared to the same scaling with floating point math
+        for (uint32 width : {150u, 20u})
+        {
+            Image dst;
+            allocateImage(dst, width, 31, PF_A8B8G8R8);
+            Image::scale(src.getPixelBox(), dst.getPixelBox(), filter);
+
+            Image ref;
+            allocateImage(ref, width, 31, PF_FLOAT32_RGBA);
+            Image::scale(src.getPixelBox(), ref.getPixelBox(), filter);
+
+            for (uint32 y = 0; y < dst.getHeight(); ++y)
+            {
+                for (uint32 x = 0; x < dst.getWidth(); ++x)
+                {
+                    ColourValue a = dst.getColourAt(x, y, 0);
+                    ColourValue b = ref.getColourAt(x, y, 0);
+                    b.saturate();
+                    for (int i = 0; i < 4; ++i)
+                        ASSERT_NEAR(a[i], b[i], 1.5f / 255) << filter << ": " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(ImageTests, BoxHalvesImage)
+{
+    Image src;
+    createImage(src, 64, 32, PF_FLOAT32_RGBA);
+    Image dst;
+    allocateImage(dst, 32, 16, PF_FLOAT32_RGBA);
+    Image::scale(src.getPixelBox(), dst.getPixelBox(), Image::FILTER_BOX);
+
+    for (uint32 y = 0; y < dst.getHeight(); ++y)
+    {
+        for (uint32 x = 0; x < dst.getWidth(); ++x)
+        {
+            ColourValue average = (src.getColourAt(2 * x, 2 * y, 0) + src.getColourAt(2 * x + 1, 2 * y, 0) +
+                                   src.getColourAt(2 * x, 2 * y + 1, 0) +
+                                   src.getColourAt(2 * x + 1, 2 * y + 1, 0)) / 4;
+            ColourValue c = dst.getColourAt(x, y, 0);
+            for (int i = 0; i < 4; ++i)
+                ASSERT_NEAR(c[i], average[i], 1e-5f) << x << ", " << y;
+        }
+    }
+}
+
+TEST(ImageTests, FiltersKeepConstantColour)
+{
+    ColourValue colour(0.2f, 0.4f, 0.6f, 0.8f);
+    Image src;
+    allocateImage(src, 37, 23, PF_FLOAT32_RGBA);
+    for (uint32 y = 0; y < src.getHeight(); ++y)
+        for (uint32 x = 0; x < src.getWidth(); ++x)
+            src.setColourAt(colour, x, y, 0);
+
+    Image::Filter filters[] = {Image::FILTER_BOX, Image::FILTER_TRIANGLE, Image::FILTER_BICUBIC,
+                               Image::FILTER_LANCZOS};
+    for (Image::Filter filter : filters)
+    {
+        // minify and magnify
+        for (uint32 size : {5u, 64u})
+        {
+            Image dst;
+            allocateImage(dst, size, size, PF_FLOAT32_RGBA);
+            Image::scale(src.getPixelBox(), dst.getPixelBox(), filter);
+            for (uint32 y = 0; y < size; ++y)
+            {
+                for (uint32 x = 0; x < size; ++x)
+                {
+                    ColourValue c = dst.getColourAt(x, y, 0);
+                    for (int i = 0; i < 4; ++i)
+                        ASSERT_NEAR(c[i], colour[i], 1e-5f) << filter << ": " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+typedef RootWithoutRenderSystemFixture ImageParallelTests;
+TEST_F(ImageParallelTests, ParallelMatchesSerial)
+{
+    Image byteImg;
+    createImage(byteImg, 300, 200, PF_A8B8G8R8);
+    Image floatImg;
+    createImage(floatImg, 300, 200, PF_FLOAT32_RGBA);
+    Image::Filter filters[] = {Image::FILTER_NEAREST, Image::FILTER_BILINEAR, Image::FILTER_BOX,
+                               Image::FILTER_LANCZOS};
+
+    mRoot->getWorkQueue()->startup();
+    std::vector<std::vector<uchar> > parallel;
+    for (Image::Filter filter : filters)
+    {
+        parallel.push_back(scaleImage(byteImg, 170, 290, PF_A8B8G8R8, filter));
+        parallel.push_back(scaleImage(floatImg, 170, 290, PF_FLOAT32_RGBA, filter));
+    }
+    mRoot->getWorkQueue()->shutdown();
+
+    // without Root, everything is done on the calling thread
+    delete mRoot;
+    mRoot = NULL;
+
+    size_t i = 0;
+    for (Image::Filter filter : filters)
+    {
+        EXPECT_EQ(parallel[i++], scaleImage(byteImg, 170, 290, PF_A8B8G8R8, filter)) << filter;
+        EXPECT_EQ(parallel[i++], scaleImage(floatImg, 170, 290, PF_FLOAT32_RGBA, filter)) << filter;
+    }
+}
@@ -0,0 +1,203 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+#include "OgreManualObject.h"
+#include "OgreMesh.h"
+#include "OgreMeshOptimiser.h"
+#include "OgreSubMesh.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+namespace
+{
+/// a grid of quads, with the triangles in random order, optionally after degenerate ones
+MeshPtr createShuffledGrid(const String& name, uint32 size, bool leadingDegenerates = false)
+{
+    ManualObject obj(name);
+    obj.begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    for (uint32 y = 0; y <= size; ++y)
+    {
+        for (uint32 x = 0; x <= size; ++x)
+        {
+            // a bumpy surface, so there is something to sort for overdraw
+            obj.position(x, y, std::sin(x * 0.3f) * std::cos(y * 0.2f) * 3);
+        }
+    }
+
+    std::vector<uint32> quads(size * size);
+    for (uint32 i = 0; i < quads.size(); ++i)
+        quads[i] = i;
+    uint32 seed = 12345;
+    for (size_t i = quads.size() - 1; i > 0; --i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        std::swap(quads[i], quads[(seed >> 8) % (i + 1)]);
+    }
+
+    if (leadingDegenerates)
+    {
+        obj.triangle(0, 0, 1);
+        obj.triangle(1, 1, 1);
+        obj.triangle(0, 1, 0);
+    }
+
+    for (uint32 i = 0; i < quads.size(); ++i)
+    {
+        uint32 x = quads[i] % size;
+        uint32 y = quads[i] / size;
+        uint32 v = y * (size + 1) + x;
+        obj.quad(v, v + 1, v + size + 2, v + size + 1);
+    }
+    obj.end();
+    return obj.convertToMesh(name);
+}
+
+/// the coordinates of the three vertices
+typedef std::vector<float> Triangle;
+
+/// the triangles by their positions, which do not depend on the order of the vertices
+std::vector<Triangle> getTriangles(Mesh* mesh)
+{
+    SubMesh* sm = mesh->getSubMesh(0);
+    const VertexElement* posElem =
+        sm->vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf =
+        sm->vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+    std::vector<float> positions(vbuf->getSizeInBytes() / sizeof(float));
+    vbuf->readData(0, vbuf->getSizeInBytes(), positions.data());
+    size_t stride = vbuf->getVertexSize() / sizeof(float);
+
+    HardwareIndexBufferSharedPtr ibuf = sm->indexData->indexBuffer;
+    std::vector<uint16> indexes(ibuf->getNumIndexes());
+    ibuf->readData(0, ibuf->getSizeInBytes(), indexes.data());
+
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i < indexes.size(); i += 3)
+    {
+        Triangle tri;
+        for (int j = 0; j < 3; ++j)
+            tri.insert(tri.end(), &positions[indexes[i + j] * stride],
+                       &positions[indexes[i + j] * stride] + 3);
+        // start with the smallest vertex, but keep the winding
+        Triangle rotated = tri;
+        for (int j = 1; j < 3; ++j)
+        {
+            Triangle other(tri.begin() + 3 * j, tri.end());
+            other.insert(other.end(), tri.begin(), tri.begin() + 3 * j);
+            rotated = std::min(rotated, other);
+        }
+        triangles.push_back(rotated);
+    }
+    return triangles;
+}
+}
+
+typedef RootWithoutRenderSystemFixture MeshOptimiserTests;
+TEST_F(MeshOptimiserTests, KeepsTriangles)
+{
+    for (int overdraw = 0; overdraw < 2; ++overdraw)
+    {
+        MeshPtr mesh = createShuffledGrid("grid" + StringConverter::toString(overdraw), 30);
+        std::vector<Triangle> before = getTriangles(mesh.get());
+        MeshOptimiser::optimise(mesh.get(), overdraw != 0);
+        std::vector<Triangle> after = getTriangles(mesh.get());
+
+        EXPECT_NE(before, after);
+        std::sort(before.begin(), before.end());
+        std::sort(after.begin(), after.end());
+        EXPECT_EQ(before, after);
+    }
+}
+
+TEST_F(MeshOptimiserTests, KeepsLeadingDegenerateTriangles)
+{
+    MeshPtr mesh = createShuffledGrid("grid", 30, true);
+    std::vector<Triangle> before = getTriangles(mesh.get());
+    SubMesh* sm = mesh->getSubMesh(0);
+    MeshOptimiser::optimiseOverdraw(sm->indexData, sm->vertexData);
+    std::vector<Triangle> after = getTriangles(mesh.get());
+
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    EXPECT_EQ(before, after);
+}
+
+TEST_F(MeshOptimiserTests, ReducesCacheMisses)
+{
+    MeshPtr mesh = createShuffledGrid("grid", 30);
+    MeshOptimiser::VertexCacheStatistics before = MeshOptimiser::analyseVertexCache(mesh.get());
+    EXPECT_EQ(before.triangleCount, 30u * 30 * 2);
+    EXPECT_EQ(before.vertexCount, 31u * 31);
+    EXPECT_GT(before.acmr, 1.8f);
+
+    MeshOptimiser::optimise(mesh.get());
+    MeshOptimiser::VertexCacheStatistics after = MeshOptimiser::analyseVertexCache(mesh.get());
+    EXPECT_EQ(after.triangleCount, before.triangleCount);
+    EXPECT_LT(after.acmr, 0.8f);
+    EXPECT_LT(after.atvr, 1.5f);
+
+    // clustering for overdraw keeps most of it
+    MeshOptimiser::optimise(mesh.get(), true);
+    MeshOptimiser::VertexCacheStatistics clustered = MeshOptimiser::analyseVertexCache(mesh.get());
+    EXPECT_LT(clustered.acmr, after.acmr * 1.2f);
+}
+
+TEST_F(MeshOptimiserTests, RemapsBoneAssignments)
+{
+    MeshPtr mesh = createShuffledGrid("grid", 10);
+    SubMesh* sm = mesh->getSubMesh(0);
+    for (uint16 v = 0; v < sm->vertexData->vertexCount; ++v)
+    {
+        // the vertices of a row are assigned to the same bone
+        VertexBoneAssignment vba;
+        vba.vertexIndex = v;
+        vba.boneIndex = v / 11;
+        vba.weight = 1;
+        sm->addBoneAssignment(vba);
+    }
+
+    MeshOptimiser::optimise(mesh.get());
+
+    const VertexElement* posElem =
+        sm->vertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf =
+        sm->vertexData->vertexBufferBinding->getBuffer(posElem->getSource());
+    std::vector<float> positions(vbuf->getSizeInBytes() / sizeof(float));
+    vbuf->readData(0, vbuf->getSizeInBytes(), positions.data());
+    size_t stride = vbuf->getVertexSize() / sizeof(float);
+
+    ASSERT_EQ(sm->getBoneAssignments().size(), sm->vertexData->vertexCount);
+    SubMesh::VertexBoneAssignmentList::const_iterator i;
+    for (i = sm->getBoneAssignments().begin(); i != sm->getBoneAssignments().end(); ++i)
+    {
+        EXPECT_EQ(i->first, i->second.vertexIndex);
+        EXPECT_EQ(positions[i->second.vertexIndex * stride + 1], i->second.boneIndex);
+    }
+}
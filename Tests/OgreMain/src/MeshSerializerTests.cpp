@@ -222,6 +222,14 @@ TEST_F(MeshSerializerTests,Mesh_Version_1_3)
     testMesh(MESH_VERSION_1_0);
 }
 //--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Baked)
+{
+    MeshSerializer serializer;
+    serializer.exportBakedMesh(mOrigMesh.get(), mMeshFullPath);
+    mMesh->reload();
+    assertMeshClone(mOrigMesh.get(), mMesh.get());
+}
+//--------------------------------------------------------------------------
 #ifdef I_HAVE_LOT_OF_FREE_TIME
 TEST_F(MeshSerializerTests,Mesh_Version_1_2)
 {
@@ -0,0 +1,141 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Ogre.h"
+#include "OgreOptimisedUtil.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+struct ParticleSystemTests : public RootWithoutRenderSystemFixture
+{
+    std::unique_ptr<ControllerManager> mControllerMgr;
+
+    void SetUp()
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        // usually done by Root::initialise
+        mControllerMgr.reset(new ControllerManager());
+        ParticleSystemManager::getSingleton()._initialise();
+    }
+
+    void TearDown()
+    {
+        RootWithoutRenderSystemFixture::TearDown();
+        mControllerMgr.reset();
+    }
+};
+
+namespace
+{
+ParticleSystem* createAttachedSystem(SceneManager* sm, size_t quota)
+{
+    ParticleSystem* psys = sm->createParticleSystem(quota);
+    psys->setIterationInterval(0);
+    sm->getRootSceneNode()->attachObject(psys);
+    // allocates the pool
+    psys->_update(0);
+    return psys;
+}
+}
+
+TEST_F(ParticleSystemTests, ExpireKeepsOrder)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    ParticleSystem* psys = createAttachedSystem(sm, 100);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Particle* p = psys->createParticle();
+        ASSERT_TRUE(p);
+        p->mPosition = Vector3(Real(i), 0, 0);
+        p->mDirection = Vector3::ZERO;
+        p->mTimeToLive = (i % 3) ? 10.0f : 0.5f;
+    }
+    // quota reached
+    EXPECT_FALSE(psys->createParticle());
+
+    psys->_update(1);
+    ASSERT_EQ(psys->getNumParticles(), 66u);
+
+    Real last = -1;
+    for (auto p : psys->_getActiveParticleVector())
+    {
+        EXPECT_NE(int(p->mPosition.x) % 3, 0);
+        EXPECT_GT(p->mPosition.x, last);
+        EXPECT_FLOAT_EQ(p->mTimeToLive, 9.0f);
+        last = p->mPosition.x;
+    }
+    EXPECT_EQ(psys->getParticle(1)->mPosition.x, 2);
+
+    // expired particles are available again
+    for (int i = 0; i < 34; ++i)
+        EXPECT_TRUE(psys->createParticle());
+    EXPECT_FALSE(psys->createParticle());
+
+    psys->clear();
+    EXPECT_EQ(psys->getNumParticles(), 0u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(psys->createParticle());
+    EXPECT_FALSE(psys->createParticle());
+}
+
+TEST(ParticleColourTests, SIMDMatchesGeneral)
+{
+    OptimisedUtil* simd = OptimisedUtil::getImplementation();
+    OptimisedUtil* general = OptimisedUtil::getGeneralImplementation();
+
+    // values on both sides of the clamping range, some exactly at the limits
+    const size_t count = 103;
+    std::vector<Particle> a(count), b(count);
+    std::vector<Particle*> pa(count), pb(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ColourValue c(Real(i % 7) / 4 - 0.5f, Real(i % 5) / 4, Real(i % 11) / 8 - 0.25f, Real(i % 3) / 2);
+        a[i].mColour = b[i].mColour = c;
+        pa[i] = &a[i];
+        pb[i] = &b[i];
+    }
+
+    const ColourValue adjust[] = {ColourValue(0.3f, -0.2f, 0.7f, -1.0f), ColourValue(-0.6f, 0.25f, 0, 2.0f)};
+    for (const ColourValue& adj : adjust)
+    {
+        simd->adjustParticleColours(&pa[0], count, adj);
+        general->adjustParticleColours(&pb[0], count, adj);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                ASSERT_EQ(a[i].mColour[c], b[i].mColour[c]) << i << ", " << c;
+                EXPECT_GE(a[i].mColour[c], 0);
+                EXPECT_LE(a[i].mColour[c], 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+#include "OgreProfiler.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace Ogre;
+
+namespace
+{
+const ProfileMarker gFrameMarker = {"frame work", OGREPROF_GENERAL};
+const ProfileMarker gWorkerMarker = {"worker \"task\"", OGREPROF_CULLING};
+const ProfileMarker gUserMarker = {"user", OGREPROF_USER_DEFAULT};
+
+size_t countOccurrences(const String& str, const String& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = str.find(pattern); pos != String::npos; pos = str.find(pattern, pos + 1))
+        ++count;
+    return count;
+}
+
+String getChromeTrace(const Profiler& profiler)
+{
+    std::stringstream stream;
+    profiler.writeChromeTrace(stream);
+    return stream.str();
+}
+}
+
+TEST(ProfilerTests, TraceDisabled)
+{
+    Profiler profiler;
+    EXPECT_FALSE(profiler.getTraceEnabled());
+    {
+        ProfileScope scope(&gFrameMarker);
+    }
+    EXPECT_EQ(countOccurrences(getChromeTrace(profiler), "frame work"), 0u);
+
+    profiler.setTraceEnabled(true);
+    profiler.setProfileGroupMask(OGREPROF_ALL);
+    {
+        ProfileScope scope(&gUserMarker);
+        ProfileScope inner(&gFrameMarker);
+    }
+    String trace = getChromeTrace(profiler);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"user\""), 0u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"frame work\",\"cat\":\"general\",\"ph\":\"X\""), 1u);
+}
+
+TEST(ProfilerTests, ChromeTraceLastFrames)
+{
+    Profiler profiler;
+    profiler.setTraceEnabled(true);
+    profiler.setTraceFrameCount(2);
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        profiler._markTraceFrame();
+        ProfileScope scope(&gFrameMarker);
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 3; ++i)
+        {
+            workers.emplace_back([]() {
+                for (int j = 0; j < 10; ++j)
+                    ProfileScope scope(&gWorkerMarker);
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+    }
+
+    String trace = getChromeTrace(profiler);
+    EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"Frame\""), 2u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"frame work\""), 2u);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"worker \\\"task\\\"\",\"cat\":\"culling\""), 60u);
+
+    // main thread and the workers of the exported frames, the buffers of the others are freed
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"thread_name\""), 8u);
+    EXPECT_EQ(countOccurrences(trace, "\"tid\":7,\"args\""), 0u);
+    EXPECT_EQ(countOccurrences(trace, "\"tid\":13,\"args\""), 1u);
+}
+
+TEST(ProfilerTests, TraceRingBufferOverflow)
+{
+    Profiler profiler;
+    profiler.setTraceEnabled(true);
+
+    uint64 now = Profiler::getTraceTimestamp();
+    for (int i = 0; i < 100000; ++i)
+        profiler._recordTraceEvent(&gFrameMarker, now + i, now + i + 1);
+
+    // the oldest events were overwritten
+    String trace = getChromeTrace(profiler);
+    size_t count = countOccurrences(trace, "\"name\":\"frame work\"");
+    EXPECT_GT(count, 60000u);
+    EXPECT_LT(count, 100000u);
+}
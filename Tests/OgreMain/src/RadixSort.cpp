@@ -203,5 +203,37 @@ TEST_F(RadixSortTests,IntVector)
     }
 }
 //--------------------------------------------------------------------------
+class PackedKeySortFunctor
+{
+public:
+    uint64 operator()(const std::pair<uint64, int>& p) const
+    {
+        return p.first;
+    }
+};
+//--------------------------------------------------------------------------
+TEST_F(RadixSortTests,PackedKeyVectorIsStable)
+{
+    typedef std::vector<std::pair<uint64, int> > PairVector;
+    PairVector container;
+    PackedKeySortFunctor func;
+    RadixSort<PairVector, std::pair<uint64, int>, uint64> sorter;
 
+    // few distinct values in the high and low bits, the bytes in between are zero
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64 key = (uint64(Math::RangeRandom(0, 16)) << 56) | uint64(Math::RangeRandom(0, 100));
+        container.push_back(std::make_pair(key, i));
+    }
+
+    sorter.sort(container, func);
 
+    PairVector::iterator v = container.begin();
+    std::pair<uint64, int> last = *v++;
+    for (;v != container.end(); ++v)
+    {
+        EXPECT_TRUE(v->first > last.first || (v->first == last.first && v->second > last.second));
+        last = *v;
+    }
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <gtest/gtest.h>
+#include "OgreMaterialManager.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreTechnique.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+using namespace Ogre;
+
+namespace
+{
+/// a renderable at a fixed distance from the camera
+class TestRenderable : public Renderable
+{
+    MaterialPtr mMaterial;
+    Real mDepth;
+    LightList mLights;
+
+public:
+    TestRenderable(const MaterialPtr& material, Real depth) : mMaterial(material), mDepth(depth) {}
+    const MaterialPtr& getMaterial(void) const { return mMaterial; }
+    void getRenderOperation(RenderOperation& op) {}
+    void getWorldTransforms(Matrix4* xform) const { *xform = Matrix4::IDENTITY; }
+    Real getSquaredViewDepth(const Camera* cam) const { return mDepth; }
+    const LightList& getLights(void) const { return mLights; }
+};
+
+/// records the order of the visits
+struct RecordingVisitor : public QueuedRenderableVisitor
+{
+    std::vector<RenderablePass> visited;
+    std::vector<std::pair<const Pass*, RenderableList> > groups;
+
+    void visit(RenderablePass* rp) { visited.push_back(*rp); }
+    bool visit(const Pass* p)
+    {
+        groups.push_back(std::make_pair(p, RenderableList()));
+        return true;
+    }
+    void visit(const Pass* p, RenderableList& rs) { groups.push_back(std::make_pair(p, rs)); }
+    void visit(Renderable* r) { groups.back().second.push_back(r); }
+};
+
+struct RenderQueueTests : public RootWithoutRenderSystemFixture
+{
+    std::vector<MaterialPtr> mMaterials;
+    std::vector<TestRenderable*> mRenderables;
+
+    void SetUp()
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        srand(0);
+        for (int i = 0; i < 64; ++i)
+        {
+            MaterialPtr mat = MaterialManager::getSingleton().create(
+                "RenderQueueTest" + StringConverter::toString(i), RGN_DEFAULT);
+            // a few passes per material, so the hashes differ by pass index
+            Technique* tech = mat->getTechnique(0);
+            tech->createPass();
+            tech->createPass();
+            mMaterials.push_back(mat);
+        }
+    }
+
+    void TearDown()
+    {
+        for (size_t i = 0; i < mRenderables.size(); ++i)
+            delete mRenderables[i];
+        RootWithoutRenderSystemFixture::TearDown();
+    }
+
+    void createRenderables(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            // distinct depths, the order of equal depths is not defined
+            Real depth = Real(mRenderables.size());
+            mRenderables.push_back(
+                new TestRenderable(mMaterials[rand() % mMaterials.size()], depth));
+        }
+        std::random_shuffle(mRenderables.begin(), mRenderables.end());
+    }
+
+    void fill(QueuedRenderableCollection& collection)
+    {
+        for (size_t i = 0; i < mRenderables.size(); ++i)
+        {
+            Technique* tech = mRenderables[i]->getMaterial()->getTechnique(0);
+            collection.addRenderable(tech->getPass(i % tech->getNumPasses()), mRenderables[i]);
+        }
+    }
+};
+}
+
+TEST_F(RenderQueueTests, SortKeysMatchPassGroups)
+{
+    createRenderables(3000);
+
+    QueuedRenderableCollection grouped;
+    grouped.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    QueuedRenderableCollection keyed;
+    keyed.addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+    keyed.setSortKeysEnabled(true);
+
+    fill(grouped);
+    fill(keyed);
+    grouped.sort(NULL);
+    keyed.sort(NULL);
+
+    RecordingVisitor groupedVisitor, keyedVisitor;
+    grouped.acceptVisitor(&groupedVisitor, QueuedRenderableCollection::OM_PASS_GROUP);
+    keyed.acceptVisitor(&keyedVisitor, QueuedRenderableCollection::OM_PASS_GROUP);
+
+    // every pass is visited once, in order of the hash
+    ASSERT_FALSE(keyedVisitor.groups.empty());
+    std::set<const Pass*> passes;
+    for (size_t i = 0; i < keyedVisitor.groups.size(); ++i)
+    {
+        EXPECT_TRUE(passes.insert(keyedVisitor.groups[i].first).second);
+        if (i > 0)
+            EXPECT_LE(keyedVisitor.groups[i - 1].first->getHash(),
+                      keyedVisitor.groups[i].first->getHash());
+    }
+
+    // passes with equal hashes may be swapped, but hold the same renderables in the same order
+    std::sort(groupedVisitor.groups.begin(), groupedVisitor.groups.end());
+    std::sort(keyedVisitor.groups.begin(), keyedVisitor.groups.end());
+    EXPECT_EQ(groupedVisitor.groups, keyedVisitor.groups);
+}
+
+TEST_F(RenderQueueTests, SortKeysMatchDepthSort)
+{
+    // below and above the size at which the classic sort switches to a radix sort
+    const size_t counts[] = {100, 5000};
+    for (int c = 0; c < 2; ++c)
+    {
+        createRenderables(counts[c]);
+
+        QueuedRenderableCollection sorted;
+        sorted.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+        QueuedRenderableCollection keyed;
+        keyed.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+        keyed.setSortKeysEnabled(true);
+
+        fill(sorted);
+        fill(keyed);
+        sorted.sort(NULL);
+        keyed.sort(NULL);
+
+        const QueuedRenderableCollection::OrganisationMode modes[] = {
+            QueuedRenderableCollection::OM_SORT_DESCENDING,
+            QueuedRenderableCollection::OM_SORT_ASCENDING};
+        for (int m = 0; m < 2; ++m)
+        {
+            RecordingVisitor sortedVisitor, keyedVisitor;
+            sorted.acceptVisitor(&sortedVisitor, modes[m]);
+            keyed.acceptVisitor(&keyedVisitor, modes[m]);
+
+            ASSERT_EQ(sortedVisitor.visited.size(), mRenderables.size());
+            ASSERT_EQ(keyedVisitor.visited.size(), mRenderables.size());
+            for (size_t i = 0; i < sortedVisitor.visited.size(); ++i)
+            {
+                EXPECT_EQ(sortedVisitor.visited[i].renderable, keyedVisitor.visited[i].renderable);
+                EXPECT_EQ(sortedVisitor.visited[i].pass, keyedVisitor.visited[i].pass);
+            }
+        }
+    }
+}
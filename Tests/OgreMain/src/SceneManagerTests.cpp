@@ -0,0 +1,312 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Ogre.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+/// records the order in which it was queued for rendering
+struct QueueRecorder : public MovableObject
+{
+    std::vector<size_t>* mOrder;
+    size_t mId;
+    AxisAlignedBox mBox;
+
+    QueueRecorder(std::vector<size_t>* order, size_t id)
+        : mOrder(order), mId(id), mBox(Vector3(-1), Vector3(1))
+    {
+    }
+    const String& getMovableType(void) const
+    {
+        static String type = "QueueRecorder";
+        return type;
+    }
+    const AxisAlignedBox& getBoundingBox(void) const { return mBox; }
+    Real getBoundingRadius(void) const { return mBox.getHalfSize().length(); }
+    void _updateRenderQueue(RenderQueue* queue) { mOrder->push_back(mId); }
+    void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+};
+
+struct SceneGraphFixture : public RootWithoutRenderSystemFixture
+{
+    std::vector<SceneNode*> createHierarchy(SceneManager* sm, size_t branching, size_t depth,
+                                            bool withEntities = true)
+    {
+        // we want cross platform consistent sequence
+        std::minstd_rand rng;
+        auto rand = [&rng](Real scale) { return scale * (Real(rng()) / rng.max() - 0.5f); };
+
+        std::vector<SceneNode*> nodes(1, sm->getRootSceneNode());
+        size_t levelBegin = 0;
+        for (size_t d = 0; d < depth; ++d)
+        {
+            size_t levelEnd = nodes.size();
+            for (size_t p = levelBegin; p < levelEnd; ++p)
+            {
+                for (size_t c = 0; c < branching; ++c)
+                {
+                    SceneNode* node = nodes[p]->createChildSceneNode(
+                        Vector3(rand(100), rand(100), rand(100)),
+                        Quaternion(Radian(rand(3)), Vector3::UNIT_Y));
+                    node->setScale(Vector3(1 + rand(0.5)));
+                    if (withEntities)
+                        node->attachObject(sm->createEntity("cube.mesh"));
+                    nodes.push_back(node);
+                }
+            }
+            levelBegin = levelEnd;
+        }
+        return nodes;
+    }
+
+    /// attaches a QueueRecorder to every node, outliving the SceneManager
+    void attachRecorders(const std::vector<SceneNode*>& nodes, std::vector<size_t>* order)
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            mRecorders.emplace_back(new QueueRecorder(order, i));
+            nodes[i]->attachObject(mRecorders.back().get());
+        }
+    }
+
+    std::vector<std::unique_ptr<QueueRecorder>> mRecorders;
+};
+}
+
+typedef SceneGraphFixture SceneGraphUpdate;
+TEST_F(SceneGraphUpdate, ParallelMatchesSerial)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* serialSM = mRoot->createSceneManager();
+    SceneManager* parallelSM = mRoot->createSceneManager();
+    parallelSM->setParallelSceneGraphUpdate(true);
+
+    std::vector<SceneNode*> serial = createHierarchy(serialSM, 6, 4);
+    std::vector<SceneNode*> parallel = createHierarchy(parallelSM, 6, 4);
+    ASSERT_EQ(serial.size(), parallel.size());
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        serialSM->_updateSceneGraph(NULL);
+        parallelSM->_updateSceneGraph(NULL);
+
+        for (size_t i = 0; i < serial.size(); ++i)
+        {
+            ASSERT_EQ(serial[i]->_getDerivedPosition(), parallel[i]->_getDerivedPosition());
+            ASSERT_EQ(serial[i]->_getDerivedOrientation(), parallel[i]->_getDerivedOrientation());
+            ASSERT_EQ(serial[i]->_getWorldAABB(), parallel[i]->_getWorldAABB());
+        }
+
+        // only update a few selected branches in the next frame
+        for (size_t i = 7; i < serial.size(); i += 97)
+        {
+            serial[i]->translate(Vector3(10, 0, 0));
+            parallel[i]->translate(Vector3(10, 0, 0));
+        }
+    }
+
+    mRoot->getWorkQueue()->shutdown();
+}
+
+namespace
+{
+/// counts how often it is updated
+struct CountingSceneNode : public SceneNode
+{
+    int mUpdates;
+    CountingSceneNode(SceneManager* creator) : SceneNode(creator), mUpdates(0) {}
+    void _update(bool updateChildren, bool parentHasChanged) override
+    {
+        ++mUpdates;
+        SceneNode::_update(updateChildren, parentHasChanged);
+    }
+};
+}
+
+TEST_F(SceneGraphUpdate, ParallelUsesUpdateOverrides)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sm = mRoot->createSceneManager();
+    sm->setParallelSceneGraphUpdate(true);
+
+    CountingSceneNode node(sm);
+    sm->getRootSceneNode()->addChild(&node);
+    SceneNode* child = node.createChildSceneNode(Vector3(0, 5, 0));
+
+    sm->_updateSceneGraph(NULL);
+    EXPECT_EQ(node.mUpdates, 1);
+    EXPECT_EQ(child->_getDerivedPosition(), Vector3(0, 5, 0));
+
+    node.translate(Vector3(10, 0, 0));
+    sm->_updateSceneGraph(NULL);
+    EXPECT_EQ(node.mUpdates, 2);
+    EXPECT_EQ(child->_getDerivedPosition(), Vector3(10, 5, 0));
+
+    mRoot->getWorkQueue()->shutdown();
+}
+
+typedef SceneGraphFixture VisibilityCulling;
+TEST_F(VisibilityCulling, ParallelMatchesSerial)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* serialSM = mRoot->createSceneManager();
+    SceneManager* parallelSM = mRoot->createSceneManager();
+    parallelSM->setParallelVisibilityCulling(true);
+
+    std::vector<size_t> serialOrder, parallelOrder;
+    // entities can not be queued without a RenderSystem
+    std::vector<SceneNode*> serial = createHierarchy(serialSM, 6, 4, false);
+    std::vector<SceneNode*> parallel = createHierarchy(parallelSM, 6, 4, false);
+    attachRecorders(serial, &serialOrder);
+    attachRecorders(parallel, &parallelOrder);
+
+    Camera* serialCam = serialSM->createCamera("cam");
+    Camera* parallelCam = parallelSM->createCamera("cam");
+    serialSM->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 150))->attachObject(serialCam);
+    parallelSM->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 150))->attachObject(parallelCam);
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        serialSM->_updateSceneGraph(serialCam);
+        parallelSM->_updateSceneGraph(parallelCam);
+
+        VisibleObjectsBoundsInfo serialBounds, parallelBounds;
+        serialBounds.reset();
+        parallelBounds.reset();
+        serialOrder.clear();
+        parallelOrder.clear();
+        serialSM->_findVisibleObjects(serialCam, &serialBounds, false);
+        parallelSM->_findVisibleObjects(parallelCam, &parallelBounds, false);
+
+        // something got culled, but not everything
+        EXPECT_LT(serialOrder.size(), serial.size());
+        EXPECT_GT(serialOrder.size(), 0u);
+
+        ASSERT_EQ(serialOrder, parallelOrder);
+        EXPECT_EQ(serialBounds.aabb, parallelBounds.aabb);
+        EXPECT_EQ(serialBounds.minDistance, parallelBounds.minDistance);
+        EXPECT_EQ(serialBounds.maxDistance, parallelBounds.maxDistance);
+
+        // look somewhere else in the next frame
+        serialCam->getParentSceneNode()->yaw(Degree(60));
+        parallelCam->getParentSceneNode()->yaw(Degree(60));
+    }
+
+    mRoot->getWorkQueue()->shutdown();
+}
+
+namespace
+{
+/// makes the light culling accessible without rendering
+struct LightTestSceneManager : public DefaultSceneManager
+{
+    LightTestSceneManager() : DefaultSceneManager("LightTestSceneManager") {}
+    using SceneManager::findLightsAffectingFrustum;
+};
+
+struct LightListFixture : public RootWithoutRenderSystemFixture
+{
+    std::minstd_rand mRng;
+    Real rand(Real scale) { return scale * (Real(mRng()) / mRng.max() - 0.5f); }
+
+    /// point and spot lights spread over the scene, a few directional and huge ones
+    void createLights(SceneManager* sm, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Light* light = sm->createLight();
+            if (i % 50 == 0)
+            {
+                light->setType(Light::LT_DIRECTIONAL);
+                light->setDirection(Vector3(0, -1, 0));
+            }
+            else if (i % 3 == 0)
+            {
+                light->setType(Light::LT_SPOTLIGHT);
+                light->setDirection(Vector3(rand(2), -1, rand(2)).normalisedCopy());
+            }
+            light->setAttenuation(i % 37 == 0 ? 100000 : 20 + rand(20), 1, 0, 0);
+            light->setLightMask(i % 7 == 0 ? 2 : 1);
+            sm->getRootSceneNode()
+                ->createChildSceneNode(Vector3(rand(1000), rand(1000), rand(1000)))
+                ->attachObject(light);
+        }
+
+        Camera* cam = sm->createCamera("cam");
+        sm->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 600))->attachObject(cam);
+        sm->_updateSceneGraph(cam);
+        static_cast<LightTestSceneManager*>(sm)->findLightsAffectingFrustum(cam);
+    }
+
+    /// the lights in range, tested one by one
+    static void populateLightListLinear(SceneManager* sm, const Vector3& position, Real radius,
+                                        LightList& destList, uint32 lightMask)
+    {
+        destList.clear();
+        const LightList& lights = sm->_getLightsAffectingFrustum();
+        for (size_t i = 0; i < lights.size(); ++i)
+        {
+            if (!(lights[i]->getLightMask() & lightMask))
+                continue;
+            lights[i]->_calcTempSquareDist(position);
+            if (lights[i]->isInLightRange(Sphere(position, radius)))
+                destList.push_back(lights[i]);
+        }
+        std::stable_sort(destList.begin(), destList.end(), SceneManager::lightLess());
+    }
+};
+}
+
+TEST_F(LightListFixture, GridMatchesLinearScan)
+{
+    LightTestSceneManager sm;
+    createLights(&sm, 500);
+    ASSERT_GT(sm._getLightsAffectingFrustum().size(), 100u);
+
+    LightList expected, lights;
+    for (int i = 0; i < 2000; ++i)
+    {
+        Vector3 position(rand(1200), rand(1200), rand(1200));
+        // mostly small objects, some covering large parts of the scene
+        Real radius = i % 100 == 0 ? 400 : 1 + rand(10) + 5;
+        uint32 mask = i % 5 == 0 ? 2 : 0xFFFFFFFF;
+
+        populateLightListLinear(&sm, position, radius, expected, mask);
+        sm._populateLightList(position, radius, lights, mask);
+        ASSERT_EQ(std::vector<Light*>(expected.begin(), expected.end()),
+                  std::vector<Light*>(lights.begin(), lights.end()));
+    }
+}
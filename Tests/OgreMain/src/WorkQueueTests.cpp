@@ -0,0 +1,161 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreRoot.h"
+#include "OgreTimer.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "RootWithoutRenderSystemFixture.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Ogre;
+
+namespace
+{
+/// doubles the request data, failing while retries are left if asked to
+struct DoublingHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+{
+    std::atomic<size_t> mProcessed;
+    std::vector<std::pair<WorkQueue::RequestID, int> > mResults;
+    bool mFailFirst;
+
+    DoublingHandler(bool failFirst = false) : mProcessed(0), mFailFirst(failFirst) {}
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        ++mProcessed;
+        bool success = !mFailFirst || req->getRetryCount() == 0;
+        return OGRE_NEW WorkQueue::Response(req, success, Any(any_cast<int>(req->getData()) * 2));
+    }
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+    {
+        if (res->succeeded())
+            mResults.push_back(std::make_pair(res->getRequest()->getID(), any_cast<int>(res->getData())));
+    }
+
+    /// pump responses until count of them arrived
+    void waitForResults(WorkQueue* queue, size_t count)
+    {
+        Timer timer;
+        while (mResults.size() < count && timer.getMilliseconds() < 10000)
+        {
+            queue->processResponses();
+            std::this_thread::yield();
+        }
+    }
+};
+
+typedef RootWithoutRenderSystemFixture WorkQueueTests;
+}
+
+TEST_F(WorkQueueTests, WorkStealingProcessesAll)
+{
+    WorkStealingWorkQueue queue;
+    queue.setWorkerThreadCount(3);
+    queue.setResponseProcessingTimeLimit(0);
+
+    // failing requests must be retried
+    DoublingHandler handler(true);
+    uint16 channel = queue.getChannel("Test");
+    queue.addRequestHandler(channel, &handler);
+    queue.addResponseHandler(channel, &handler);
+
+    // some are queued before the workers start
+    std::vector<WorkQueue::RequestID> ids;
+    for (int i = 0; i < 10; ++i)
+        ids.push_back(queue.addRequest(channel, 0, Any(i), 1));
+    queue.startup();
+    for (int i = 10; i < 1000; ++i)
+        ids.push_back(queue.addRequest(channel, 0, Any(i), 1));
+
+    handler.waitForResults(&queue, ids.size());
+    ASSERT_EQ(handler.mResults.size(), ids.size());
+    EXPECT_EQ(handler.mProcessed, 2 * ids.size());
+
+    std::sort(handler.mResults.begin(), handler.mResults.end());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        EXPECT_EQ(handler.mResults[i].first, ids[i]);
+        EXPECT_EQ(handler.mResults[i].second, int(2 * i));
+    }
+
+    // tasks and parallelFor go through the same queues
+    std::vector<int> items(1000, 0);
+    queue.parallelFor(items.size(), [&items](size_t i) { items[i] = int(i); });
+    for (size_t i = 0; i < items.size(); ++i)
+        EXPECT_EQ(items[i], int(i));
+
+    queue.shutdown();
+    queue.removeRequestHandler(channel, &handler);
+    queue.removeResponseHandler(channel, &handler);
+}
+
+TEST_F(WorkQueueTests, WorkStealingAbortPending)
+{
+    WorkStealingWorkQueue queue;
+    queue.setWorkerThreadCount(2);
+    queue.setResponseProcessingTimeLimit(0);
+    queue.startup();
+
+    DoublingHandler handler;
+    uint16 kept = queue.getChannel("Kept");
+    uint16 aborted = queue.getChannel("Aborted");
+    for (uint16 channel : {kept, aborted})
+    {
+        queue.addRequestHandler(channel, &handler);
+        queue.addResponseHandler(channel, &handler);
+    }
+
+    queue.setPaused(true);
+    WorkQueue::RequestID single = queue.addRequest(kept, 0, Any(-1));
+    for (int i = 0; i < 100; ++i)
+    {
+        queue.addRequest(kept, 0, Any(i));
+        queue.addRequest(aborted, 0, Any(i));
+    }
+    EXPECT_TRUE(queue.abortPendingRequest(single));
+    queue.abortPendingRequestsByChannel(aborted);
+    queue.setPaused(false);
+
+    handler.waitForResults(&queue, 100);
+    // give stray aborted requests a chance to show up
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.processResponses();
+
+    EXPECT_EQ(handler.mResults.size(), 100u);
+    EXPECT_EQ(handler.mProcessed, 100u);
+
+    queue.shutdown();
+    for (uint16 channel : {kept, aborted})
+    {
+        queue.removeRequestHandler(channel, &handler);
+        queue.removeResponseHandler(channel, &handler);
+    }
+}
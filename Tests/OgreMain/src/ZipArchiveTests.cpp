@@ -29,8 +29,11 @@ THE SOFTWARE.
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreCommon.h"
 #include "OgreConfigFile.h"
+#include "OgreException.h"
 #include "OgreFileSystemLayer.h"
 
+#include <thread>
+
 using namespace Ogre;
 
 static String fileId(const String& path) {
@@ -250,3 +253,58 @@ TEST_F(ZipArchiveTests,ReadInterleave)
     EXPECT_TRUE(stream2->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,ConcurrentOpen)
+{
+    StringVectorPtr files = arch->list(true);
+    StringVector expected;
+    for (const String& file : *files)
+        expected.push_back(arch->open(file)->getAsString());
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (size_t t = 0; t < mismatches.size(); ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 100; ++i)
+                for (size_t f = 0; f < files->size(); ++f)
+                    if (arch->open(files->at(f))->getAsString() != expected[f])
+                        ++mismatches[t];
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (int count : mismatches)
+        EXPECT_EQ(0, count);
+}
+//--------------------------------------------------------------------------
+TEST(ZipArchiveDuplicateTests,ExistsMatchesOpen)
+{
+    Ogre::ConfigFile cf;
+    cf.load(Ogre::FileSystemLayer(OGRE_VERSION_NAME).getConfigFilePath("resources.cfg"));
+    Ogre::String testPath = cf.getSettings("Tests").begin()->second+"/misc/ArchiveTestDuplicates.zip";
+
+    std::unique_ptr<Archive> arch(ZipArchiveFactory().createInstance(testPath, true));
+    arch->load();
+
+    const char* names[] = {"file.txt", "level1/file.txt", "level2/file.txt", "unique.txt", "missing.txt"};
+    for (const char* name : names)
+    {
+        bool opened = true;
+        try
+        {
+            arch->open(name);
+        }
+        catch (const FileNotFoundException&)
+        {
+            opened = false;
+        }
+        EXPECT_EQ(opened, arch->exists(name)) << name;
+    }
+
+    // two files share the basename, so it does not name either of them
+    EXPECT_FALSE(arch->exists("file.txt"));
+    EXPECT_TRUE(arch->exists("level2/file.txt"));
+    EXPECT_EQ(String("level2"), arch->open("level2/file.txt")->getLine());
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,277 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+
+#include "Ogre.h"
+#include "OgreMeshSerializer.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMeshLodGenerator.h"
+#include "OgreDistanceLodStrategy.h"
+#include "OgreLodConfig.h"
+#include "OgreWorkQueue.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+
+namespace {
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgreMeshLodBatch: Generates LOD levels for many .mesh files in parallel." << endl << endl;
+    cout << "Usage: OgreMeshLodBatch [opts] sourcefile [sourcefile ...]" << endl;
+    cout << "-l lodlevels   = number of LOD levels, autoconfigured LOD if not given" << endl;
+    cout << "-d loddist     = distance increment to reduce LOD" << endl;
+    cout << "-p lodpercent  = Percentage vertex reduction amount per LOD" << endl;
+    cout << "-f lodnumverts = Fixed vertex reduction per LOD" << endl;
+    cout << "-threads count = number of worker threads (default: all cores)" << endl;
+    cout << "-o directory   = write the meshes to this directory. If you don't" << endl;
+    cout << "                 specify this OGRE overwrites the existing files." << endl;
+    cout << "-E endian      = Set endian mode 'big' 'little' or 'native' (default)" << endl;
+    cout << "-q             = Quiet mode, less output" << endl;
+    cout << "sourcefile     = name of a file to convert" << endl;
+
+    cout << endl;
+}
+
+struct BatchOptions {
+    unsigned short numLods;
+    Real lodDist;
+    Real lodPercent;
+    size_t lodFixed;
+    bool usePercent;
+    size_t threads;
+    String outDir;
+    Serializer::Endian endian;
+    bool quiet;
+};
+
+BatchOptions opts;
+
+void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
+{
+    opts.numLods = 0;
+    opts.lodDist = 500;
+    opts.lodPercent = 20;
+    opts.lodFixed = 0;
+    opts.usePercent = true;
+    opts.threads = OGRE_THREAD_HARDWARE_CONCURRENCY;
+    opts.endian = Serializer::ENDIAN_NATIVE;
+    opts.quiet = unOpts["-q"];
+
+    BinaryOptionList::iterator bi = binOpts.find("-l");
+    if (!bi->second.empty()) {
+        opts.numLods = StringConverter::parseInt(bi->second);
+    }
+
+    bi = binOpts.find("-d");
+    if (!bi->second.empty()) {
+        opts.lodDist = StringConverter::parseReal(bi->second);
+    }
+
+    bi = binOpts.find("-p");
+    if (!bi->second.empty()) {
+        opts.lodPercent = StringConverter::parseReal(bi->second);
+        opts.usePercent = true;
+    }
+
+    bi = binOpts.find("-f");
+    if (!bi->second.empty()) {
+        opts.lodFixed = StringConverter::parseInt(bi->second);
+        opts.usePercent = false;
+    }
+
+    bi = binOpts.find("-threads");
+    if (!bi->second.empty()) {
+        opts.threads = StringConverter::parseInt(bi->second);
+    }
+
+    bi = binOpts.find("-o");
+    if (!bi->second.empty()) {
+        opts.outDir = bi->second;
+    }
+
+    bi = binOpts.find("-E");
+    if (!bi->second.empty()) {
+        if (bi->second == "big")
+            opts.endian = Serializer::ENDIAN_BIG;
+        else if (bi->second == "little")
+            opts.endian = Serializer::ENDIAN_LITTLE;
+        else
+            opts.endian = Serializer::ENDIAN_NATIVE;
+    }
+}
+
+void createLodConfig(MeshPtr& mesh, LodConfig& lodConfig)
+{
+    lodConfig.mesh = mesh;
+    if (opts.numLods == 0) {
+        MeshLodGenerator::getSingleton().getAutoconfig(mesh, lodConfig);
+        return;
+    }
+
+    // same levels as OgreMeshUpgrader creates from the command line
+    lodConfig.strategy = DistanceLodBoxStrategy::getSingletonPtr();
+    LodLevel lodLevel;
+    lodLevel.distance = 0.0;
+    lodLevel.reductionValue = 0.0;
+    for (unsigned short iLod = 0; iLod < opts.numLods; ++iLod) {
+        lodLevel.reductionMethod = opts.usePercent ?
+                                   LodLevel::VRM_PROPORTIONAL : LodLevel::VRM_CONSTANT;
+        if (opts.usePercent) {
+            lodLevel.reductionValue += opts.lodPercent * 0.01f;
+        } else {
+            lodLevel.reductionValue += (Ogre::Real)opts.lodFixed;
+        }
+
+        lodLevel.distance += opts.lodDist;
+        lodConfig.levels.push_back(lodLevel);
+    }
+}
+
+struct MaterialCreator : public MeshSerializerListener
+{
+    void processMaterialName(Mesh *mesh, String *name)
+    {
+        // create material because we do not load any .material files
+        MaterialManager::getSingleton().createOrRetrieve(*name, mesh->getGroup());
+    }
+
+    void processSkeletonName(Mesh *mesh, String *name) {}
+    void processMeshCompleted(Mesh *mesh) {}
+};
+
+struct ProgressPrinter : public LodBatchListener
+{
+    void lodLevelsGenerated(LodConfig& lodConfig, size_t finishedCount, size_t totalCount)
+    {
+        if (opts.quiet)
+            return;
+        cout << "[" << finishedCount << "/" << totalCount << "] " << lodConfig.mesh->getName() << ": "
+             << lodConfig.mesh->getNumLodLevels() - 1 << " LOD levels" << endl;
+    }
+};
+}
+
+int main(int numargs, char** args)
+{
+    if (numargs < 2) {
+        help();
+        return -1;
+    }
+
+    UnaryOptionList unOptList;
+    BinaryOptionList binOptList;
+
+    unOptList["-q"] = false;
+    binOptList["-l"] = "";
+    binOptList["-d"] = "";
+    binOptList["-p"] = "";
+    binOptList["-f"] = "";
+    binOptList["-threads"] = "";
+    binOptList["-o"] = "";
+    binOptList["-E"] = "";
+
+    int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+    parseOpts(unOptList, binOptList);
+    if (startIdx >= numargs) {
+        help();
+        return -1;
+    }
+
+    int retCode = 0;
+    LogManager* logMgr = 0;
+    Root* root = 0;
+    DefaultHardwareBufferManager* bufferManager = 0;
+    MeshLodGenerator* lodGenerator = 0;
+    try
+    {
+        // only print the progress to the console
+        logMgr = new LogManager();
+        logMgr->createLog("OgreMeshLodBatch.log", true, false);
+        // no plugins and no render system, but the managers and the WorkQueue of Root
+        root = new Root("", "", "");
+        bufferManager = new DefaultHardwareBufferManager();
+        MaterialManager::getSingleton().initialise();
+        // don't pad during conversion
+        MeshManager::getSingleton().setBoundsPaddingFactor(0.0f);
+        lodGenerator = new MeshLodGenerator();
+
+        DefaultWorkQueueBase* wq = static_cast<DefaultWorkQueueBase*>(root->getWorkQueue());
+        wq->setWorkerThreadCount(std::max<size_t>(1, opts.threads));
+        wq->startup();
+
+        MeshSerializer meshSerializer;
+        MaterialCreator matCreator;
+        meshSerializer.setListener(&matCreator);
+        ProgressPrinter progress;
+
+        // Keep only a limited number of meshes in memory.
+        const int batchSize = 256;
+        for (int begin = startIdx; begin < numargs; begin += batchSize) {
+            int end = std::min(numargs, begin + batchSize);
+            std::vector<LodConfig> lodConfigs(end - begin);
+            for (int i = begin; i < end; ++i) {
+                String source(args[i]);
+                MeshPtr mesh = MeshManager::getSingleton().createManual(
+                    source, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+                DataStreamPtr stream = Root::openFileStream(source);
+                meshSerializer.importMesh(stream, mesh.get());
+                createLodConfig(mesh, lodConfigs[i - begin]);
+            }
+
+            lodGenerator->generateLodLevelsBatch(lodConfigs, &progress);
+
+            for (size_t i = 0; i < lodConfigs.size(); ++i) {
+                MeshPtr& mesh = lodConfigs[i].mesh;
+                String dest = mesh->getName();
+                if (!opts.outDir.empty()) {
+                    String baseName, path;
+                    StringUtil::splitFilename(dest, baseName, path);
+                    dest = opts.outDir + "/" + baseName;
+                }
+                meshSerializer.exportMesh(mesh.get(), dest, opts.endian);
+                MeshManager::getSingleton().remove(mesh);
+            }
+        }
+    }
+    catch (Exception& e)
+    {
+        cout << "Exception caught: " << e.getDescription() << endl;
+        retCode = 1;
+    }
+
+    delete lodGenerator;
+    delete root;
+    delete bufferManager;
+    delete logMgr;
+
+    return retCode;
+}
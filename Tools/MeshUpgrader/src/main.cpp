@@ -37,6 +37,7 @@ THE SOFTWARE.
 #include "OgreHardwareVertexBuffer.h"
 #include "OgrePixelCountLodStrategy.h"
 #include "OgreLodConfig.h"
+#include "OgreMeshOptimiser.h"
 
 #include <iostream>
 #include <sys/stat.h>
@@ -73,8 +74,11 @@ void help(void)
     cout << "-srcgl     = Interpret ambiguous colours as GL style" << endl;
     cout << "-E endian  = Set endian mode 'big' 'little' or 'native' (default)" << endl;
     cout << "-b         = Recalculate bounding box (static meshes only)" << endl;
+    cout << "-vc        = Reorder triangles and vertices for the GPU vertex cache" << endl;
+    cout << "-od        = Like -vc, and sort triangle clusters for less overdraw" << endl;
     cout << "-V version = Specify OGRE version format to write instead of latest" << endl;
-    cout << "             Options are: 1.10, 1.8, 1.7, 1.4, 1.0" << endl;
+    cout << "             Options are: 1.10, 1.8, 1.7, 1.4, 1.0, baked" << endl;
+    cout << "             baked is a little endian fast-load format for shipping" << endl;
     cout << "sourcefile = name of file to convert" << endl;
     cout << "destfile   = optional name of file to write to. If you don't" << endl;
     cout << "             specify this OGRE overwrites the existing file." << endl;
@@ -91,6 +95,8 @@ struct UpgradeOptions {
     bool tangentSplitMirrored;
     bool tangentSplitRotated;
     bool dontReorganise;
+    bool optimiseVertexCache;
+    bool optimiseOverdraw;
     bool destColourFormatSet;
     VertexElementType destColourFormat;
     bool srcColourFormatSet;
@@ -104,6 +110,7 @@ struct UpgradeOptions {
     Serializer::Endian endian;
     bool recalcBounds;
     MeshVersion targetVersion;
+    bool bakedFormat;
 
 };
 
@@ -145,6 +152,7 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
     opts.usePercent = true;
     opts.recalcBounds = false;
     opts.targetVersion = MESH_VERSION_LATEST;
+    opts.bakedFormat = false;
 
     opts.suppressEdgeLists = unOpts["-e"];
     opts.generateTangents = unOpts["-t"];
@@ -153,6 +161,8 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
     opts.lodAutoconfigure = unOpts["-autogen"];
     opts.interactive = unOpts["-i"];
     opts.dontReorganise = unOpts["-r"];
+    opts.optimiseOverdraw = unOpts["-od"];
+    opts.optimiseVertexCache = unOpts["-vc"] || opts.optimiseOverdraw;
 
     if (unOpts["-d3d"]) {
         opts.destColourFormatSet = true;
@@ -238,6 +248,8 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
             opts.targetVersion = MESH_VERSION_1_4;
         } else if (bi->second == "1.0") {
             opts.targetVersion = MESH_VERSION_1_0;
+        } else if (bi->second == "baked") {
+            opts.bakedFormat = true;
         } else {
             logMgr->logError("Unrecognised target mesh version '" + bi->second + "'");
         }
@@ -1022,6 +1034,8 @@ int main(int numargs, char** args)
         unOptList["-srcd3d"] = false;
         unOptList["-autogen"] = false;
         unOptList["-b"] = false;
+        unOptList["-vc"] = false;
+        unOptList["-od"] = false;
         binOptList["-l"] = "";
         binOptList["-d"] = "";
         binOptList["-p"] = "";
@@ -1158,11 +1172,25 @@ int main(int numargs, char** args)
         }
 
 
+        if (opts.optimiseVertexCache) {
+            MeshOptimiser::VertexCacheStatistics before = MeshOptimiser::analyseVertexCache(mesh);
+            cout << "\nOptimising vertex cache order" << (opts.optimiseOverdraw ? " and overdraw" : "")
+                 << "....";
+            MeshOptimiser::optimise(mesh, opts.optimiseOverdraw);
+            MeshOptimiser::VertexCacheStatistics after = MeshOptimiser::analyseVertexCache(mesh);
+            cout << "success" << std::endl;
+            cout << "ACMR " << before.acmr << " -> " << after.acmr << ", ATVR " << before.atvr
+                 << " -> " << after.atvr << std::endl;
+        }
+
         if (opts.recalcBounds) {
             recalcBounds(mesh);
         }
 
-        meshSerializer->exportMesh(mesh, dest, opts.targetVersion, opts.endian);
+        if (opts.bakedFormat)
+            meshSerializer->exportBakedMesh(mesh, dest);
+        else
+            meshSerializer->exportMesh(mesh, dest, opts.targetVersion, opts.endian);
     
     }
     catch (Exception& e)